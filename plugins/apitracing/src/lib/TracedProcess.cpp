@@ -4,6 +4,7 @@
 #include "FunctionHook.h"
 #include "os/Extractor.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace ApiTracing
@@ -55,18 +56,23 @@ namespace ApiTracing
 
     void TracedProcess::initLoadedModules()
     {
-        auto memoryRegions = processInformation->memoryRegionExtractor->extractAllMemoryRegions();
+        processInformation->memoryRegionExtractor->visitMemoryRegions(
+            VmiCore::MemoryRegionFilter{.onlyFileBacked = true},
+            [this](const VmiCore::MemoryRegion& memoryRegionDescriptor)
+            {
+                auto filename = library->splitFilenameFromRegionName(memoryRegionDescriptor.moduleName);
 
-        for (const auto& memoryRegionDescriptor : *memoryRegions)
-        {
-            auto filename = library->splitFilenameFromRegionName(memoryRegionDescriptor.moduleName);
+                if ((library->isTraceableLibrary(memoryRegionDescriptor.moduleName)) &&
+                    (!loadedModules.contains(*filename)))
+                {
+                    loadedModules.emplace(*filename, memoryRegionDescriptor.base);
+                }
 
-            if ((library->isTraceableLibrary(memoryRegionDescriptor.moduleName)) &&
-                (!loadedModules.contains(*filename)))
-            {
-                loadedModules.emplace(*filename, memoryRegionDescriptor.base);
-            }
-        }
+                // Stop walking as soon as every module of the tracing profile has been found
+                return !std::ranges::all_of(tracingProfile.modules,
+                                            [this](const ModuleInformation& module)
+                                            { return loadedModules.contains(module.name); });
+            });
     }
 
     void TracedProcess::injectHooks()
@@ -1,5 +1,6 @@
 #include "Tracer.h"
 #include "Filenames.h"
+#include <algorithm>
 #include <filesystem>
 #include <vmicore/callback.h>
 
@@ -70,17 +71,32 @@ namespace ApiTracing
     Tracer::getProcessTracingProfile(const ActiveProcessInformation& processInformation) const
     {
         auto parentProcess = tracedProcesses.find(processInformation.parentPid);
-        if (parentProcess == tracedProcesses.end())
+        if (parentProcess != tracedProcesses.end())
         {
-            return config->getTracingProfile(*processInformation.fullName);
+            if (!parentProcess->second->traceChildren())
+            {
+                return std::nullopt;
+            }
+
+            // use the same config as the traced parent
+            return parentProcess->second->getTracingProfile();
         }
 
-        if (!parentProcess->second->traceChildren())
+        // An untraced parent only passes on the profile of the closest traced ancestor if that one traces children
+        auto ancestors = pluginInterface->getProcessAncestors(processInformation.pid);
+        auto tracedAncestor = std::find_if(ancestors->cbegin(),
+                                           ancestors->cend(),
+                                           [this](const auto& ancestorInformation)
+                                           { return tracedProcesses.contains(ancestorInformation->pid); });
+        if (tracedAncestor != ancestors->cend())
         {
-            return std::nullopt;
+            const auto& tracedProcess = tracedProcesses.at((*tracedAncestor)->pid);
+            if (tracedProcess->traceChildren())
+            {
+                return tracedProcess->getTracingProfile();
+            }
         }
 
-        // use the same config as the traced parent
-        return parentProcess->second->getTracingProfile();
+        return config->getTracingProfile(*processInformation.fullName);
     }
 }
@@ -55,16 +55,22 @@ namespace ApiTracing
     createProcessInformationWithDefaultMemoryRegions(addr_t dtb, addr_t userDtb, pid_t pid, std::string_view name)
     {
         auto mockMemoryRegionExtractor = std::make_unique<VmiCore::MockMemoryRegionExtractor>();
-        ON_CALL(*mockMemoryRegionExtractor, extractAllMemoryRegions())
+        ON_CALL(*mockMemoryRegionExtractor, visitMemoryRegions(_, _))
             .WillByDefault(
-                []()
+                [](const VmiCore::MemoryRegionFilter& filter, const VmiCore::MemoryRegionVisitor& visitor)
                 {
-                    auto memoryRegions = std::make_unique<std::vector<MemoryRegion>>();
-                    memoryRegions->push_back(
+                    std::vector<MemoryRegion> memoryRegions;
+                    memoryRegions.push_back(
                         createMemoryRegionDescriptor(kernelDllBase, defaultDllSize, kernelDllName));
-                    memoryRegions->push_back(createMemoryRegionDescriptor(ntdllBase, defaultDllSize, ntdllDllName));
-                    memoryRegions->push_back(createMemoryRegionDescriptor(NonDllBase, defaultDllSize, nonDllName));
-                    return memoryRegions;
+                    memoryRegions.push_back(createMemoryRegionDescriptor(ntdllBase, defaultDllSize, ntdllDllName));
+                    memoryRegions.push_back(createMemoryRegionDescriptor(NonDllBase, defaultDllSize, nonDllName));
+                    for (const auto& memoryRegion : memoryRegions)
+                    {
+                        if (filter.matches(memoryRegion) && !visitor(memoryRegion))
+                        {
+                            return;
+                        }
+                    }
                 });
 
         return std::make_shared<const ActiveProcessInformation>(0,
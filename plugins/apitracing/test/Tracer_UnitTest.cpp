@@ -47,6 +47,9 @@ namespace ApiTracing
         {
             ON_CALL(*mockPluginInterface, newNamedLogger(_))
                 .WillByDefault([]() { return std::make_unique<NiceMock<VmiCore::MockLogger>>(); });
+            ON_CALL(*mockPluginInterface, getProcessAncestors(_))
+                .WillByDefault(
+                    []() { return std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>(); });
 
             std::unique_ptr<MockConfig> mockConfig = std::make_unique<MockConfig>();
             setupMockConfig(*mockConfig);
@@ -163,6 +166,85 @@ namespace ApiTracing
         ASSERT_NO_THROW(tracer->traceProcess(tracedProcessWithConflictingParentConfig));
     }
 
+    TEST_F(TracerTestFixture, traceProcess_grandchildOfTracedProcess_createTracedProcessWithAncestorTracingProfile)
+    {
+        constexpr pid_t untracedChildPid = 43;
+        auto tracedProcessInformation = createActiveProcessInformation(targetProcessName, tracedProcessPid, 0);
+        auto untracedChildInformation =
+            createActiveProcessInformation(untracedProcessName, untracedChildPid, tracedProcessPid);
+        auto grandchildInformation =
+            createActiveProcessInformation(untracedProcessName, tracedChildPid, untracedChildPid);
+        setupTracedProcessFactory(tracedProcessInformation);
+        ASSERT_NO_THROW(tracer->traceProcess(tracedProcessInformation));
+        ON_CALL(*mockPluginInterface, getProcessAncestors(tracedChildPid))
+            .WillByDefault(
+                [&]()
+                {
+                    return std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>(
+                        std::vector<std::shared_ptr<const ActiveProcessInformation>>{untracedChildInformation,
+                                                                                     tracedProcessInformation});
+                });
+
+        EXPECT_CALL(*mockTracedProcessFactory,
+                    createTracedProcess(grandchildInformation, tracingProfiles.at(*tracedProcessInformation->fullName)))
+            .Times(1);
+
+        ASSERT_NO_THROW(tracer->traceProcess(grandchildInformation));
+    }
+
+    TEST_F(TracerTestFixture,
+           traceProcess_grandchildWithTracingProfileOfAncestorWithoutTraceChildren_createTracedProcessWithOwnProfile)
+    {
+        constexpr pid_t untracedChildPid = 43;
+        auto dontTraceChildrenProcessInformation =
+            createActiveProcessInformation(dontTraceChildrenProcessName, tracedProcessPid, 0);
+        auto untracedChildInformation =
+            createActiveProcessInformation(untracedProcessName, untracedChildPid, tracedProcessPid);
+        auto grandchildInformation =
+            createActiveProcessInformation(targetProcessName, tracedChildPid, untracedChildPid);
+        setupTracedProcessFactory(dontTraceChildrenProcessInformation);
+        ASSERT_NO_THROW(tracer->traceProcess(dontTraceChildrenProcessInformation));
+        ON_CALL(*mockPluginInterface, getProcessAncestors(tracedChildPid))
+            .WillByDefault(
+                [&]()
+                {
+                    return std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>(
+                        std::vector<std::shared_ptr<const ActiveProcessInformation>>{
+                            untracedChildInformation, dontTraceChildrenProcessInformation});
+                });
+
+        EXPECT_CALL(*mockTracedProcessFactory,
+                    createTracedProcess(grandchildInformation, tracingProfiles.at(std::string(targetProcessName))))
+            .Times(1);
+
+        ASSERT_NO_THROW(tracer->traceProcess(grandchildInformation));
+    }
+
+    TEST_F(TracerTestFixture, traceProcess_untracedGrandchildOfAncestorWithoutTraceChildren_noTracedProcessCreated)
+    {
+        constexpr pid_t untracedChildPid = 43;
+        auto dontTraceChildrenProcessInformation =
+            createActiveProcessInformation(dontTraceChildrenProcessName, tracedProcessPid, 0);
+        auto untracedChildInformation =
+            createActiveProcessInformation(untracedProcessName, untracedChildPid, tracedProcessPid);
+        auto grandchildInformation =
+            createActiveProcessInformation(untracedProcessName, tracedChildPid, untracedChildPid);
+        setupTracedProcessFactory(dontTraceChildrenProcessInformation);
+        ASSERT_NO_THROW(tracer->traceProcess(dontTraceChildrenProcessInformation));
+        ON_CALL(*mockPluginInterface, getProcessAncestors(tracedChildPid))
+            .WillByDefault(
+                [&]()
+                {
+                    return std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>(
+                        std::vector<std::shared_ptr<const ActiveProcessInformation>>{
+                            untracedChildInformation, dontTraceChildrenProcessInformation});
+                });
+
+        EXPECT_CALL(*mockTracedProcessFactory, createTracedProcess(_, _)).Times(0);
+
+        ASSERT_NO_THROW(tracer->traceProcess(grandchildInformation));
+    }
+
     TEST_F(TracerTestFixture, traceProcess_processWithoutTraceChildren_onlyParentTraced)
     {
         auto dontTraceChildrenProcessInformation =
@@ -0,0 +1,102 @@
+#include "AsyncScanQueue.h"
+#include "Common.h"
+
+using VmiCore::ITaskHandle;
+using VmiCore::Plugin::PluginInterface;
+
+namespace InMemoryScanner
+{
+    AsyncScanQueue::AsyncScanQueue(PluginInterface* pluginInterface,
+                                   std::size_t maxPendingTasks,
+                                   std::size_t maxPendingBytes)
+        : pluginInterface(pluginInterface),
+          logger(pluginInterface->newNamedLogger(INMEMORY_LOGGER_NAME)),
+          maxPendingTasks(maxPendingTasks),
+          maxPendingBytes(maxPendingBytes)
+    {
+    }
+
+    AsyncScanQueue::~AsyncScanQueue()
+    {
+        drain();
+    }
+
+    bool AsyncScanQueue::isFull() const
+    {
+        std::scoped_lock guard(queueLock);
+        return pendingTasks >= maxPendingTasks;
+    }
+
+    bool AsyncScanQueue::tryReserveBytes(std::size_t bytes)
+    {
+        std::scoped_lock guard(queueLock);
+        if (bytes > maxPendingBytes - reservedBytes)
+        {
+            return false;
+        }
+        reservedBytes += bytes;
+        return true;
+    }
+
+    void AsyncScanQueue::releaseBytes(std::size_t bytes)
+    {
+        std::scoped_lock guard(queueLock);
+        reservedBytes -= bytes;
+    }
+
+    void AsyncScanQueue::enqueue(std::size_t bytes, std::function<void()> task)
+    {
+        {
+            std::scoped_lock guard(queueLock);
+            pendingTasks++;
+        }
+        auto taskHandle = pluginInterface->submitTask(
+            [this, bytes, task = std::move(task)](const std::stop_token&) mutable
+            {
+                try
+                {
+                    task();
+                }
+                catch (const std::exception& exc)
+                {
+                    // The task is still finished, as its pending slot and bytes would never be released otherwise
+                    logger->error("Asynchronous scan task failed", {{"Exception", exc.what()}});
+                }
+                // Destroy the task and with it the captured data before its memory is handed out again
+                task = nullptr;
+                finishTask(bytes);
+            });
+
+        std::scoped_lock guard(queueLock);
+        std::erase_if(taskHandles, [](const std::shared_ptr<ITaskHandle>& handle) { return handle->isDone(); });
+        taskHandles.push_back(std::move(taskHandle));
+    }
+
+    void AsyncScanQueue::drain()
+    {
+        // Tasks may still be enqueued while draining, e.g. by termination events
+        while (true)
+        {
+            std::vector<std::shared_ptr<ITaskHandle>> currentTaskHandles;
+            {
+                std::scoped_lock guard(queueLock);
+                currentTaskHandles.swap(taskHandles);
+            }
+            if (currentTaskHandles.empty())
+            {
+                return;
+            }
+            for (const auto& taskHandle : currentTaskHandles)
+            {
+                taskHandle->wait();
+            }
+        }
+    }
+
+    void AsyncScanQueue::finishTask(std::size_t bytes)
+    {
+        std::scoped_lock guard(queueLock);
+        reservedBytes -= bytes;
+        pendingTasks--;
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef INMEMORYSCANNER_ASYNCSCANQUEUE_H
+#define INMEMORYSCANNER_ASYNCSCANQUEUE_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vmicore/plugins/PluginInterface.h>
+#include <vmicore/threading/ITaskHandle.h>
+
+namespace InMemoryScanner
+{
+    /**
+     * Runs scans of captured process memory on the worker pool of VMICore. Both the number of pending scans and the
+     * amount of memory held by their captured data are bounded, so that callers can fall back to scanning
+     * synchronously instead of piling up work when lots of processes terminate at once.
+     */
+    class AsyncScanQueue
+    {
+      public:
+        AsyncScanQueue(VmiCore::Plugin::PluginInterface* pluginInterface,
+                       std::size_t maxPendingTasks,
+                       std::size_t maxPendingBytes);
+
+        AsyncScanQueue(const AsyncScanQueue&) = delete;
+
+        AsyncScanQueue& operator=(const AsyncScanQueue&) = delete;
+
+        /// Finishes all pending tasks before returning.
+        ~AsyncScanQueue();
+
+        [[nodiscard]] bool isFull() const;
+
+        /// Reserves memory for captured data. Fails instead of blocking if the memory limit would be exceeded.
+        [[nodiscard]] bool tryReserveBytes(std::size_t bytes);
+
+        void releaseBytes(std::size_t bytes);
+
+        /// Takes over the given amount of previously reserved bytes, which are released once the task has finished.
+        /// Tasks are expected to handle their errors themselves. Exceptions escaping a task are logged.
+        void enqueue(std::size_t bytes, std::function<void()> task);
+
+        /// Blocks until all pending tasks have finished.
+        void drain();
+
+      private:
+        VmiCore::Plugin::PluginInterface* pluginInterface;
+        std::unique_ptr<VmiCore::ILogger> logger;
+        std::size_t maxPendingTasks;
+        std::size_t maxPendingBytes;
+        std::size_t pendingTasks = 0;
+        std::size_t reservedBytes = 0;
+        std::vector<std::shared_ptr<VmiCore::ITaskHandle>> taskHandles;
+        mutable std::mutex queueLock;
+
+        void finishTask(std::size_t bytes);
+    };
+}
+
+#endif // INMEMORYSCANNER_ASYNCSCANQUEUE_H
@@ -2,7 +2,9 @@
 #include "Common.h"
 #include "Filenames.h"
 #include <algorithm>
+#include <fmt/core.h>
 
+using VmiCore::PagingDefinitions::pageSizeInBytes;
 using VmiCore::Plugin::IPluginConfig;
 using VmiCore::Plugin::PluginInterface;
 
@@ -18,10 +20,30 @@ namespace InMemoryScanner
     {
         auto& rootNode = config.rootNode();
         signatureFile = rootNode["signature_file"].as<std::string>();
+        rulesCacheDirectory = rootNode["rules_cache_directory"].as<std::string>("");
         outputPath = rootNode["output_path"].as<std::string>();
         dumpMemory = rootNode["dump_memory"].as<bool>(false);
         scanAllRegions = rootNode["scan_all_regions"].as<bool>(false);
         scanTimeout = rootNode["scan_timeout"].as<int>(10);
+        asyncTerminationScan = rootNode["async_termination_scan"].as<bool>(false);
+        // Configured in MiB
+        asyncScanMemoryLimit = rootNode["async_scan_memory_limit"].as<std::size_t>(512) << 20;
+        asyncScanQueueSize = rootNode["async_scan_queue_size"].as<std::size_t>(16);
+        // Configured in MiB
+        inFlightMemoryLimit = rootNode["in_flight_memory_limit"].as<std::size_t>(256) << 20;
+        scanCacheSize = rootNode["scan_cache_size"].as<std::size_t>(16384);
+        ruleProfiling = rootNode["profile_rules"].as<bool>(false);
+        // Configured in MiB
+        scanWindowSize = rootNode["scan_window_size"].as<std::size_t>(0) << 20;
+        // Configured in KiB, but windows are mapped page-wise
+        scanWindowOverlap =
+            bytesToNumberOfPages(rootNode["scan_window_overlap"].as<std::size_t>(64) << 10) * pageSizeInBytes;
+        if (scanWindowSize > 0 && scanWindowOverlap >= scanWindowSize)
+        {
+            throw ConfigException("Scan window overlap has to be smaller than the scan window size");
+        }
+        detectionDumpScope = parseDetectionDumpScope(rootNode["dump_detections"].as<std::string>("none"));
+        dumpCompressionLevel = rootNode["dump_compression_level"].as<int>(0);
 
         auto ignoredProcessesVec =
             rootNode["ignored_processes"].as<std::vector<std::string>>(std::vector<std::string>());
@@ -34,11 +56,37 @@ namespace InMemoryScanner
         }
     }
 
+    DetectionDumpScope Config::parseDetectionDumpScope(const std::string& scope)
+    {
+        if (scope == "none")
+        {
+            return DetectionDumpScope::None;
+        }
+        if (scope == "region")
+        {
+            return DetectionDumpScope::Region;
+        }
+        if (scope == "neighbours")
+        {
+            return DetectionDumpScope::NeighbouringRegions;
+        }
+        if (scope == "process")
+        {
+            return DetectionDumpScope::Process;
+        }
+        throw ConfigException(fmt::format("Unknown detection dump scope \"{}\"", scope));
+    }
+
     std::filesystem::path Config::getSignatureFile() const
     {
         return signatureFile;
     }
 
+    std::filesystem::path Config::getRulesCacheDirectory() const
+    {
+        return rulesCacheDirectory;
+    }
+
     std::filesystem::path Config::getOutputPath() const
     {
         return outputPath;
@@ -64,6 +112,56 @@ namespace InMemoryScanner
         return dumpMemory;
     }
 
+    bool Config::isAsyncTerminationScanActivated() const
+    {
+        return asyncTerminationScan;
+    }
+
+    std::size_t Config::getAsyncScanMemoryLimit() const
+    {
+        return asyncScanMemoryLimit;
+    }
+
+    std::size_t Config::getAsyncScanQueueSize() const
+    {
+        return asyncScanQueueSize;
+    }
+
+    std::size_t Config::getInFlightMemoryLimit() const
+    {
+        return inFlightMemoryLimit;
+    }
+
+    std::size_t Config::getScanCacheSize() const
+    {
+        return scanCacheSize;
+    }
+
+    bool Config::isRuleProfilingActivated() const
+    {
+        return ruleProfiling;
+    }
+
+    std::size_t Config::getScanWindowSize() const
+    {
+        return scanWindowSize;
+    }
+
+    std::size_t Config::getScanWindowOverlap() const
+    {
+        return scanWindowOverlap;
+    }
+
+    DetectionDumpScope Config::getDetectionDumpScope() const
+    {
+        return detectionDumpScope;
+    }
+
+    int Config::getDumpCompressionLevel() const
+    {
+        return dumpCompressionLevel;
+    }
+
     void Config::overrideDumpMemoryFlag(bool value)
     {
         dumpMemory = value;
@@ -15,6 +15,18 @@ namespace InMemoryScanner
         explicit ConfigException(const std::string& Message) : std::runtime_error(Message.c_str()){};
     };
 
+    /// Memory regions that are dumped once a region of a process has matches, if memory dumping is deactivated.
+    enum class DetectionDumpScope
+    {
+        None,
+        /// Only the regions with matches.
+        Region,
+        /// The regions with matches and the regions directly before and after them.
+        NeighbouringRegions,
+        /// All scanned regions of the process.
+        Process
+    };
+
     class IConfig
     {
       public:
@@ -24,6 +36,10 @@ namespace InMemoryScanner
 
         [[nodiscard]] virtual std::filesystem::path getSignatureFile() const = 0;
 
+        /// Directory in which rules that have been compiled from sources are kept for later runs. Empty if not
+        /// configured, in which case the rules are cached in the output directory.
+        [[nodiscard]] virtual std::filesystem::path getRulesCacheDirectory() const = 0;
+
         [[nodiscard]] virtual std::filesystem::path getOutputPath() const = 0;
 
         [[nodiscard]] virtual int getScanTimeout() const = 0;
@@ -34,6 +50,31 @@ namespace InMemoryScanner
 
         [[nodiscard]] virtual bool isDumpingMemoryActivated() const = 0;
 
+        [[nodiscard]] virtual bool isAsyncTerminationScanActivated() const = 0;
+
+        [[nodiscard]] virtual std::size_t getAsyncScanMemoryLimit() const = 0;
+
+        [[nodiscard]] virtual std::size_t getAsyncScanQueueSize() const = 0;
+
+        /// Upper bound for the size of all regions that are mapped or captured for pending scans at the same time.
+        [[nodiscard]] virtual std::size_t getInFlightMemoryLimit() const = 0;
+
+        /// Maximum number of remembered region scans for deduplication. Zero disables deduplication.
+        [[nodiscard]] virtual std::size_t getScanCacheSize() const = 0;
+
+        [[nodiscard]] virtual bool isRuleProfilingActivated() const = 0;
+
+        /// Regions larger than this are mapped and scanned in windows of this size. Zero disables windowed scanning.
+        [[nodiscard]] virtual std::size_t getScanWindowSize() const = 0;
+
+        /// Number of bytes consecutive windows share, so that matches crossing a window boundary are still found.
+        [[nodiscard]] virtual std::size_t getScanWindowOverlap() const = 0;
+
+        [[nodiscard]] virtual DetectionDumpScope getDetectionDumpScope() const = 0;
+
+        /// Zstd compression level of dumped regions. Zero disables compression.
+        [[nodiscard]] virtual int getDumpCompressionLevel() const = 0;
+
         virtual void overrideDumpMemoryFlag(bool value) = 0;
 
       protected:
@@ -51,6 +92,8 @@ namespace InMemoryScanner
 
         [[nodiscard]] std::filesystem::path getSignatureFile() const override;
 
+        [[nodiscard]] std::filesystem::path getRulesCacheDirectory() const override;
+
         [[nodiscard]] std::filesystem::path getOutputPath() const override;
 
         [[nodiscard]] int getScanTimeout() const override;
@@ -61,15 +104,48 @@ namespace InMemoryScanner
 
         [[nodiscard]] bool isDumpingMemoryActivated() const override;
 
+        [[nodiscard]] bool isAsyncTerminationScanActivated() const override;
+
+        [[nodiscard]] std::size_t getAsyncScanMemoryLimit() const override;
+
+        [[nodiscard]] std::size_t getAsyncScanQueueSize() const override;
+
+        [[nodiscard]] std::size_t getInFlightMemoryLimit() const override;
+
+        [[nodiscard]] std::size_t getScanCacheSize() const override;
+
+        [[nodiscard]] bool isRuleProfilingActivated() const override;
+
+        [[nodiscard]] std::size_t getScanWindowSize() const override;
+
+        [[nodiscard]] std::size_t getScanWindowOverlap() const override;
+
+        [[nodiscard]] DetectionDumpScope getDetectionDumpScope() const override;
+
+        [[nodiscard]] int getDumpCompressionLevel() const override;
+
         void overrideDumpMemoryFlag(bool value) override;
 
       private:
         std::unique_ptr<VmiCore::ILogger> logger;
         std::filesystem::path outputPath;
         std::filesystem::path signatureFile;
+        std::filesystem::path rulesCacheDirectory;
         std::set<std::string> ignoredProcesses;
         bool dumpMemory{};
         bool scanAllRegions{};
         int scanTimeout;
+        bool asyncTerminationScan{};
+        std::size_t asyncScanMemoryLimit{};
+        std::size_t asyncScanQueueSize{};
+        std::size_t inFlightMemoryLimit{};
+        std::size_t scanCacheSize{};
+        bool ruleProfiling{};
+        std::size_t scanWindowSize{};
+        std::size_t scanWindowOverlap{};
+        DetectionDumpScope detectionDumpScope{};
+        int dumpCompressionLevel{};
+
+        [[nodiscard]] static DetectionDumpScope parseDetectionDumpScope(const std::string& scope);
     };
 }
@@ -0,0 +1,411 @@
+#include "DumpArchive.h"
+#include "Filenames.h"
+#include "Json.h"
+#include <algorithm>
+#include <fmt/core.h>
+#include <fstream>
+#include <random>
+#include <yaml-cpp/yaml.h>
+#ifdef INMEMORYSCANNER_ZSTD_SUPPORT
+#include <zstd.h>
+#endif
+
+using VmiCore::FileChunk;
+using VmiCore::Plugin::PluginInterface;
+
+namespace InMemoryScanner
+{
+    namespace
+    {
+        constexpr std::array<uint32_t, 256> createChecksumTable()
+        {
+            // Reflected CRC-32 polynomial as used by zlib
+            std::array<uint32_t, 256> table{};
+            for (uint32_t i = 0; i < table.size(); i++)
+            {
+                uint32_t value = i;
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    value = (value & 1) ? (value >> 1) ^ 0xEDB88320 : value >> 1;
+                }
+                table[i] = value;
+            }
+            return table;
+        }
+
+        constexpr auto checksumTable = createChecksumTable();
+
+        std::array<uint8_t, DumpArchive::recordHeaderSize> createRecordHeader(const ArchiveRecord& record)
+        {
+            std::array<uint8_t, DumpArchive::recordHeaderSize> header{};
+            auto headerCursor = std::ranges::copy(DumpArchive::recordMagic, header.begin()).out;
+            for (auto value : {record.runId, record.uid, record.storedSize})
+            {
+                for (std::size_t i = 0; i < sizeof(value); i++)
+                {
+                    *headerCursor++ = static_cast<uint8_t>(value >> (8 * i));
+                }
+            }
+            return header;
+        }
+
+        uint64_t createRunId()
+        {
+            std::random_device randomDevice;
+            return (static_cast<uint64_t>(randomDevice()) << 32) | randomDevice();
+        }
+
+        std::string toString(DumpCompression compression)
+        {
+            return compression == DumpCompression::Zstd ? "zstd" : "none";
+        }
+
+#ifdef INMEMORYSCANNER_ZSTD_SUPPORT
+        std::size_t checkZstdResult(std::size_t result)
+        {
+            if (ZSTD_isError(result))
+            {
+                throw DumpArchiveException(fmt::format("zstd error: {}", ZSTD_getErrorName(result)));
+            }
+            return result;
+        }
+#endif
+    }
+
+    DumpArchive::DumpArchive(const PluginInterface* pluginInterface,
+                             std::filesystem::path outputDirectory,
+                             int compressionLevel,
+                             std::shared_ptr<MemoryBudget> memoryBudget)
+        : pluginInterface(pluginInterface),
+          outputDirectory(std::move(outputDirectory)),
+          indexFile((this->outputDirectory / DUMP_INDEX_FILENAME).string()),
+          compressionLevel(compressionLevel),
+          memoryBudget(std::move(memoryBudget)),
+          runId(createRunId())
+    {
+        if (compressionLevel != 0 && !isCompressionSupported())
+        {
+            throw DumpArchiveException("Dump compression requires the plugin to be built with zstd support");
+        }
+        startArchiveFile();
+    }
+
+    void DumpArchive::startArchiveFile()
+    {
+        archiveFileName = fmt::format(
+            "{}-{:016x}-{}{}", DUMP_ARCHIVE_FILENAME_STEM, runId, archiveFileCount++, DUMP_ARCHIVE_EXTENSION);
+        archiveSize = 0;
+    }
+
+    ArchiveRecord DumpArchive::appendRecord(uint64_t uid, std::span<const FileChunk> chunks)
+    {
+        ArchiveRecord record;
+        record.runId = runId;
+        record.uid = uid;
+        std::size_t payloadSize = 0;
+        for (const auto& chunk : chunks)
+        {
+            if (!chunk.data.empty())
+            {
+                record.extents.push_back({.offset = record.dumpSize, .size = chunk.data.size()});
+                record.checksum = updateChecksum(record.checksum, chunk.data);
+                payloadSize += chunk.data.size();
+            }
+            record.dumpSize += chunk.data.size() + chunk.holeSize;
+        }
+
+        std::unique_ptr<MemoryBudget::Reservation> compressionReservation;
+        std::vector<uint8_t> compressedPayload;
+        if (compressionLevel != 0 && payloadSize > 0)
+        {
+            // The compression buffer never exceeds the payload size, as only a smaller result is kept
+            compressionReservation = memoryBudget->tryAcquire(payloadSize, AdmissionPriority::Normal);
+            if (compressionReservation)
+            {
+                compressedPayload = compress(chunks, payloadSize);
+            }
+        }
+        // Incompressible content, as well as content whose compression buffer exceeds the budget, is stored as is
+        record.compression = compressedPayload.empty() ? DumpCompression::None : DumpCompression::Zstd;
+        record.storedSize = compressedPayload.empty() ? payloadSize : compressedPayload.size();
+        auto header = createRecordHeader(record);
+        std::vector<FileChunk> recordChunks{{.data = header, .holeSize = 0}};
+        if (record.compression == DumpCompression::Zstd)
+        {
+            recordChunks.push_back({.data = compressedPayload, .holeSize = 0});
+        }
+        else
+        {
+            for (const auto& chunk : chunks)
+            {
+                if (!chunk.data.empty())
+                {
+                    recordChunks.push_back({.data = chunk.data, .holeSize = 0});
+                }
+            }
+        }
+
+        std::scoped_lock guard(appendLock);
+        record.archiveFileName = archiveFileName;
+        record.offset = archiveSize;
+        if (!pluginInterface->writeToFile((outputDirectory / archiveFileName).string(), recordChunks))
+        {
+            startArchiveFile();
+            throw DumpArchiveException(fmt::format("Unable to write record {} to {}", uid, record.archiveFileName));
+        }
+        archiveSize += recordHeaderSize + record.storedSize;
+
+        return record;
+    }
+
+    void DumpArchive::appendIndexEntry(const std::string& indexEntry)
+    {
+        pluginInterface->writeToFile(indexFile, indexEntry + "\n");
+    }
+
+    std::string DumpArchive::toJsonMembers(const ArchiveRecord& record)
+    {
+        std::string extents;
+        for (const auto& extent : record.extents)
+        {
+            extents.append(extents.empty() ? "" : ", ").append(fmt::format("[{}, {}]", extent.offset, extent.size));
+        }
+        return fmt::format(R"("RunId": "{:016x}", "Archive": "{}", "Offset": {}, "StoredSize": {}, "DumpSize": {}, )"
+                           R"("Compression": "{}", "Checksum": "{:08x}", "Extents": [{}])",
+                           record.runId,
+                           escapeJson(record.archiveFileName),
+                           record.offset,
+                           record.storedSize,
+                           record.dumpSize,
+                           toString(record.compression),
+                           record.checksum,
+                           extents);
+    }
+
+    uint32_t DumpArchive::updateChecksum(uint32_t checksum, std::span<const uint8_t> data)
+    {
+        checksum = ~checksum;
+        for (auto byte : data)
+        {
+            checksum = checksumTable[(checksum ^ byte) & 0xFF] ^ (checksum >> 8);
+        }
+        return ~checksum;
+    }
+
+    bool DumpArchive::isCompressionSupported()
+    {
+#ifdef INMEMORYSCANNER_ZSTD_SUPPORT
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::vector<uint8_t> DumpArchive::compress([[maybe_unused]] std::span<const FileChunk> chunks,
+                                               [[maybe_unused]] std::size_t payloadSize) const
+    {
+#ifdef INMEMORYSCANNER_ZSTD_SUPPORT
+        // Chunks are compressed as a single frame without assembling the payload first
+        std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(ZSTD_createCCtx(), &ZSTD_freeCCtx);
+        if (!context)
+        {
+            throw std::bad_alloc();
+        }
+        checkZstdResult(ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, compressionLevel));
+        checkZstdResult(ZSTD_CCtx_setPledgedSrcSize(context.get(), payloadSize));
+
+        // A full output buffer means that the compressed payload would not be smaller than the payload
+        std::vector<uint8_t> compressedPayload(payloadSize - 1);
+        ZSTD_outBuffer output{.dst = compressedPayload.data(), .size = compressedPayload.size(), .pos = 0};
+        for (const auto& chunk : chunks)
+        {
+            ZSTD_inBuffer input{.src = chunk.data.data(), .size = chunk.data.size(), .pos = 0};
+            while (input.pos < input.size)
+            {
+                checkZstdResult(ZSTD_compressStream2(context.get(), &output, &input, ZSTD_e_continue));
+                if (output.pos == output.size)
+                {
+                    return {};
+                }
+            }
+        }
+        ZSTD_inBuffer endOfInput{.src = nullptr, .size = 0, .pos = 0};
+        while (checkZstdResult(ZSTD_compressStream2(context.get(), &output, &endOfInput, ZSTD_e_end)) > 0)
+        {
+            if (output.pos == output.size)
+            {
+                return {};
+            }
+        }
+        compressedPayload.resize(output.pos);
+
+        return compressedPayload;
+#else
+        throw DumpArchiveException("Dump compression requires the plugin to be built with zstd support");
+#endif
+    }
+
+    DumpArchiveReader::DumpArchiveReader(std::istream& archive) : archive(archive)
+    {
+        archive.seekg(0, std::ios::end);
+        archiveSize = archive ? static_cast<uint64_t>(archive.tellg()) : 0;
+    }
+
+    std::vector<ArchiveIndexEntry> DumpArchiveReader::readIndex(std::istream& index, std::size_t& skippedLines)
+    {
+        std::vector<ArchiveIndexEntry> entries;
+        skippedLines = 0;
+        std::string line;
+        while (std::getline(index, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+            // JSON is valid YAML in flow style, so no separate JSON parser is needed
+            try
+            {
+                auto node = YAML::Load(line);
+                ArchiveIndexEntry entry{.dumpFileName = node["DumpFileName"].as<std::string>(),
+                                        .record = {.runId = std::stoull(node["RunId"].as<std::string>(), nullptr, 16),
+                                                   .uid = node["Uid"].as<uint64_t>(),
+                                                   .archiveFileName = node["Archive"].as<std::string>(),
+                                                   .offset = node["Offset"].as<uint64_t>(),
+                                                   .storedSize = node["StoredSize"].as<uint64_t>(),
+                                                   .dumpSize = node["DumpSize"].as<uint64_t>(),
+                                                   .compression = DumpCompression::None,
+                                                   .checksum = static_cast<uint32_t>(
+                                                       std::stoul(node["Checksum"].as<std::string>(), nullptr, 16)),
+                                                   .extents = {}}};
+                auto compression = node["Compression"].as<std::string>();
+                if (compression == "zstd")
+                {
+                    entry.record.compression = DumpCompression::Zstd;
+                }
+                else if (compression != "none")
+                {
+                    skippedLines++;
+                    continue;
+                }
+                for (const auto& extent : node["Extents"])
+                {
+                    entry.record.extents.push_back(
+                        {.offset = extent[0].as<uint64_t>(), .size = extent[1].as<uint64_t>()});
+                }
+                entries.push_back(std::move(entry));
+            }
+            catch (const std::exception&)
+            {
+                skippedLines++;
+            }
+        }
+        return entries;
+    }
+
+    std::vector<uint8_t> DumpArchiveReader::readPayload(const ArchiveRecord& record)
+    {
+        // The index may be damaged as well, so sizes are checked before anything is allocated for them
+        if (record.offset > archiveSize || archiveSize - record.offset < DumpArchive::recordHeaderSize ||
+            archiveSize - record.offset - DumpArchive::recordHeaderSize < record.storedSize)
+        {
+            throw DumpArchiveException(fmt::format("Record {} exceeds the archive", record.uid));
+        }
+        if (!hasHeaderAt(record.offset, createRecordHeader(record)))
+        {
+            throw DumpArchiveException(fmt::format("Record {} is not found at its offset", record.uid));
+        }
+
+        std::size_t payloadSize = 0;
+        for (const auto& extent : record.extents)
+        {
+            if (extent.offset + extent.size > record.dumpSize)
+            {
+                throw DumpArchiveException(fmt::format("Record {} has an extent beyond its dump size", record.uid));
+            }
+            payloadSize += extent.size;
+        }
+        if (record.compression == DumpCompression::None && record.storedSize != payloadSize)
+        {
+            throw DumpArchiveException(fmt::format("Record {} has an unexpected size", record.uid));
+        }
+
+        std::vector<uint8_t> storedPayload(record.storedSize);
+        archive.clear();
+        archive.seekg(static_cast<std::streamoff>(record.offset + DumpArchive::recordHeaderSize));
+        archive.read(reinterpret_cast<char*>(storedPayload.data()), static_cast<std::streamsize>(storedPayload.size()));
+        if (!archive)
+        {
+            throw DumpArchiveException(fmt::format("Record {} could not be read", record.uid));
+        }
+
+        std::vector<uint8_t> payload;
+        if (record.compression == DumpCompression::Zstd)
+        {
+#ifdef INMEMORYSCANNER_ZSTD_SUPPORT
+            if (ZSTD_getFrameContentSize(storedPayload.data(), storedPayload.size()) != payloadSize)
+            {
+                throw DumpArchiveException(fmt::format("Record {} has an unexpected size", record.uid));
+            }
+            payload.resize(payloadSize);
+            auto decompressedSize = checkZstdResult(
+                ZSTD_decompress(payload.data(), payload.size(), storedPayload.data(), storedPayload.size()));
+            if (decompressedSize != payloadSize)
+            {
+                throw DumpArchiveException(fmt::format("Record {} has an unexpected size", record.uid));
+            }
+#else
+            throw DumpArchiveException("Compressed records require the tool to be built with zstd support");
+#endif
+        }
+        else
+        {
+            payload = std::move(storedPayload);
+        }
+
+        if (DumpArchive::updateChecksum(0, payload) != record.checksum)
+        {
+            throw DumpArchiveException(fmt::format("Record {} has an invalid checksum", record.uid));
+        }
+        return payload;
+    }
+
+    bool DumpArchiveReader::hasHeaderAt(uint64_t offset, std::span<const uint8_t> header)
+    {
+        std::array<uint8_t, DumpArchive::recordHeaderSize> storedHeader{};
+        archive.clear();
+        archive.seekg(static_cast<std::streamoff>(offset));
+        archive.read(reinterpret_cast<char*>(storedHeader.data()), static_cast<std::streamsize>(storedHeader.size()));
+        return archive && std::ranges::equal(storedHeader, header);
+    }
+
+    std::vector<uint8_t> DumpArchiveReader::readDump(const ArchiveRecord& record)
+    {
+        auto payload = readPayload(record);
+        std::vector<uint8_t> dump(record.dumpSize, 0);
+        auto payloadCursor = payload.begin();
+        for (const auto& extent : record.extents)
+        {
+            std::copy_n(payloadCursor, extent.size, dump.begin() + static_cast<std::ptrdiff_t>(extent.offset));
+            payloadCursor += static_cast<std::ptrdiff_t>(extent.size);
+        }
+        return dump;
+    }
+
+    void DumpArchiveReader::extract(const ArchiveRecord& record, const std::filesystem::path& dumpFile)
+    {
+        auto payload = readPayload(record);
+        std::ofstream dumpStream;
+        dumpStream.exceptions(std::ios::failbit | std::ios::badbit);
+        dumpStream.open(dumpFile, std::ios::binary | std::ios::trunc);
+        auto* payloadCursor = payload.data();
+        for (const auto& extent : record.extents)
+        {
+            // Seeking past the end leaves holes for the zero parts
+            dumpStream.seekp(static_cast<std::streamoff>(extent.offset));
+            dumpStream.write(reinterpret_cast<const char*>(payloadCursor), static_cast<std::streamsize>(extent.size));
+            payloadCursor += extent.size;
+        }
+        dumpStream.close();
+        std::filesystem::resize_file(dumpFile, record.dumpSize);
+    }
+}
@@ -0,0 +1,152 @@
+#ifndef INMEMORYSCANNER_DUMPARCHIVE_H
+#define INMEMORYSCANNER_DUMPARCHIVE_H
+
+#include "MemoryBudget.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <vmicore/plugins/PluginInterface.h>
+
+namespace InMemoryScanner
+{
+    class DumpArchiveException : public std::runtime_error
+    {
+      public:
+        explicit DumpArchiveException(const std::string& message) : std::runtime_error(message) {}
+    };
+
+    enum class DumpCompression
+    {
+        None,
+        Zstd
+    };
+
+    /// Non-zero part of a dump file. All other parts of the dump file are zero.
+    struct DumpExtent
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    /// Location and layout of a single dumped region within the archive.
+    struct ArchiveRecord
+    {
+        /// Random identifier of the run that wrote the record, which distinguishes it from records of earlier runs.
+        uint64_t runId = 0;
+        uint64_t uid = 0;
+        /// Name of the archive file containing the record, relative to the directory of the index.
+        std::string archiveFileName;
+        /// Start of the record header within the archive file.
+        uint64_t offset = 0;
+        /// Size of the payload following the record header, i.e. after compression.
+        uint64_t storedSize = 0;
+        /// Size of the dump file the record is extracted to.
+        uint64_t dumpSize = 0;
+        DumpCompression compression = DumpCompression::None;
+        /// CRC-32 of the uncompressed payload.
+        uint32_t checksum = 0;
+        /// The uncompressed payload is the concatenation of all extents.
+        std::vector<DumpExtent> extents;
+    };
+
+    struct ArchiveIndexEntry
+    {
+        std::string dumpFileName;
+        ArchiveRecord record;
+    };
+
+    /**
+     * Append-only archive of dumped memory regions. Every region becomes a record consisting of a header and the
+     * non-zero parts of its dump file, which are compressed if that saves space. Records are described by JSON lines
+     * in a separate index file that is appended after each record, so that an aborted run is readable up to its last
+     * complete region. The buffer for compressing a record is charged to the memory budget. If it does not fit, the
+     * record is stored uncompressed instead of waiting for memory.
+     *
+     * Each run writes to archive files of its own, so that the offset of every record is known exactly. As a failed
+     * write leaves an unknown amount of data behind, all following records go to a new archive file of the run.
+     */
+    class DumpArchive
+    {
+      public:
+        static constexpr std::array<uint8_t, 8> recordMagic{'I', 'M', 'S', 'D', 'U', 'M', 'P', '1'};
+        /// Magic followed by the little endian run id, uid and stored size of the record.
+        static constexpr std::size_t recordHeaderSize = recordMagic.size() + 3 * sizeof(uint64_t);
+
+        /// Archive files and the index are created in the output directory. A compression level of zero stores all
+        /// records uncompressed.
+        DumpArchive(const VmiCore::Plugin::PluginInterface* pluginInterface,
+                    std::filesystem::path outputDirectory,
+                    int compressionLevel,
+                    std::shared_ptr<MemoryBudget> memoryBudget);
+
+        /// Appends the data of all chunks as a new record. Holes are only described by the extents of the record.
+        /// Throws a DumpArchiveException if the record could not be written, in which case it must not be indexed.
+        [[nodiscard]] ArchiveRecord appendRecord(uint64_t uid, std::span<const VmiCore::FileChunk> chunks);
+
+        /// Appends a single JSON object as a line to the index.
+        void appendIndexEntry(const std::string& indexEntry);
+
+        /// JSON members describing the given record, to be embedded into its index entry.
+        [[nodiscard]] static std::string toJsonMembers(const ArchiveRecord& record);
+
+        [[nodiscard]] static uint32_t updateChecksum(uint32_t checksum, std::span<const uint8_t> data);
+
+        [[nodiscard]] static bool isCompressionSupported();
+
+      private:
+        const VmiCore::Plugin::PluginInterface* pluginInterface;
+        std::filesystem::path outputDirectory;
+        std::string indexFile;
+        int compressionLevel;
+        std::shared_ptr<MemoryBudget> memoryBudget;
+        uint64_t runId;
+        /// Serializes appends, so that the offset of each record is known.
+        std::mutex appendLock;
+        std::string archiveFileName;
+        std::size_t archiveFileCount = 0;
+        uint64_t archiveSize = 0;
+
+        /// Starts a new archive file of this run. Requires appendLock.
+        void startArchiveFile();
+
+        /// Returns an empty buffer if the compressed payload would not be smaller than the payload itself.
+        [[nodiscard]] std::vector<uint8_t> compress(std::span<const VmiCore::FileChunk> chunks,
+                                                    std::size_t payloadSize) const;
+    };
+
+    /// Reads the records of an archive written by DumpArchive.
+    class DumpArchiveReader
+    {
+      public:
+        explicit DumpArchiveReader(std::istream& archive);
+
+        /// Malformed lines, e.g. a partially written last line of an aborted run, are skipped.
+        [[nodiscard]] static std::vector<ArchiveIndexEntry> readIndex(std::istream& index, std::size_t& skippedLines);
+
+        /// Returns the uncompressed payload of a record after verifying its header, sizes and checksum. The archive has
+        /// to be the file named by the record. Nothing is allocated for sizes the archive cannot satisfy.
+        [[nodiscard]] std::vector<uint8_t> readPayload(const ArchiveRecord& record);
+
+        /// Returns the dump file content of a record including all zero parts.
+        [[nodiscard]] std::vector<uint8_t> readDump(const ArchiveRecord& record);
+
+        /// Writes the dump file of a record. Zero parts are written as holes of a sparse file.
+        void extract(const ArchiveRecord& record, const std::filesystem::path& dumpFile);
+
+      private:
+        std::istream& archive;
+        uint64_t archiveSize;
+
+        [[nodiscard]] bool hasHeaderAt(uint64_t offset, std::span<const uint8_t> header);
+    };
+}
+
+#endif // INMEMORYSCANNER_DUMPARCHIVE_H
@@ -2,30 +2,42 @@
 #include "Common.h"
 #include "Filenames.h"
 #include "Scanner.h"
+#include "ZeroPages.h"
 #include <algorithm>
 #include <fmt/core.h>
+#include <vmicore/os/PagingDefinitions.h>
 
+using VmiCore::addr_t;
+using VmiCore::FileChunk;
+using VmiCore::MappedRegion;
 using VmiCore::MemoryRegion;
+using VmiCore::PagingDefinitions::pageSizeInBytes;
 using VmiCore::Plugin::PluginInterface;
 
 namespace InMemoryScanner
 {
-    Dumping::Dumping(PluginInterface* pluginInterface, std::shared_ptr<IConfig> configuration)
+    Dumping::Dumping(PluginInterface* pluginInterface,
+                     std::shared_ptr<IConfig> configuration,
+                     std::shared_ptr<MemoryBudget> memoryBudget)
         : pluginInterface(pluginInterface),
           configuration(std::move(configuration)),
-          logger(pluginInterface->newNamedLogger(INMEMORY_LOGGER_NAME))
+          logger(pluginInterface->newNamedLogger(INMEMORY_LOGGER_NAME)),
+          dumpArchive(pluginInterface,
+                      this->configuration->getOutputPath(),
+                      this->configuration->getDumpCompressionLevel(),
+                      std::move(memoryBudget))
     {
-        dumpingPath = this->configuration->getOutputPath() / "dumpedRegions";
         logger->bind({{VmiCore::WRITE_TO_FILE_TAG, LOG_FILENAME}});
     }
 
     void Dumping::dumpMemoryRegion(const std::string& processName,
                                    pid_t pid,
                                    const MemoryRegion& memoryRegionDescriptor,
-                                   const std::vector<uint8_t>& data)
+                                   std::span<const MappedRegion> mappedRegions)
     {
+        auto regionId = getNextRegionId();
         auto memoryRegionInformation =
-            createMemoryRegionInformation(processName, pid, memoryRegionDescriptor, getNextRegionId());
+            createMemoryRegionInformation(processName, pid, memoryRegionDescriptor, regionId);
         auto inMemDumpFileName = memoryRegionInformation->getMemFileName();
 
         logger->info("Dumping Memory region",
@@ -36,11 +48,18 @@ namespace InMemoryScanner
                       {"Module", memoryRegionInformation->moduleName},
                       {"DumpFile", inMemDumpFileName}});
 
-        pluginInterface->writeToFile(dumpingPath / inMemDumpFileName, data);
-
-        auto inMemRegionInfo = memoryRegionInformation->toString();
-
-        appendRegionInfo(inMemRegionInfo);
+        ArchiveRecord archiveRecord;
+        try
+        {
+            archiveRecord = dumpArchive.appendRecord(regionId, createSparseChunks(mappedRegions));
+        }
+        catch (const DumpArchiveException& e)
+        {
+            logger->error("Unable to dump memory region", {{"DumpFile", inMemDumpFileName}, {"Exception", e.what()}});
+            return;
+        }
+        // The index entry is only written once the record is complete, so that every entry refers to valid data
+        dumpArchive.appendIndexEntry(memoryRegionInformation->toString(archiveRecord));
     }
 
     std::unique_ptr<MemoryRegionInformation> Dumping::createMemoryRegionInformation(
@@ -72,21 +91,56 @@ namespace InMemoryScanner
         return memRegionInformationUniquePointer;
     }
 
-    int Dumping::getNextRegionId()
+    std::vector<FileChunk> Dumping::createSparseChunks(std::span<const MappedRegion> mappedRegions)
     {
-        std::scoped_lock guard(counterLock);
-        return memoryRegionCounter++;
-    }
+        std::vector<FileChunk> chunks;
+        auto appendHole = [&chunks](std::size_t holeSize)
+        {
+            if (chunks.empty())
+            {
+                chunks.emplace_back();
+            }
+            chunks.back().holeSize += holeSize;
+        };
 
-    void Dumping::appendRegionInfo(const std::string& regionInfo)
-    {
-        std::scoped_lock guard(lock);
-        memoryRegionInfo.emplace_back(regionInfo);
+        chunks.reserve(mappedRegions.size());
+        addr_t previousEnd = 0;
+        for (const auto& mappedRegion : mappedRegions)
+        {
+            // Mapped regions may also be contiguous in the guest, e.g. if they have been captured in windows
+            if (&mappedRegion != &mappedRegions.front() && mappedRegion.guestBaseVA != previousEnd)
+            {
+                // Unmapped parts are represented by a single page of padding
+                appendHole(pageSizeInBytes);
+            }
+
+            auto mappedSpan = mappedRegion.asSpan();
+            previousEnd = mappedRegion.guestBaseVA + mappedSpan.size();
+            for (std::size_t pageOffset = 0; pageOffset < mappedSpan.size(); pageOffset += pageSizeInBytes)
+            {
+                auto page = mappedSpan.subspan(pageOffset, pageSizeInBytes);
+                if (isZeroPage(page))
+                {
+                    appendHole(pageSizeInBytes);
+                }
+                else if (chunks.empty() || chunks.back().holeSize > 0 || pageOffset == 0)
+                {
+                    chunks.push_back({.data = page, .holeSize = 0});
+                }
+                else
+                {
+                    // Pages of the same mapped region are contiguous
+                    chunks.back().data = {chunks.back().data.data(), chunks.back().data.size() + page.size()};
+                }
+            }
+        }
+
+        return chunks;
     }
 
-    std::vector<std::string> Dumping::getAllMemoryRegionInformation()
+    int Dumping::getNextRegionId()
     {
-        std::scoped_lock guard(lock);
-        return memoryRegionInfo;
+        std::scoped_lock guard(counterLock);
+        return memoryRegionCounter++;
     }
 }
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "Config.h"
+#include "DumpArchive.h"
+#include "Json.h"
 
 #include <filesystem>
 #include <mutex>
 #include <random>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -69,11 +72,11 @@ namespace InMemoryScanner
                 .append(uid);
         }
 
-        [[nodiscard]] std::string toString()
+        [[nodiscard]] std::string toString(const ArchiveRecord& archiveRecord)
         {
             return std::string("{")
                 .append(R"("ProcessName": ")")
-                .append(processName)
+                .append(escapeJson(processName))
                 .append(R"(", )")
                 .append(R"("ProcessId": )")
                 .append(pid)
@@ -82,13 +85,13 @@ namespace InMemoryScanner
                 .append(boolToString(isSharedMemory))
                 .append(", ")
                 .append(R"("AccessRights": ")")
-                .append(flags)
+                .append(escapeJson(flags))
                 .append(R"(", )")
                 .append(R"("StartAddress": ")")
-                .append(startAddress)
+                .append(escapeJson(startAddress))
                 .append(R"(", )")
                 .append(R"("EndAddress": ")")
-                .append(endAddress)
+                .append(escapeJson(endAddress))
                 .append(R"(", )")
                 .append(R"("BeingDeleted": )")
                 .append(boolToString(isBeingDeleted))
@@ -100,8 +103,10 @@ namespace InMemoryScanner
                 .append(uid)
                 .append(", ")
                 .append(R"("DumpFileName": ")")
-                .append(getMemFileName())
-                .append(R"(" })");
+                .append(escapeJson(getMemFileName()))
+                .append(R"(", )")
+                .append(DumpArchive::toJsonMembers(archiveRecord))
+                .append(" }");
         }
 
       private:
@@ -118,12 +123,15 @@ namespace InMemoryScanner
       public:
         virtual ~IDumping() = default;
 
+        /**
+         * Appends the mapped regions as a single record to the dump archive and describes it in the archive index.
+         * Unmapped gaps are represented by a single page of zeros between two mapped regions that are not contiguous in
+         * the guest.
+         */
         virtual void dumpMemoryRegion(const std::string& processName,
                                       pid_t pid,
                                       const VmiCore::MemoryRegion& memoryRegionDescriptor,
-                                      const std::vector<uint8_t>& data) = 0;
-
-        virtual std::vector<std::string> getAllMemoryRegionInformation() = 0;
+                                      std::span<const VmiCore::MappedRegion> mappedRegions) = 0;
 
       protected:
         IDumping() = default;
@@ -133,25 +141,23 @@ namespace InMemoryScanner
     {
 
       public:
-        Dumping(VmiCore::Plugin::PluginInterface* pluginInterface, std::shared_ptr<IConfig> configuration);
+        /// The memory budget is charged with the buffers for compressing dumps.
+        Dumping(VmiCore::Plugin::PluginInterface* pluginInterface,
+                std::shared_ptr<IConfig> configuration,
+                std::shared_ptr<MemoryBudget> memoryBudget);
 
         ~Dumping() override = default;
 
         void dumpMemoryRegion(const std::string& processName,
                               pid_t pid,
                               const VmiCore::MemoryRegion& memoryRegionDescriptor,
-                              const std::vector<uint8_t>& data) override;
-
-        std::vector<std::string> getAllMemoryRegionInformation() override;
+                              std::span<const VmiCore::MappedRegion> mappedRegions) override;
 
       private:
         VmiCore::Plugin::PluginInterface* pluginInterface;
         std::shared_ptr<IConfig> configuration;
         std::unique_ptr<VmiCore::ILogger> logger;
-
-        std::filesystem::path dumpingPath;
-        std::mutex lock{};
-        std::vector<std::string> memoryRegionInfo{};
+        DumpArchive dumpArchive;
         int memoryRegionCounter{};
         std::mutex counterLock{};
 
@@ -161,8 +167,10 @@ namespace InMemoryScanner
                                       const VmiCore::MemoryRegion& memoryRegionDescriptor,
                                       int regionId);
 
-        [[nodiscard]] int getNextRegionId();
+        /// Zero pages and the padding page between mapped regions become holes of the dumped file.
+        [[nodiscard]] static std::vector<VmiCore::FileChunk>
+        createSparseChunks(std::span<const VmiCore::MappedRegion> mappedRegions);
 
-        void appendRegionInfo(const std::string& regionInfo);
+        [[nodiscard]] int getNextRegionId();
     };
 }
@@ -3,7 +3,12 @@
 namespace InMemoryScanner
 {
     constexpr const char* TEXT_RESULT_FILENAME = "inMemoryResults.txt";
-    constexpr const char* XML_RESULT_FILENAME = "inMemoryResults.xml";
+    constexpr const char* JSON_RESULT_FILENAME = "inMemoryResults.jsonl";
+    constexpr const char* PROFILE_REPORT_FILENAME = "ruleProfile.txt";
+    constexpr const char* DUMP_ARCHIVE_FILENAME_STEM = "dumpedRegions";
+    constexpr const char* DUMP_ARCHIVE_EXTENSION = ".pack";
+    constexpr const char* DUMP_INDEX_FILENAME = "dumpedRegions.jsonl";
+    constexpr const char* RULES_CACHE_DIRECTORY_NAME = "rulesCache";
 
     constexpr const char* LOG_FILENAME = "inMemory.txt";
 }
@@ -2,8 +2,10 @@
 #define INMEMORYSCANNER_IYARAINTERFACE_H
 
 #include "Common.h"
+#include <cstdint>
 #include <span>
 #include <stdexcept>
+#include <string>
 #include <vector>
 #include <vmicore/vmi/IMemoryMapping.h>
 
@@ -19,6 +21,16 @@ namespace InMemoryScanner
         using YaraException::YaraException;
     };
 
+    /// Accumulated matching cost of a rule as measured by libyara.
+    struct RuleCost
+    {
+        std::string ruleNamespace;
+        std::string ruleName;
+        uint64_t cost;
+
+        bool operator==(const RuleCost& rhs) const = default;
+    };
+
     class IYaraInterface
     {
       public:
@@ -26,6 +38,9 @@ namespace InMemoryScanner
 
         virtual std::vector<Rule> scanMemory(std::span<const VmiCore::MappedRegion> mappedRegions) = 0;
 
+        /// Costs of all scans so far, highest first. Empty if libyara has been built without profiling support.
+        [[nodiscard]] virtual std::vector<RuleCost> getRuleCosts() = 0;
+
       protected:
         IYaraInterface() = default;
     };
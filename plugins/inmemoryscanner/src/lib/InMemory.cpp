@@ -11,6 +11,7 @@
 #include "Config.h"
 #include "Dumping.h"
 #include "Filenames.h"
+#include "YaraCompiler.h"
 #include "YaraInterface.h"
 #include <memory>
 #include <string>
@@ -44,9 +45,19 @@ namespace InMemoryScanner
         {
             configuration->overrideDumpMemoryFlag(dumpMemoryArgument.getValue());
         }
-        auto yara = std::make_unique<YaraInterface>(configuration->getSignatureFile(), configuration->getScanTimeout());
-        auto dumping = std::make_unique<Dumping>(pluginInterface, configuration);
-        scanner = std::make_unique<Scanner>(pluginInterface, configuration, std::move(yara), std::move(dumping));
+        auto rulesCacheDirectory = configuration->getRulesCacheDirectory();
+        if (rulesCacheDirectory.empty())
+        {
+            rulesCacheDirectory = std::filesystem::path(*pluginInterface->getResultsDir()) /
+                                  configuration->getOutputPath() / RULES_CACHE_DIRECTORY_NAME;
+        }
+        auto compiledRules =
+            YaraCompiler(pluginInterface, rulesCacheDirectory).getCompiledRules(configuration->getSignatureFile());
+        auto yara = std::make_unique<YaraInterface>(compiledRules, configuration->getScanTimeout());
+        auto memoryBudget = std::make_shared<MemoryBudget>(configuration->getInFlightMemoryLimit());
+        auto dumping = std::make_unique<Dumping>(pluginInterface, configuration, memoryBudget);
+        scanner = std::make_unique<Scanner>(
+            pluginInterface, configuration, std::move(yara), std::move(dumping), std::move(memoryBudget));
     }
 
     void InMemory::unload()
@@ -54,6 +65,7 @@ namespace InMemoryScanner
         logger->info("Shutdown initiated");
         try
         {
+            scanner->finishPendingScans();
             scanner->scanAllProcesses();
         }
         catch (const std::exception& exc)
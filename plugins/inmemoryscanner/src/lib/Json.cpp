@@ -0,0 +1,42 @@
+#include "Json.h"
+#include <fmt/core.h>
+
+namespace InMemoryScanner
+{
+    std::string escapeJson(std::string_view value)
+    {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (auto character : value)
+        {
+            switch (character)
+            {
+                case '"':
+                    escaped.append(R"(\")");
+                    break;
+                case '\\':
+                    escaped.append(R"(\\)");
+                    break;
+                case '\n':
+                    escaped.append(R"(\n)");
+                    break;
+                case '\r':
+                    escaped.append(R"(\r)");
+                    break;
+                case '\t':
+                    escaped.append(R"(\t)");
+                    break;
+                default:
+                    if (static_cast<unsigned char>(character) < 0x20)
+                    {
+                        escaped.append(fmt::format("\\u{:04x}", static_cast<unsigned char>(character)));
+                    }
+                    else
+                    {
+                        escaped.push_back(character);
+                    }
+            }
+        }
+        return escaped;
+    }
+}
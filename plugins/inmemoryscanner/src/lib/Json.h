@@ -0,0 +1,13 @@
+#ifndef INMEMORYSCANNER_JSON_H
+#define INMEMORYSCANNER_JSON_H
+
+#include <string>
+#include <string_view>
+
+namespace InMemoryScanner
+{
+    /// Escapes a value for the use inside of a JSON string literal. Guest controlled strings must always pass here.
+    [[nodiscard]] std::string escapeJson(std::string_view value);
+}
+
+#endif // INMEMORYSCANNER_JSON_H
@@ -0,0 +1,130 @@
+#include "MemoryBudget.h"
+#include <algorithm>
+
+namespace InMemoryScanner
+{
+    MemoryBudget::Reservation::Reservation(MemoryBudget& memoryBudget, std::size_t bytes)
+        : memoryBudget(memoryBudget), bytes(bytes)
+    {
+    }
+
+    MemoryBudget::Reservation::~Reservation()
+    {
+        memoryBudget.release(bytes);
+    }
+
+    void MemoryBudget::Reservation::shrink(std::size_t remainingBytes)
+    {
+        if (remainingBytes >= bytes)
+        {
+            return;
+        }
+        memoryBudget.release(bytes - remainingBytes);
+        bytes = remainingBytes;
+    }
+
+    MemoryBudget::MemoryBudget(std::size_t limit) : limit(limit) {}
+
+    std::unique_ptr<MemoryBudget::Reservation>
+    MemoryBudget::acquire(std::size_t bytes,
+                          AdmissionPriority priority,
+                          const std::function<bool()>& finishPendingWork,
+                          std::size_t heldBytes)
+    {
+        auto waitStart = std::chrono::steady_clock::now();
+        std::unique_lock guard(budgetLock);
+        if (fits(bytes, priority, heldBytes))
+        {
+            return admit(bytes, std::chrono::nanoseconds(0));
+        }
+
+        auto& waitingRequestsOfPriority = waitingRequests[static_cast<std::size_t>(priority)];
+        waitingRequestsOfPriority++;
+        auto stopWaiting = [this, &waitingRequestsOfPriority]()
+        {
+            waitingRequestsOfPriority--;
+            // Normal requests may have been held back by this one
+            memoryReleased.notify_all();
+        };
+        try
+        {
+            while (!fits(bytes, priority, heldBytes))
+            {
+                guard.unlock();
+                bool hasFinishedWork = finishPendingWork && finishPendingWork();
+                guard.lock();
+                if (!hasFinishedWork)
+                {
+                    memoryReleased.wait_for(guard,
+                                            pendingWorkPollInterval,
+                                            [this, bytes, priority, heldBytes]()
+                                            { return fits(bytes, priority, heldBytes); });
+                }
+            }
+        }
+        catch (...)
+        {
+            stopWaiting();
+            throw;
+        }
+        stopWaiting();
+
+        return admit(bytes, std::chrono::steady_clock::now() - waitStart);
+    }
+
+    std::unique_ptr<MemoryBudget::Reservation> MemoryBudget::tryAcquire(std::size_t bytes, AdmissionPriority priority)
+    {
+        std::scoped_lock guard(budgetLock);
+        if (!fits(bytes, priority))
+        {
+            statistics.rejectedRequests++;
+            return nullptr;
+        }
+        return admit(bytes, std::chrono::nanoseconds(0));
+    }
+
+    MemoryBudgetStatistics MemoryBudget::getStatistics() const
+    {
+        std::scoped_lock guard(budgetLock);
+        return statistics;
+    }
+
+    bool MemoryBudget::fits(std::size_t bytes, AdmissionPriority priority, std::size_t heldBytes) const
+    {
+        if (priority == AdmissionPriority::Normal &&
+            waitingRequests[static_cast<std::size_t>(AdmissionPriority::Urgent)] > 0)
+        {
+            return false;
+        }
+        return usedBytes <= heldBytes || bytes <= limit - std::min(usedBytes, limit);
+    }
+
+    std::unique_ptr<MemoryBudget::Reservation> MemoryBudget::admit(std::size_t bytes,
+                                                                   std::chrono::nanoseconds waitTime)
+    {
+        if (usedBytes + bytes > limit)
+        {
+            statistics.overcommittedAdmissions++;
+        }
+        usedBytes += bytes;
+        statistics.admissions++;
+        statistics.peakBytes = std::max(statistics.peakBytes, usedBytes);
+        if (waitTime > std::chrono::nanoseconds(0))
+        {
+            statistics.delayedAdmissions++;
+            statistics.totalWaitTime += waitTime;
+            statistics.maxWaitTime = std::max(statistics.maxWaitTime, waitTime);
+        }
+
+        return std::make_unique<Reservation>(*this, bytes);
+    }
+
+    void MemoryBudget::release(std::size_t bytes)
+    {
+        {
+            std::scoped_lock guard(budgetLock);
+            usedBytes -= bytes;
+        }
+        memoryReleased.notify_all();
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef INMEMORYSCANNER_MEMORYBUDGET_H
+#define INMEMORYSCANNER_MEMORYBUDGET_H
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace InMemoryScanner
+{
+    enum class AdmissionPriority
+    {
+        Normal,
+        /// Work the guest is paused for, e.g. the scan of a terminating process.
+        Urgent
+    };
+
+    struct MemoryBudgetStatistics
+    {
+        std::size_t admissions = 0;
+        /// Admissions that had to wait for memory to be released.
+        std::size_t delayedAdmissions = 0;
+        /// Admissions that exceeded the limit on their own.
+        std::size_t overcommittedAdmissions = 0;
+        std::size_t rejectedRequests = 0;
+        std::chrono::nanoseconds totalWaitTime{0};
+        std::chrono::nanoseconds maxWaitTime{0};
+        std::size_t peakBytes = 0;
+    };
+
+    /**
+     * Limits the host memory held by all pending scans together, i.e. mapped guest memory as well as captured copies
+     * of it. Requests are admitted as soon as their size fits into the budget, but normal requests are held back while
+     * urgent ones are waiting.
+     */
+    class MemoryBudget
+    {
+      public:
+        /// Returns its bytes to the budget upon destruction.
+        class Reservation
+        {
+          public:
+            Reservation(MemoryBudget& memoryBudget, std::size_t bytes);
+
+            Reservation(const Reservation&) = delete;
+
+            Reservation& operator=(const Reservation&) = delete;
+
+            ~Reservation();
+
+            /// Returns the bytes beyond the given amount to the budget, e.g. once a mapping has turned out smaller.
+            void shrink(std::size_t remainingBytes);
+
+          private:
+            MemoryBudget& memoryBudget;
+            std::size_t bytes;
+        };
+
+        /// Time after which a waiting request looks for pending work again, as new work may have been submitted.
+        static constexpr std::chrono::milliseconds pendingWorkPollInterval{10};
+
+        explicit MemoryBudget(std::size_t limit);
+
+        /**
+         * Blocks until the given amount of memory fits into the budget. While waiting, finishPendingWork is called,
+         * because the pending work might not be able to release memory otherwise, e.g. if it waits for the worker
+         * blocked by this request. If it returns false as there was no work to do, memory released by others is waited
+         * for up to pendingWorkPollInterval before it is called again. A request exceeding the limit on its own is
+         * admitted once the budget is unused. Memory the caller holds itself and cannot release before this request
+         * is admitted is passed as heldBytes and does not count as used for the latter.
+         */
+        [[nodiscard]] std::unique_ptr<Reservation> acquire(std::size_t bytes,
+                                                           AdmissionPriority priority,
+                                                           const std::function<bool()>& finishPendingWork,
+                                                           std::size_t heldBytes = 0);
+
+        /// Fails instead of blocking if the memory does not fit into the budget right away.
+        [[nodiscard]] std::unique_ptr<Reservation> tryAcquire(std::size_t bytes, AdmissionPriority priority);
+
+        [[nodiscard]] MemoryBudgetStatistics getStatistics() const;
+
+      private:
+        std::size_t limit;
+        std::size_t usedBytes = 0;
+        /// Number of blocked requests per priority.
+        std::array<std::size_t, 2> waitingRequests{};
+        MemoryBudgetStatistics statistics;
+        mutable std::mutex budgetLock;
+        std::condition_variable memoryReleased;
+
+        /// Requires the budget lock to be held.
+        [[nodiscard]] bool fits(std::size_t bytes, AdmissionPriority priority, std::size_t heldBytes = 0) const;
+
+        /// Requires the budget lock to be held.
+        [[nodiscard]] std::unique_ptr<Reservation> admit(std::size_t bytes, std::chrono::nanoseconds waitTime);
+
+        void release(std::size_t bytes);
+    };
+}
+
+#endif // INMEMORYSCANNER_MEMORYBUDGET_H
@@ -1,6 +1,7 @@
 #include "OutputXML.h"
 #include "rapidxml/rapidxml_print.hpp"
 #include <sstream>
+#include <yaml-cpp/yaml.h>
 
 namespace InMemoryScanner
 {
@@ -45,6 +46,46 @@ namespace InMemoryScanner
         }
     }
 
+    std::size_t OutputXML::addResults(std::istream& jsonLines)
+    {
+        std::size_t skippedLines = 0;
+        std::string line;
+        while (std::getline(jsonLines, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+            // JSON is valid YAML in flow style, so no separate JSON parser is needed
+            try
+            {
+                auto resultNode = YAML::Load(line);
+                std::vector<Rule> results;
+                for (const auto& ruleNode : resultNode["Rules"])
+                {
+                    Rule rule{.ruleName = ruleNode["Name"].as<std::string>(),
+                              .ruleNamespace = ruleNode["Namespace"].as<std::string>(),
+                              .matches = {}};
+                    for (const auto& matchNode : ruleNode["Matches"])
+                    {
+                        rule.matches.push_back({.matchName = matchNode["Name"].as<std::string>(),
+                                                .position = matchNode["Position"].as<int64_t>()});
+                    }
+                    results.push_back(std::move(rule));
+                }
+                addResult(resultNode["ProcessName"].as<std::string>(),
+                          resultNode["ProcessId"].as<int>(),
+                          std::stoull(resultNode["BaseAddress"].as<std::string>(), nullptr, 16),
+                          results);
+            }
+            catch (const std::exception&)
+            {
+                skippedLines++;
+            }
+        }
+        return skippedLines;
+    }
+
     std::unique_ptr<std::string> OutputXML::getString() const
     {
         std::stringstream ss;
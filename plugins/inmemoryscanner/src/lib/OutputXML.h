@@ -2,6 +2,7 @@
 
 #include "Common.h"
 #include "rapidxml/rapidxml.hpp"
+#include <istream>
 #include <memory>
 #include <mutex>
 
@@ -14,6 +15,14 @@ namespace InMemoryScanner
 
         void addResult(const std::string& processName, int pid, uint64_t baseAddress, const std::vector<Rule>& results);
 
+        /**
+         * Adds all results of a JSON Lines file as written by the ResultsWriter. Lines that cannot be parsed, e.g. the
+         * last one of an aborted run, are skipped.
+         *
+         * @return Number of skipped lines.
+         */
+        std::size_t addResults(std::istream& jsonLines);
+
         [[nodiscard]] std::unique_ptr<std::string> getString() const;
 
       private:
@@ -0,0 +1,107 @@
+#include "ResultsWriter.h"
+#include "Json.h"
+#include <fmt/core.h>
+#include <iterator>
+
+using VmiCore::addr_t;
+using VmiCore::pid_t;
+using VmiCore::Plugin::PluginInterface;
+
+namespace InMemoryScanner
+{
+    ResultsWriter::ResultsWriter(const PluginInterface* pluginInterface,
+                                 std::string resultsFile,
+                                 std::chrono::milliseconds flushInterval)
+        : pluginInterface(pluginInterface),
+          resultsFile(std::move(resultsFile)),
+          flushInterval(flushInterval),
+          flushThread([this](const std::stop_token& stopToken) { flushPeriodically(stopToken); })
+    {
+    }
+
+    ResultsWriter::~ResultsWriter()
+    {
+        flushThread.request_stop();
+        flushThread.join();
+        flush();
+    }
+
+    void ResultsWriter::addResult(const std::string& processName,
+                                  pid_t pid,
+                                  addr_t baseAddress,
+                                  const std::vector<Rule>& results)
+    {
+        auto line = toJsonLine(processName, pid, baseAddress, results);
+        bool flushDue = false;
+        {
+            std::scoped_lock guard(bufferLock);
+            buffer.append(line);
+            flushDue = buffer.size() >= maxBufferedBytes;
+        }
+        if (flushDue)
+        {
+            flushRequested.notify_one();
+        }
+    }
+
+    void ResultsWriter::flush()
+    {
+        std::scoped_lock writeGuard(writeLock);
+        std::string content;
+        {
+            std::scoped_lock guard(bufferLock);
+            content.swap(buffer);
+        }
+        if (!content.empty())
+        {
+            pluginInterface->writeToFile(resultsFile, content);
+        }
+    }
+
+    std::string ResultsWriter::toJsonLine(const std::string& processName,
+                                          pid_t pid,
+                                          addr_t baseAddress,
+                                          const std::vector<Rule>& results)
+    {
+        std::string line;
+        auto out = std::back_inserter(line);
+        fmt::format_to(out,
+                       R"({{"ProcessName": "{}", "ProcessId": {}, "BaseAddress": "{:x}", "Rules": [)",
+                       escapeJson(processName),
+                       pid,
+                       baseAddress);
+        for (const auto& rule : results)
+        {
+            fmt::format_to(out,
+                           R"({}{{"Namespace": "{}", "Name": "{}", "Matches": [)",
+                           &rule == &results.front() ? "" : ", ",
+                           escapeJson(rule.ruleNamespace),
+                           escapeJson(rule.ruleName));
+            for (const auto& match : rule.matches)
+            {
+                fmt::format_to(out,
+                               R"({}{{"Name": "{}", "Position": {}}})",
+                               &match == &rule.matches.front() ? "" : ", ",
+                               escapeJson(match.matchName),
+                               match.position);
+            }
+            line.append("]}");
+        }
+        line.append("]}\n");
+
+        return line;
+    }
+
+    void ResultsWriter::flushPeriodically(const std::stop_token& stopToken)
+    {
+        while (!stopToken.stop_requested())
+        {
+            {
+                std::unique_lock guard(bufferLock);
+                flushRequested.wait_for(
+                    guard, stopToken, flushInterval, [this]() { return buffer.size() >= maxBufferedBytes; });
+            }
+            flush();
+        }
+    }
+}
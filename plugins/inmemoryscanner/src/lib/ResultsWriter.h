@@ -0,0 +1,68 @@
+#ifndef INMEMORYSCANNER_RESULTSWRITER_H
+#define INMEMORYSCANNER_RESULTSWRITER_H
+
+#include "Common.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+#include <vmicore/plugins/PluginInterface.h>
+
+namespace InMemoryScanner
+{
+    /**
+     * Streams scan results to a JSON Lines file, one line per memory region with matches. Results are only buffered
+     * until the next flush of a background thread, so that they survive an abnormal termination of VMICore and the
+     * memory consumption does not grow with the number of detections.
+     */
+    class ResultsWriter
+    {
+      public:
+        /// Results are flushed early once this many bytes are buffered.
+        static constexpr std::size_t maxBufferedBytes = 64 * 1024;
+
+        ResultsWriter(const VmiCore::Plugin::PluginInterface* pluginInterface,
+                      std::string resultsFile,
+                      std::chrono::milliseconds flushInterval);
+
+        ResultsWriter(const ResultsWriter&) = delete;
+
+        ResultsWriter& operator=(const ResultsWriter&) = delete;
+
+        /// Flushes all remaining results.
+        ~ResultsWriter();
+
+        void addResult(const std::string& processName,
+                       VmiCore::pid_t pid,
+                       VmiCore::addr_t baseAddress,
+                       const std::vector<Rule>& results);
+
+        /// Writes all buffered results before returning.
+        void flush();
+
+        [[nodiscard]] static std::string toJsonLine(const std::string& processName,
+                                                    VmiCore::pid_t pid,
+                                                    VmiCore::addr_t baseAddress,
+                                                    const std::vector<Rule>& results);
+
+      private:
+        const VmiCore::Plugin::PluginInterface* pluginInterface;
+        std::string resultsFile;
+        std::chrono::milliseconds flushInterval;
+        std::mutex bufferLock;
+        std::condition_variable_any flushRequested;
+        std::string buffer;
+        /// Serializes writes, so that lines are appended in the order they have been buffered.
+        std::mutex writeLock;
+        // Declared last so that the thread is stopped before any of the members it uses are destroyed
+        std::jthread flushThread;
+
+        void flushPeriodically(const std::stop_token& stopToken);
+    };
+}
+
+#endif // INMEMORYSCANNER_RESULTSWRITER_H
@@ -0,0 +1,150 @@
+#include "ScanProfiler.h"
+#include <algorithm>
+#include <fmt/core.h>
+#include <iterator>
+
+using VmiCore::addr_t;
+using VmiCore::pid_t;
+
+namespace InMemoryScanner
+{
+    namespace
+    {
+        template <typename Key>
+        std::vector<std::pair<Key, std::size_t>> sortByCount(const std::map<Key, std::size_t>& counts)
+        {
+            std::vector<std::pair<Key, std::size_t>> sortedCounts(counts.begin(), counts.end());
+            std::ranges::stable_sort(sortedCounts, std::ranges::greater{}, &std::pair<Key, std::size_t>::second);
+            return sortedCounts;
+        }
+
+        double toMilliseconds(std::chrono::nanoseconds duration)
+        {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+    }
+
+    ScanProfiler::ScanProfiler(std::string ruleSetName) : ruleSetName(std::move(ruleSetName)) {}
+
+    void ScanProfiler::recordRegionScan(const std::string& processName,
+                                        pid_t pid,
+                                        addr_t base,
+                                        std::size_t scannedBytes,
+                                        std::chrono::nanoseconds duration,
+                                        const std::vector<Rule>& results)
+    {
+        std::scoped_lock guard(profileLock);
+
+        addRegionScan({.processName = processName,
+                       .pid = pid,
+                       .base = base,
+                       .scannedBytes = scannedBytes,
+                       .duration = duration,
+                       .timedOut = false});
+        for (const auto& rule : results)
+        {
+            ruleMatches[{rule.ruleNamespace, rule.ruleName}]++;
+            for (const auto& match : rule.matches)
+            {
+                stringMatches[{rule.ruleNamespace, rule.ruleName, match.matchName}]++;
+            }
+        }
+    }
+
+    void ScanProfiler::recordTimeout(const std::string& processName,
+                                     pid_t pid,
+                                     addr_t base,
+                                     std::size_t scannedBytes,
+                                     std::chrono::nanoseconds duration)
+    {
+        std::scoped_lock guard(profileLock);
+
+        addRegionScan({.processName = processName,
+                       .pid = pid,
+                       .base = base,
+                       .scannedBytes = scannedBytes,
+                       .duration = duration,
+                       .timedOut = true});
+        timeouts++;
+    }
+
+    void ScanProfiler::addRegionScan(RegionScan regionScan)
+    {
+        regionScanCount++;
+        totalScannedBytes += regionScan.scannedBytes;
+        totalDuration += regionScan.duration;
+
+        // The heap is ordered by std::ranges::greater, so that its front is the fastest of the retained scans
+        if (slowestRegionScans.size() == maxReportedRegions)
+        {
+            if (regionScan.duration <= slowestRegionScans.front().duration)
+            {
+                return;
+            }
+            std::ranges::pop_heap(slowestRegionScans, std::ranges::greater{}, &RegionScan::duration);
+            slowestRegionScans.pop_back();
+        }
+        slowestRegionScans.push_back(std::move(regionScan));
+        std::ranges::push_heap(slowestRegionScans, std::ranges::greater{}, &RegionScan::duration);
+    }
+
+    std::string ScanProfiler::createReport(const std::vector<RuleCost>& ruleCosts) const
+    {
+        std::scoped_lock guard(profileLock);
+
+        std::string report;
+        auto out = std::back_inserter(report);
+        fmt::format_to(out, "Rule set: {}\n", ruleSetName);
+        fmt::format_to(out,
+                       "Scanned regions: {}, scanned bytes: {}, total scan time: {:.3f} ms, timeouts: {}\n",
+                       regionScanCount,
+                       totalScannedBytes,
+                       toMilliseconds(totalDuration),
+                       timeouts);
+
+        if (!ruleCosts.empty())
+        {
+            fmt::format_to(out, "\nRule costs reported by libyara\n{:>16}  {}\n", "Cost", "Rule");
+            for (const auto& ruleCost : ruleCosts)
+            {
+                fmt::format_to(out, "{:>16}  {}:{}\n", ruleCost.cost, ruleCost.ruleNamespace, ruleCost.ruleName);
+            }
+        }
+
+        fmt::format_to(out, "\nRule matches\n{:>16}  {}\n", "Regions", "Rule");
+        for (const auto& [rule, count] : sortByCount(ruleMatches))
+        {
+            fmt::format_to(out, "{:>16}  {}:{}\n", count, rule.first, rule.second);
+        }
+
+        fmt::format_to(out, "\nString matches\n{:>16}  {}\n", "Matches", "String");
+        for (const auto& [string, count] : sortByCount(stringMatches))
+        {
+            fmt::format_to(
+                out, "{:>16}  {}:{}:{}\n", count, std::get<0>(string), std::get<1>(string), std::get<2>(string));
+        }
+
+        auto slowestRegions = slowestRegionScans;
+        std::ranges::sort(slowestRegions, std::ranges::greater{}, &RegionScan::duration);
+        fmt::format_to(out,
+                       "\nSlowest regions\n{:>16}  {:>12}  {:>8}  {:>16}  {}\n",
+                       "Duration (ms)",
+                       "Bytes",
+                       "Pid",
+                       "Base",
+                       "Process");
+        for (const auto& regionScan : slowestRegions)
+        {
+            fmt::format_to(out,
+                           "{:>16.3f}  {:>12}  {:>8}  {:>16x}  {}{}\n",
+                           toMilliseconds(regionScan.duration),
+                           regionScan.scannedBytes,
+                           regionScan.pid,
+                           regionScan.base,
+                           regionScan.processName,
+                           regionScan.timedOut ? " (timeout)" : "");
+        }
+
+        return report;
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef INMEMORYSCANNER_SCANPROFILER_H
+#define INMEMORYSCANNER_SCANPROFILER_H
+
+#include "Common.h"
+#include "IYaraInterface.h"
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <vmicore/types.h>
+
+namespace InMemoryScanner
+{
+    /**
+     * Collects the costs of yara scans, so that rule authors can find out which rules and regions slow down scanning.
+     * Per rule costs are only available if libyara has been built with profiling support. Otherwise, rules and
+     * strings are ranked by their number of matches, as every match has to be recorded and reported by libyara.
+     */
+    class ScanProfiler
+    {
+      public:
+        /// Number of slowest regions listed in the report. Only that many region scans are retained.
+        static constexpr std::size_t maxReportedRegions = 100;
+
+        explicit ScanProfiler(std::string ruleSetName);
+
+        void recordRegionScan(const std::string& processName,
+                              VmiCore::pid_t pid,
+                              VmiCore::addr_t base,
+                              std::size_t scannedBytes,
+                              std::chrono::nanoseconds duration,
+                              const std::vector<Rule>& results);
+
+        void recordTimeout(const std::string& processName,
+                           VmiCore::pid_t pid,
+                           VmiCore::addr_t base,
+                           std::size_t scannedBytes,
+                           std::chrono::nanoseconds duration);
+
+        /// Creates a human readable report with all entries sorted by descending cost.
+        [[nodiscard]] std::string createReport(const std::vector<RuleCost>& ruleCosts) const;
+
+      private:
+        struct RegionScan
+        {
+            std::string processName;
+            VmiCore::pid_t pid;
+            VmiCore::addr_t base;
+            std::size_t scannedBytes;
+            std::chrono::nanoseconds duration;
+            bool timedOut;
+        };
+
+        std::string ruleSetName;
+        mutable std::mutex profileLock;
+        /// Min-heap of the slowest region scans by duration, holds at most maxReportedRegions entries.
+        std::vector<RegionScan> slowestRegionScans;
+        std::size_t regionScanCount = 0;
+        std::size_t totalScannedBytes = 0;
+        std::chrono::nanoseconds totalDuration{0};
+        /// Keyed by namespace and rule name.
+        std::map<std::pair<std::string, std::string>, std::size_t> ruleMatches;
+        /// Keyed by namespace, rule name and string identifier.
+        std::map<std::tuple<std::string, std::string, std::string>, std::size_t> stringMatches;
+        std::size_t timeouts = 0;
+
+        void addRegionScan(RegionScan regionScan);
+    };
+}
+
+#endif // INMEMORYSCANNER_SCANPROFILER_H
@@ -0,0 +1,161 @@
+#include "ScanResultCache.h"
+#include <algorithm>
+
+using VmiCore::addr_t;
+using VmiCore::MappedRegion;
+
+namespace InMemoryScanner
+{
+    ScanResultCache::ScanResultCache(std::size_t capacity)
+        : capacity(capacity), key(SipHash128::createRandomKey())
+    {
+    }
+
+    RegionFingerprint ScanResultCache::createFingerprint(addr_t regionBase,
+                                                         std::span<const MappedRegion> mappedRegions) const
+    {
+        SipHash128 sipHash(key);
+        std::size_t size = 0;
+        for (const auto& mappedRegion : mappedRegions)
+        {
+            // The same content at a different offset within the region leads to different match positions
+            auto mappedSpan = mappedRegion.asSpan();
+            sipHash.update(mappedRegion.guestBaseVA - regionBase);
+            sipHash.update(static_cast<uint64_t>(mappedSpan.size()));
+            sipHash.update(mappedSpan);
+            size += mappedSpan.size();
+        }
+
+        return {.mac = sipHash.finalize(), .size = size};
+    }
+
+    std::optional<std::vector<Rule>> ScanResultCache::lookup(const RegionFingerprint& fingerprint, addr_t regionBase)
+    {
+        std::scoped_lock guard(cacheLock);
+
+        auto entryIterator = entryIndex.find(fingerprint);
+        if (entryIterator == entryIndex.end())
+        {
+            return std::nullopt;
+        }
+        entries.splice(entries.begin(), entries, entryIterator->second);
+        hitCount++;
+        skippedBytes += fingerprint.size;
+
+        return rebaseResults(entryIterator->second->second, static_cast<int64_t>(regionBase));
+    }
+
+    void ScanResultCache::insert(const RegionFingerprint& fingerprint,
+                                 addr_t regionBase,
+                                 const std::vector<Rule>& results)
+    {
+        if (capacity == 0)
+        {
+            return;
+        }
+        auto relativeResults = rebaseResults(results, -static_cast<int64_t>(regionBase));
+
+        std::scoped_lock guard(cacheLock);
+
+        if (entryIndex.contains(fingerprint))
+        {
+            return;
+        }
+        entries.emplace_front(fingerprint, std::move(relativeResults));
+        entryIndex.emplace(fingerprint, entries.begin());
+        if (entries.size() > capacity)
+        {
+            entryIndex.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+    std::optional<std::vector<Rule>> ScanResultCache::lookupImage(const ImageIdentity& imageIdentity,
+                                                                  const RegionFingerprint& fingerprint,
+                                                                  addr_t regionBase)
+    {
+        std::scoped_lock guard(cacheLock);
+
+        auto imageIterator = imageEntries.find(imageIdentity);
+        if (imageIterator == imageEntries.end())
+        {
+            return std::nullopt;
+        }
+        auto& variants = imageIterator->second;
+        auto variantIterator = std::ranges::find(variants, fingerprint, &Entry::first);
+        if (variantIterator == variants.end())
+        {
+            return std::nullopt;
+        }
+        hitCount++;
+        imageHitCount++;
+        skippedBytes += fingerprint.size;
+
+        return rebaseResults(variantIterator->second, static_cast<int64_t>(regionBase));
+    }
+
+    void ScanResultCache::insertImage(const ImageIdentity& imageIdentity,
+                                      const RegionFingerprint& fingerprint,
+                                      addr_t regionBase,
+                                      const std::vector<Rule>& results)
+    {
+        if (capacity == 0)
+        {
+            return;
+        }
+        auto relativeResults = rebaseResults(results, -static_cast<int64_t>(regionBase));
+
+        std::scoped_lock guard(cacheLock);
+
+        auto imageIterator = imageEntries.find(imageIdentity);
+        if (imageIterator == imageEntries.end())
+        {
+            if (imageEntries.size() >= capacity)
+            {
+                return;
+            }
+            imageIterator = imageEntries.emplace(imageIdentity, std::deque<Entry>{}).first;
+        }
+        auto& variants = imageIterator->second;
+        if (std::ranges::find(variants, fingerprint, &Entry::first) != variants.end())
+        {
+            return;
+        }
+        variants.emplace_front(fingerprint, std::move(relativeResults));
+        if (variants.size() > maxImageVariants)
+        {
+            variants.pop_back();
+        }
+    }
+
+    std::size_t ScanResultCache::getHitCount() const
+    {
+        std::scoped_lock guard(cacheLock);
+        return hitCount;
+    }
+
+    std::size_t ScanResultCache::getSkippedBytes() const
+    {
+        std::scoped_lock guard(cacheLock);
+        return skippedBytes;
+    }
+
+    std::size_t ScanResultCache::getImageHitCount() const
+    {
+        std::scoped_lock guard(cacheLock);
+        return imageHitCount;
+    }
+
+    std::vector<Rule> ScanResultCache::rebaseResults(const std::vector<Rule>& results, int64_t offset)
+    {
+        auto rebasedResults = results;
+        for (auto& rule : rebasedResults)
+        {
+            for (auto& match : rule.matches)
+            {
+                match.position += offset;
+            }
+        }
+        return rebasedResults;
+    }
+}
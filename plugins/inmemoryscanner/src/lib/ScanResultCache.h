@@ -0,0 +1,127 @@
+#ifndef INMEMORYSCANNER_SCANRESULTCACHE_H
+#define INMEMORYSCANNER_SCANRESULTCACHE_H
+
+#include "Common.h"
+#include "SipHash.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <vmicore/types.h>
+#include <vmicore/vmi/MappedRegion.h>
+
+namespace InMemoryScanner
+{
+    /// Identifies the content of a memory region independent of its location.
+    struct RegionFingerprint
+    {
+        SipHash128::Digest mac;
+        std::size_t size;
+
+        bool operator==(const RegionFingerprint& rhs) const = default;
+    };
+
+    struct RegionFingerprintHash
+    {
+        std::size_t operator()(const RegionFingerprint& fingerprint) const
+        {
+            return fingerprint.mac[0];
+        }
+    };
+
+    /// Identifies a mapped image, e.g. the main executable or a shared library, across processes.
+    struct ImageIdentity
+    {
+        std::string moduleName;
+        std::size_t size;
+
+        bool operator==(const ImageIdentity& rhs) const = default;
+    };
+
+    struct ImageIdentityHash
+    {
+        std::size_t operator()(const ImageIdentity& imageIdentity) const
+        {
+            return std::hash<std::string>{}(imageIdentity.moduleName) ^ std::hash<std::size_t>{}(imageIdentity.size);
+        }
+    };
+
+    /**
+     * Remembers the results of memory regions that have already been scanned, so that byte-identical regions, e.g. of
+     * multiple instances of the same process, are only scanned once. Matches are stored relative to the region base
+     * and are rebased on lookup.
+     *
+     * Deduplication works on whole regions only. Yara rules may match strings that span across pages and conditions may
+     * refer to the entire region, therefore a region whose content has changed in a single page is rescanned entirely.
+     * The cache is bound to the lifetime of the loaded rules.
+     *
+     * The fingerprint of a region is a 128 bit SipHash-2-4 MAC over the location and the content of all mapped chunks
+     * within the region. The key is chosen randomly per instance and never leaves the host.
+     *
+     * Images that are mapped into many processes are kept apart from the least recently used entries, so that their
+     * results survive scans of large numbers of private regions. An image result is only reused if the content
+     * fingerprint matches as well, because patched or hollowed images keep their identity.
+     */
+    class ScanResultCache
+    {
+      public:
+        /// Least recently used entries are evicted once the capacity is exceeded.
+        explicit ScanResultCache(std::size_t capacity);
+
+        [[nodiscard]] RegionFingerprint createFingerprint(VmiCore::addr_t regionBase,
+                                                          std::span<const VmiCore::MappedRegion> mappedRegions) const;
+
+        /// Returns the results of a previous scan of the same content with match positions rebased to the given base.
+        [[nodiscard]] std::optional<std::vector<Rule>> lookup(const RegionFingerprint& fingerprint,
+                                                              VmiCore::addr_t regionBase);
+
+        void insert(const RegionFingerprint& fingerprint, VmiCore::addr_t regionBase, const std::vector<Rule>& results);
+
+        /// Like lookup, but restricted to previous scans of the given image.
+        [[nodiscard]] std::optional<std::vector<Rule>> lookupImage(const ImageIdentity& imageIdentity,
+                                                                   const RegionFingerprint& fingerprint,
+                                                                   VmiCore::addr_t regionBase);
+
+        void insertImage(const ImageIdentity& imageIdentity,
+                         const RegionFingerprint& fingerprint,
+                         VmiCore::addr_t regionBase,
+                         const std::vector<Rule>& results);
+
+        /// Includes image hits.
+        [[nodiscard]] std::size_t getHitCount() const;
+
+        [[nodiscard]] std::size_t getImageHitCount() const;
+
+        [[nodiscard]] std::size_t getSkippedBytes() const;
+
+      private:
+        using Entry = std::pair<RegionFingerprint, std::vector<Rule>>;
+
+        /// Differently modified instances of the same image that are remembered at the same time.
+        static constexpr std::size_t maxImageVariants = 4;
+
+        std::size_t capacity;
+        SipHash128::Key key;
+        mutable std::mutex cacheLock;
+        /// Most recently used entries first.
+        std::list<Entry> entries;
+        std::unordered_map<RegionFingerprint, std::list<Entry>::iterator, RegionFingerprintHash> entryIndex;
+        /// Newest variant first. The number of images is limited by the capacity as well.
+        std::unordered_map<ImageIdentity, std::deque<Entry>, ImageIdentityHash> imageEntries;
+        std::size_t hitCount = 0;
+        std::size_t imageHitCount = 0;
+        std::size_t skippedBytes = 0;
+
+        static std::vector<Rule> rebaseResults(const std::vector<Rule>& results, int64_t offset);
+    };
+}
+
+#endif // INMEMORYSCANNER_SCANRESULTCACHE_H
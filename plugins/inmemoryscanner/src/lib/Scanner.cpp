@@ -1,18 +1,22 @@
 #include "Scanner.h"
 #include "Common.h"
 #include "Filenames.h"
+#include "ZeroPages.h"
 #include <algorithm>
+#include <chrono>
 #include <fmt/core.h>
-#include <future>
+#include <set>
+#include <tuple>
 #include <vmicore/callback.h>
 #include <vmicore/os/PagingDefinitions.h>
 
 using VmiCore::ActiveProcessInformation;
 using VmiCore::addr_t;
+using VmiCore::IMemoryMapping;
+using VmiCore::ITaskHandle;
 using VmiCore::MappedRegion;
 using VmiCore::MemoryRegion;
 using VmiCore::pid_t;
-using VmiCore::PagingDefinitions::pageSizeInBytes;
 using VmiCore::Plugin::PluginInterface;
 
 namespace InMemoryScanner
@@ -20,19 +24,39 @@ namespace InMemoryScanner
     Scanner::Scanner(PluginInterface* pluginInterface,
                      std::shared_ptr<IConfig> configuration,
                      std::unique_ptr<IYaraInterface> yaraInterface,
-                     std::unique_ptr<IDumping> dumping)
+                     std::unique_ptr<IDumping> dumping,
+                     std::shared_ptr<MemoryBudget> memoryBudget)
         : pluginInterface(pluginInterface),
           configuration(std::move(configuration)),
           yaraInterface(std::move(yaraInterface)),
+          resultsWriter(pluginInterface,
+                        (this->configuration->getOutputPath() / JSON_RESULT_FILENAME).string(),
+                        resultsFlushInterval),
           dumping(std::move(dumping)),
           logger(pluginInterface->newNamedLogger(INMEMORY_LOGGER_NAME)),
-          inMemResultsLogger(pluginInterface->newNamedLogger(INMEMORY_LOGGER_NAME))
+          inMemResultsLogger(pluginInterface->newNamedLogger(INMEMORY_LOGGER_NAME)),
+          memoryBudget(std::move(memoryBudget))
     {
         logger->bind({{VmiCore::WRITE_TO_FILE_TAG, LOG_FILENAME}});
         inMemResultsLogger->bind(
             {{VmiCore::WRITE_TO_FILE_TAG, (this->configuration->getOutputPath() / TEXT_RESULT_FILENAME).string()}});
 
-        pluginInterface->registerProcessTerminationEvent(VMICORE_SETUP_MEMBER_CALLBACK(scanProcess));
+        if (auto scanCacheSize = this->configuration->getScanCacheSize(); scanCacheSize > 0)
+        {
+            scanResultCache = std::make_unique<ScanResultCache>(scanCacheSize);
+        }
+        if (this->configuration->isRuleProfilingActivated())
+        {
+            scanProfiler = std::make_unique<ScanProfiler>(this->configuration->getSignatureFile().string());
+        }
+        if (this->configuration->isAsyncTerminationScanActivated())
+        {
+            asyncScanQueue = std::make_unique<AsyncScanQueue>(pluginInterface,
+                                                              this->configuration->getAsyncScanQueueSize(),
+                                                              this->configuration->getAsyncScanMemoryLimit());
+        }
+
+        pluginInterface->registerProcessTerminationEvent(VMICORE_SETUP_MEMBER_CALLBACK(scanTerminatedProcess));
     }
 
     std::unique_ptr<std::string> Scanner::getFilenameFromPath(const std::string& path)
@@ -46,6 +70,16 @@ namespace InMemoryScanner
         return filename;
     }
 
+    std::optional<ImageIdentity> Scanner::getImageIdentity(const MemoryRegion& memoryRegionDescriptor)
+    {
+        if (memoryRegionDescriptor.moduleName.empty() ||
+            !(memoryRegionDescriptor.isProcessBaseImage || memoryRegionDescriptor.isSharedMemory))
+        {
+            return std::nullopt;
+        }
+        return ImageIdentity{.moduleName = memoryRegionDescriptor.moduleName, .size = memoryRegionDescriptor.size};
+    }
+
     bool Scanner::shouldRegionBeScanned(const MemoryRegion& memoryRegionDescriptor)
     {
         if (configuration->isScanAllRegionsActivated())
@@ -60,44 +94,46 @@ namespace InMemoryScanner
         return true;
     }
 
-    std::vector<uint8_t> Scanner::constructPaddedMemoryRegion(std::span<const MappedRegion> regions)
+    std::unique_ptr<MemoryBudget::Reservation>
+    Scanner::reserveInFlightMemory(std::size_t bytes,
+                                   AdmissionPriority priority,
+                                   std::deque<std::shared_ptr<ITaskHandle>>& pendingRegionScans)
     {
-        std::vector<uint8_t> result;
-
-        if (regions.empty())
-        {
-            return result;
-        }
-
-        std::size_t regionSize = 0;
-        for (const auto& region : regions)
-        {
-            regionSize += region.asSpan().size();
-            regionSize += pageSizeInBytes;
-        }
-        // last region should not have succeeding padding page
-        regionSize -= pageSizeInBytes;
-
-        result.reserve(regionSize);
-        // copy first region
-        auto frontRegionSpan = regions.front().asSpan();
-        std::ranges::copy(frontRegionSpan.begin(), frontRegionSpan.end(), std::back_inserter(result));
+        return memoryBudget->acquire(bytes,
+                                    priority,
+                                    [this, &pendingRegionScans]()
+                                    {
+                                        if (pendingRegionScans.empty())
+                                        {
+                                            // The memory is held by scans of other processes, which might be waiting
+                                            // for a worker to run them
+                                            return pluginInterface->runPendingTask();
+                                        }
+                                        // Waiting on the own scans helps processing them if called from within the
+                                        // worker pool, whereas waiting on the scans of other processes could block
+                                        // all workers
+                                        pendingRegionScans.front()->wait();
+                                        pendingRegionScans.pop_front();
+                                        return true;
+                                    });
+    }
 
-        // copy the rest of the regions with a padding page in between each chunk
-        for (std::size_t i = 1; i < regions.size(); i++)
+    std::size_t Scanner::getMappedBytes(std::span<const MappedRegion> mappedRegions)
+    {
+        std::size_t mappedBytes = 0;
+        for (const auto& mappedRegion : mappedRegions)
         {
-            result.insert(result.end(), pageSizeInBytes, 0);
-            auto regionSpan = regions[i].asSpan();
-            std::ranges::copy(regionSpan.begin(), regionSpan.end(), std::back_inserter(result));
+            mappedBytes += mappedRegion.asSpan().size();
         }
-
-        return result;
+        return mappedBytes;
     }
 
-    void Scanner::scanMemoryRegion(pid_t pid,
-                                   addr_t dtb,
-                                   const std::string& processName,
-                                   const MemoryRegion& memoryRegionDescriptor)
+    void Scanner::submitMemoryRegionScan(pid_t pid,
+                                         addr_t dtb,
+                                         const std::string& processName,
+                                         const MemoryRegion& memoryRegionDescriptor,
+                                         AdmissionPriority priority,
+                                         std::deque<std::shared_ptr<ITaskHandle>>& pendingRegionScans)
     {
         logger->info("Scanning Memory region",
                      {{"VA", fmt::format("{:x}", memoryRegionDescriptor.base)},
@@ -108,10 +144,18 @@ namespace InMemoryScanner
         {
             return;
         }
+        if (isWindowedScan(memoryRegionDescriptor))
+        {
+            submitWindowedRegionScan(pid, dtb, processName, memoryRegionDescriptor, priority, pendingRegionScans);
+            return;
+        }
 
-        auto memoryMapping = pluginInterface->mapProcessMemoryRegion(
+        auto reservation = reserveInFlightMemory(memoryRegionDescriptor.size, priority, pendingRegionScans);
+        std::shared_ptr<IMemoryMapping> memoryMapping = pluginInterface->mapProcessMemoryRegion(
             memoryRegionDescriptor.base, dtb, bytesToNumberOfPages(memoryRegionDescriptor.size));
         auto mappedRegions = memoryMapping->getMappedRegions();
+        // Pages that could not be mapped do not occupy any host memory
+        reservation->shrink(getMappedBytes(mappedRegions));
 
         if (mappedRegions.empty())
         {
@@ -119,37 +163,388 @@ namespace InMemoryScanner
             return;
         }
 
+        // The mapping and its reservation are released as soon as the task has finished
+        pendingRegionScans.push_back(pluginInterface->submitTask(
+            [this,
+             pid,
+             &processName,
+             &memoryRegionDescriptor,
+             memoryMapping = std::move(memoryMapping),
+             mappedRegions,
+             reservation = std::shared_ptr<MemoryBudget::Reservation>(std::move(reservation))](const std::stop_token&)
+            {
+                handleRegionScanErrors(processName,
+                                       memoryRegionDescriptor,
+                                       [this, pid, &processName, &memoryRegionDescriptor, mappedRegions]()
+                                       { scanMappedRegions(pid, processName, memoryRegionDescriptor, mappedRegions); });
+            }));
+    }
+
+    void Scanner::scanMappedRegions(pid_t pid,
+                                    const std::string& processName,
+                                    const MemoryRegion& memoryRegionDescriptor,
+                                    std::span<const MappedRegion> mappedRegions)
+    {
         if (configuration->isDumpingMemoryActivated())
         {
             logger->debug("Start dumpVadRegionToFile", {{"Size", memoryRegionDescriptor.size}});
 
-            auto paddedRegion = constructPaddedMemoryRegion(mappedRegions);
+            dumping->dumpMemoryRegion(processName, pid, memoryRegionDescriptor, mappedRegions);
+        }
+
+        auto mappedBytes = getMappedBytes(mappedRegions);
+        totalMappedBytes += mappedBytes;
+
+        std::optional<RegionFingerprint> fingerprint;
+        std::optional<std::vector<Rule>> cachedResults;
+        auto imageIdentity = getImageIdentity(memoryRegionDescriptor);
+        if (scanResultCache)
+        {
+            fingerprint = scanResultCache->createFingerprint(memoryRegionDescriptor.base, mappedRegions);
+            cachedResults =
+                imageIdentity ? scanResultCache->lookupImage(*imageIdentity, *fingerprint, memoryRegionDescriptor.base)
+                              : scanResultCache->lookup(*fingerprint, memoryRegionDescriptor.base);
+        }
+
+        std::vector<Rule> results;
+        if (cachedResults)
+        {
+            logger->debug("Identical content has already been scanned, reusing results",
+                          {{"Size", memoryRegionDescriptor.size}});
+            results = std::move(*cachedResults);
+        }
+        else
+        {
+            results = scanNonZeroPages(pid, processName, memoryRegionDescriptor.base, mappedRegions, mappedBytes);
+
+            if (fingerprint && imageIdentity)
+            {
+                scanResultCache->insertImage(*imageIdentity, *fingerprint, memoryRegionDescriptor.base, results);
+            }
+            else if (fingerprint)
+            {
+                scanResultCache->insert(*fingerprint, memoryRegionDescriptor.base, results);
+            }
+        }
+
+        reportResults(processName, pid, memoryRegionDescriptor.base, results);
 
-            dumping->dumpMemoryRegion(processName, pid, memoryRegionDescriptor, paddedRegion);
+        if (!results.empty() && isDetectionDumpingActivated())
+        {
+            recordDetection(pid, memoryRegionDescriptor.base, true);
+            // The pages are still mapped or captured for the scan, so they do not have to be mapped again
+            dumping->dumpMemoryRegion(processName, pid, memoryRegionDescriptor, mappedRegions);
         }
+    }
 
-        logger->debug("Start scanMemory", {{"Size", memoryRegionDescriptor.size}});
+    bool Scanner::isWindowedScan(const MemoryRegion& memoryRegionDescriptor) const
+    {
+        auto scanWindowSize = configuration->getScanWindowSize();
+        return scanWindowSize > 0 && memoryRegionDescriptor.size > scanWindowSize &&
+               !configuration->isDumpingMemoryActivated();
+    }
 
-        // The semaphore protects the yara rules from being accessed more than YR_MAX_THREADS (32 atm.) times in
-        // parallel.
-        semaphore.acquire();
-        auto results = yaraInterface->scanMemory(mappedRegions);
-        semaphore.release();
+    std::vector<Scanner::ScanWindow> Scanner::getScanWindows(const MemoryRegion& memoryRegionDescriptor) const
+    {
+        auto scanWindowSize = configuration->getScanWindowSize();
+        auto windowStep = scanWindowSize - configuration->getScanWindowOverlap();
+        std::vector<ScanWindow> scanWindows;
+        for (std::size_t offset = 0; offset < memoryRegionDescriptor.size; offset += windowStep)
+        {
+            scanWindows.push_back({.base = memoryRegionDescriptor.base + offset,
+                                   .size = std::min(scanWindowSize, memoryRegionDescriptor.size - offset)});
+            if (offset + scanWindowSize >= memoryRegionDescriptor.size)
+            {
+                break;
+            }
+        }
+        logger->debug("Scanning memory region in windows",
+                      {{"VA", fmt::format("{:x}", memoryRegionDescriptor.base)}, {"Windows", scanWindows.size()}});
+        return scanWindows;
+    }
+
+    void Scanner::submitWindowedRegionScan(pid_t pid,
+                                           addr_t dtb,
+                                           const std::string& processName,
+                                           const MemoryRegion& memoryRegionDescriptor,
+                                           AdmissionPriority priority,
+                                           std::deque<std::shared_ptr<ITaskHandle>>& pendingRegionScans)
+    {
+        auto scanWindows = getScanWindows(memoryRegionDescriptor);
+        auto windowedRegionScan = std::make_shared<WindowedRegionScan>();
+        windowedRegionScan->windowResults.resize(scanWindows.size());
+        windowedRegionScan->pendingWindows = scanWindows.size();
+        for (std::size_t window = 0; window < scanWindows.size(); window++)
+        {
+            auto windowBase = scanWindows[window].base;
+            auto windowSize = scanWindows[window].size;
+            bool submitted = false;
+            handleRegionScanErrors(
+                processName,
+                memoryRegionDescriptor,
+                [&]()
+                {
+                    auto reservation = reserveInFlightMemory(windowSize, priority, pendingRegionScans);
+                    std::shared_ptr<IMemoryMapping> memoryMapping =
+                        pluginInterface->mapProcessMemoryRegion(windowBase, dtb, bytesToNumberOfPages(windowSize));
+                    auto mappedRegions = memoryMapping->getMappedRegions();
+                    reservation->shrink(getMappedBytes(mappedRegions));
+                    if (mappedRegions.empty())
+                    {
+                        return;
+                    }
+
+                    pendingRegionScans.push_back(pluginInterface->submitTask(
+                        [this,
+                         pid,
+                         &processName,
+                         &memoryRegionDescriptor,
+                         windowedRegionScan,
+                         window,
+                         windowBase,
+                         memoryMapping = std::move(memoryMapping),
+                         mappedRegions,
+                         reservation = std::shared_ptr<MemoryBudget::Reservation>(std::move(reservation))](
+                            const std::stop_token&)
+                        {
+                            scanWindow(pid,
+                                       processName,
+                                       memoryRegionDescriptor,
+                                       *windowedRegionScan,
+                                       window,
+                                       windowBase,
+                                       mappedRegions);
+                        }));
+                    submitted = true;
+                });
+            if (!submitted)
+            {
+                finishWindow(pid, processName, memoryRegionDescriptor, *windowedRegionScan);
+            }
+        }
+    }
+
+    void Scanner::scanWindow(pid_t pid,
+                             const std::string& processName,
+                             const MemoryRegion& memoryRegionDescriptor,
+                             WindowedRegionScan& windowedRegionScan,
+                             std::size_t window,
+                             addr_t windowBase,
+                             std::span<const MappedRegion> mappedRegions)
+    {
+        // A timeout only loses the matches of this window
+        handleRegionScanErrors(processName,
+                               memoryRegionDescriptor,
+                               [this, pid, &processName, &windowedRegionScan, window, windowBase, mappedRegions]()
+                               {
+                                   auto mappedBytes = getMappedBytes(mappedRegions);
+                                   totalMappedBytes += mappedBytes;
+                                   windowedRegionScan.windowResults[window] =
+                                       scanNonZeroPages(pid, processName, windowBase, mappedRegions, mappedBytes);
+                               });
+        finishWindow(pid, processName, memoryRegionDescriptor, windowedRegionScan);
+    }
+
+    void Scanner::finishWindow(pid_t pid,
+                               const std::string& processName,
+                               const MemoryRegion& memoryRegionDescriptor,
+                               WindowedRegionScan& windowedRegionScan)
+    {
+        // The decrement orders the results of all other windows before the merge
+        if (windowedRegionScan.pendingWindows.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+        handleRegionScanErrors(processName,
+                               memoryRegionDescriptor,
+                               [this, pid, &processName, &memoryRegionDescriptor, &windowedRegionScan]()
+                               {
+                                   auto results = mergeWindowResults(windowedRegionScan.windowResults);
+                                   reportResults(processName, pid, memoryRegionDescriptor.base, results);
+                                   if (!results.empty() && isDetectionDumpingActivated())
+                                   {
+                                       // No window covers the whole region, so it is dumped after the process scan
+                                       recordDetection(pid, memoryRegionDescriptor.base, false);
+                                   }
+                               });
+    }
+
+    std::vector<Rule> Scanner::mergeWindowResults(const std::vector<std::vector<Rule>>& windowResults)
+    {
+        std::vector<Rule> mergedResults;
+        std::set<std::tuple<std::string, std::string, std::string, int64_t>> reportedMatches;
+        for (const auto& results : windowResults)
+        {
+            for (const auto& rule : results)
+            {
+                auto mergedRule = std::ranges::find_if(
+                    mergedResults,
+                    [&rule](const Rule& mergedRule)
+                    { return mergedRule.ruleNamespace == rule.ruleNamespace && mergedRule.ruleName == rule.ruleName; });
+                if (mergedRule == mergedResults.end())
+                {
+                    mergedRule = mergedResults.insert(
+                        mergedResults.end(),
+                        Rule{.ruleName = rule.ruleName, .ruleNamespace = rule.ruleNamespace, .matches = {}});
+                }
+                // Positions are guest addresses, so identical matches of overlapping windows compare equal
+                for (const auto& match : rule.matches)
+                {
+                    if (reportedMatches.emplace(rule.ruleNamespace, rule.ruleName, match.matchName, match.position)
+                            .second)
+                    {
+                        mergedRule->matches.push_back(match);
+                    }
+                }
+            }
+        }
+        return mergedResults;
+    }
+
+    std::vector<Rule> Scanner::scanNonZeroPages(pid_t pid,
+                                                const std::string& processName,
+                                                addr_t base,
+                                                std::span<const MappedRegion> mappedRegions,
+                                                std::size_t mappedBytes)
+    {
+        // Zero pages cannot contain anything of interest apart from the ends of patterns reaching into them, so runs of
+        // them are left out like unmapped pages
+        auto scannedRuns = splitAtZeroPageRuns(mappedRegions);
+        auto scannedBytes = getMappedBytes(scannedRuns);
+        totalZeroBytes += mappedBytes - scannedBytes;
+
+        if (scannedRuns.empty())
+        {
+            return {};
+        }
+
+        logger->debug("Start scanMemory", {{"VA", fmt::format("{:x}", base)}, {"ScannedSize", scannedBytes}});
+
+        std::vector<Rule> results;
+        auto scanStart = std::chrono::steady_clock::now();
+        try
+        {
+            results = yaraInterface->scanMemory(scannedRuns);
+        }
+        catch (const YaraTimeoutException&)
+        {
+            if (scanProfiler)
+            {
+                scanProfiler->recordTimeout(
+                    processName, pid, base, scannedBytes, std::chrono::steady_clock::now() - scanStart);
+            }
+            throw;
+        }
+        if (scanProfiler)
+        {
+            scanProfiler->recordRegionScan(
+                processName, pid, base, scannedBytes, std::chrono::steady_clock::now() - scanStart, results);
+        }
+        totalScannedBytes += scannedBytes;
 
         logger->debug("End scanMemory");
 
-        if (!results.empty())
+        return results;
+    }
+
+    void Scanner::reportResults(const std::string& processName,
+                                pid_t pid,
+                                addr_t baseAddress,
+                                const std::vector<Rule>& results)
+    {
+        if (results.empty())
+        {
+            return;
+        }
+        for (const auto& result : results)
+        {
+            pluginInterface->sendInMemDetectionEvent(result.ruleName);
+        }
+        resultsWriter.addResult(processName, pid, baseAddress, results);
+        logInMemoryResultToTextFile(processName, pid, baseAddress, results);
+    }
+
+    bool Scanner::isDetectionDumpingActivated() const
+    {
+        // Dumping all memory includes the regions with detections
+        return configuration->getDetectionDumpScope() != DetectionDumpScope::None &&
+               !configuration->isDumpingMemoryActivated();
+    }
+
+    void Scanner::recordDetection(pid_t pid, addr_t base, bool isDumped)
+    {
+        std::scoped_lock guard(detectionDumpsLock);
+        auto& processDetectionDumps = detectionDumps[pid];
+        processDetectionDumps.detectedRegions.insert(base);
+        if (isDumped)
+        {
+            processDetectionDumps.dumpedRegions.insert(base);
+        }
+    }
+
+    bool Scanner::markDetectionDumped(pid_t pid, addr_t base)
+    {
+        std::scoped_lock guard(detectionDumpsLock);
+        auto processDetectionDumps = detectionDumps.find(pid);
+        if (processDetectionDumps == detectionDumps.end() ||
+            !processDetectionDumps->second.detectedRegions.contains(base))
         {
-            for (const auto& result : results)
+            return false;
+        }
+        return processDetectionDumps->second.dumpedRegions.insert(base).second;
+    }
+
+    void Scanner::dumpDetectionContext(pid_t pid,
+                                       const std::string& processName,
+                                       const std::vector<MemoryRegion>& memoryRegions,
+                                       const std::function<void(const MemoryRegion&)>& dumpRegion)
+    {
+        DetectionDumps processDetectionDumps;
+        {
+            std::scoped_lock guard(detectionDumpsLock);
+            auto detectionDumpsNode = detectionDumps.extract(pid);
+            if (detectionDumpsNode.empty())
+            {
+                return;
+            }
+            processDetectionDumps = std::move(detectionDumpsNode.mapped());
+        }
+
+        // Region lists are not necessarily ordered by address, e.g. the VAD tree is walked depth first
+        std::vector<const MemoryRegion*> regionsByAddress;
+        regionsByAddress.reserve(memoryRegions.size());
+        for (const auto& memoryRegionDescriptor : memoryRegions)
+        {
+            regionsByAddress.push_back(&memoryRegionDescriptor);
+        }
+        std::ranges::sort(regionsByAddress, {}, &MemoryRegion::base);
+
+        auto scope = configuration->getDetectionDumpScope();
+        const auto& detectedRegions = processDetectionDumps.detectedRegions;
+        for (std::size_t i = 0; i < regionsByAddress.size(); i++)
+        {
+            const auto& memoryRegionDescriptor = *regionsByAddress[i];
+            if (processDetectionDumps.dumpedRegions.contains(memoryRegionDescriptor.base))
+            {
+                continue;
+            }
+            bool isInScope =
+                detectedRegions.contains(memoryRegionDescriptor.base) || scope == DetectionDumpScope::Process ||
+                (scope == DetectionDumpScope::NeighbouringRegions &&
+                 ((i > 0 && detectedRegions.contains(regionsByAddress[i - 1]->base)) ||
+                  (i + 1 < regionsByAddress.size() && detectedRegions.contains(regionsByAddress[i + 1]->base))));
+            if (!isInScope || !shouldRegionBeScanned(memoryRegionDescriptor))
             {
-                pluginInterface->sendInMemDetectionEvent(result.ruleName);
+                continue;
             }
-            outputXml.addResult(processName, pid, memoryRegionDescriptor.base, results);
-            logInMemoryResultToTextFile(processName, pid, memoryRegionDescriptor.base, results);
+            handleRegionScanErrors(processName,
+                                   memoryRegionDescriptor,
+                                   [&dumpRegion, &memoryRegionDescriptor]() { dumpRegion(memoryRegionDescriptor); });
         }
     }
 
-    void Scanner::scanProcess(std::shared_ptr<const ActiveProcessInformation> processInformation)
+    void Scanner::scanProcess(std::shared_ptr<const ActiveProcessInformation> processInformation,
+                              AdmissionPriority priority)
     {
         if (processInformation->pid == 0)
         {
@@ -166,30 +561,43 @@ namespace InMemoryScanner
                          {{"Pid", processInformation->pid}, {"Name", *processInformation->fullName}});
             try
             {
-                auto memoryRegions = processInformation->memoryRegionExtractor->extractAllMemoryRegions();
+                auto memoryRegions = processInformation->memoryRegionExtractor->getMemoryRegions();
 
+                // Regions are mapped one after another on this thread while the worker pool scans and dumps the
+                // previously mapped ones. Submission errors are handled per region, so pending scans are always
+                // waited for before the referenced region descriptors go out of scope.
+                std::deque<std::shared_ptr<ITaskHandle>> pendingRegionScans;
                 for (const auto& memoryRegionDescriptor : *memoryRegions)
                 {
-                    try
-                    {
-                        scanMemoryRegion(processInformation->pid,
-                                         processInformation->processUserDtb,
-                                         *processInformation->fullName,
-                                         memoryRegionDescriptor);
-                    }
-                    catch (const YaraTimeoutException&)
-                    {
-                        logger->warning("Scan timeout reached",
-                                        {{"Process", *processInformation->fullName},
-                                         {"BaseVA", memoryRegionDescriptor.base},
-                                         {"Size", memoryRegionDescriptor.size}});
-                    }
-                    catch (const std::exception& exc)
-                    {
-                        logger->error("Error scanning memory region of process",
-                                      {{"Name", *processInformation->fullName}, {"Exception", exc.what()}});
-                        pluginInterface->sendErrorEvent(exc.what());
-                    }
+                    handleRegionScanErrors(*processInformation->fullName,
+                                           memoryRegionDescriptor,
+                                           [this,
+                                            &processInformation,
+                                            &memoryRegionDescriptor,
+                                            priority,
+                                            &pendingRegionScans]()
+                                           {
+                                               submitMemoryRegionScan(processInformation->pid,
+                                                                      processInformation->processUserDtb,
+                                                                      *processInformation->fullName,
+                                                                      memoryRegionDescriptor,
+                                                                      priority,
+                                                                      pendingRegionScans);
+                                           });
+                }
+                for (const auto& pendingRegionScan : pendingRegionScans)
+                {
+                    pendingRegionScan->wait();
+                }
+
+                if (isDetectionDumpingActivated())
+                {
+                    dumpDetectionContext(
+                        processInformation->pid,
+                        *processInformation->fullName,
+                        *memoryRegions,
+                        [this, &processInformation, priority](const MemoryRegion& memoryRegionDescriptor)
+                        { mapAndDumpMemoryRegion(*processInformation, memoryRegionDescriptor, priority); });
                 }
             }
             catch (const std::exception& exc)
@@ -203,39 +611,448 @@ namespace InMemoryScanner
         }
     }
 
+    void Scanner::mapAndDumpMemoryRegion(const ActiveProcessInformation& processInformation,
+                                         const MemoryRegion& memoryRegionDescriptor,
+                                         AdmissionPriority priority)
+    {
+        auto reservation = memoryBudget->acquire(
+            memoryRegionDescriptor.size, priority, [this]() { return pluginInterface->runPendingTask(); });
+        auto memoryMapping = pluginInterface->mapProcessMemoryRegion(memoryRegionDescriptor.base,
+                                                                     processInformation.processUserDtb,
+                                                                     bytesToNumberOfPages(memoryRegionDescriptor.size));
+        auto mappedRegions = memoryMapping->getMappedRegions();
+        reservation->shrink(getMappedBytes(mappedRegions));
+        if (mappedRegions.empty())
+        {
+            return;
+        }
+        dumping->dumpMemoryRegion(
+            *processInformation.fullName, processInformation.pid, memoryRegionDescriptor, mappedRegions);
+    }
+
+    void Scanner::scanTerminatedProcess(std::shared_ptr<const ActiveProcessInformation> processInformation)
+    {
+        // The guest is paused until the process has been scanned or captured
+        if (!asyncScanQueue || processInformation->pid == 0 ||
+            configuration->isProcessIgnored(*processInformation->fullName))
+        {
+            scanProcess(std::move(processInformation), AdmissionPriority::Urgent);
+            return;
+        }
+        if (asyncScanQueue->isFull())
+        {
+            logger->warning("Asynchronous scan queue is full, scanning synchronously",
+                            {{"Pid", processInformation->pid}, {"Name", *processInformation->fullName}});
+            scanProcess(std::move(processInformation), AdmissionPriority::Urgent);
+            return;
+        }
+
+        logger->info("Capturing process", {{"Pid", processInformation->pid}, {"Name", *processInformation->fullName}});
+        std::shared_ptr<CapturedProcess> capturedProcess;
+        try
+        {
+            capturedProcess = captureProcess(*processInformation);
+        }
+        catch (const std::exception& exc)
+        {
+            logger->error("Error scanning process",
+                          {{"Name", *processInformation->fullName}, {"Exception", exc.what()}});
+            pluginInterface->sendErrorEvent(exc.what());
+            return;
+        }
+        auto capturedBytes = capturedProcess->capturedBytes;
+        asyncScanQueue->enqueue(capturedBytes,
+                                [this, capturedProcess = std::move(capturedProcess)]()
+                                { scanCapturedProcess(*capturedProcess); });
+    }
+
+    std::unique_ptr<Scanner::CapturedProcess>
+    Scanner::captureProcess(const ActiveProcessInformation& processInformation)
+    {
+        auto capturedProcess = std::make_unique<CapturedProcess>(CapturedProcess{
+            .pid = processInformation.pid,
+            .processName = *processInformation.fullName,
+            .memoryRegions = processInformation.memoryRegionExtractor->getMemoryRegions(),
+            .capturedRegions = {},
+            .capturedBytes = 0});
+
+        for (const auto& memoryRegionDescriptor : *capturedProcess->memoryRegions)
+        {
+            handleRegionScanErrors(
+                capturedProcess->processName,
+                memoryRegionDescriptor,
+                [this, &processInformation, &capturedProcess, &memoryRegionDescriptor]()
+                {
+                    if (!shouldRegionBeScanned(memoryRegionDescriptor))
+                    {
+                        return;
+                    }
+                    if (isWindowedScan(memoryRegionDescriptor))
+                    {
+                        captureWindowedRegion(processInformation, memoryRegionDescriptor, *capturedProcess);
+                        return;
+                    }
+
+                    // Charges the mapping until it has been copied or scanned synchronously
+                    auto mappingReservation = reserveCaptureMapping(memoryRegionDescriptor.size, *capturedProcess);
+                    auto memoryMapping = pluginInterface->mapProcessMemoryRegion(
+                        memoryRegionDescriptor.base,
+                        processInformation.processUserDtb,
+                        bytesToNumberOfPages(memoryRegionDescriptor.size));
+                    auto mappedRegions = memoryMapping->getMappedRegions();
+                    auto mappedBytes = getMappedBytes(mappedRegions);
+                    mappingReservation->shrink(mappedBytes);
+                    if (mappedBytes == 0)
+                    {
+                        return;
+                    }
+
+                    auto capturedRegion = tryCaptureMappedRegions(memoryRegionDescriptor, mappedRegions, mappedBytes);
+                    if (!capturedRegion)
+                    {
+                        logger->debug("Asynchronous scan memory limit reached, scanning region synchronously",
+                                      {{"VA", fmt::format("{:x}", memoryRegionDescriptor.base)},
+                                       {"Size", memoryRegionDescriptor.size}});
+                        scanMappedRegions(
+                            capturedProcess->pid, capturedProcess->processName, memoryRegionDescriptor, mappedRegions);
+                        return;
+                    }
+                    capturedProcess->capturedRegions.push_back(std::move(*capturedRegion));
+                    capturedProcess->capturedBytes += mappedBytes;
+                });
+        }
+
+        return capturedProcess;
+    }
+
+    void Scanner::captureWindowedRegion(const ActiveProcessInformation& processInformation,
+                                        const MemoryRegion& memoryRegionDescriptor,
+                                        CapturedProcess& capturedProcess)
+    {
+        auto scanWindows = getScanWindows(memoryRegionDescriptor);
+        auto windowedRegionScan = std::make_shared<WindowedRegionScan>();
+        windowedRegionScan->windowResults.resize(scanWindows.size());
+        windowedRegionScan->pendingWindows = scanWindows.size();
+        bool isCaptureAborted = false;
+        for (std::size_t window = 0; window < scanWindows.size() && !isCaptureAborted; window++)
+        {
+            auto windowBase = scanWindows[window].base;
+            auto windowSize = scanWindows[window].size;
+            bool isHandedOver = false;
+            handleRegionScanErrors(
+                capturedProcess.processName,
+                memoryRegionDescriptor,
+                [&]()
+                {
+                    auto mappingReservation = reserveCaptureMapping(windowSize, capturedProcess);
+                    auto memoryMapping = pluginInterface->mapProcessMemoryRegion(
+                        windowBase, processInformation.processUserDtb, bytesToNumberOfPages(windowSize));
+                    auto mappedRegions = memoryMapping->getMappedRegions();
+                    auto mappedBytes = getMappedBytes(mappedRegions);
+                    mappingReservation->shrink(mappedBytes);
+                    if (mappedBytes == 0)
+                    {
+                        return;
+                    }
+
+                    auto capturedRegion = tryCaptureMappedRegions(memoryRegionDescriptor, mappedRegions, mappedBytes);
+                    if (!capturedRegion && isDetectionDumpingActivated())
+                    {
+                        isCaptureAborted = true;
+                        isHandedOver = true;
+                        return;
+                    }
+                    if (!capturedRegion)
+                    {
+                        logger->debug("Asynchronous scan memory limit reached, scanning window synchronously",
+                                      {{"VA", fmt::format("{:x}", windowBase)}, {"Size", windowSize}});
+                        isHandedOver = true;
+                        scanWindow(capturedProcess.pid,
+                                   capturedProcess.processName,
+                                   memoryRegionDescriptor,
+                                   *windowedRegionScan,
+                                   window,
+                                   windowBase,
+                                   mappedRegions);
+                        return;
+                    }
+                    capturedRegion->windowedRegionScan = windowedRegionScan;
+                    capturedRegion->window = window;
+                    capturedRegion->windowBase = windowBase;
+                    capturedProcess.capturedRegions.push_back(std::move(*capturedRegion));
+                    capturedProcess.capturedBytes += mappedBytes;
+                    isHandedOver = true;
+                });
+            if (!isHandedOver)
+            {
+                finishWindow(
+                    capturedProcess.pid, capturedProcess.processName, memoryRegionDescriptor, *windowedRegionScan);
+            }
+        }
+        if (!isCaptureAborted)
+        {
+            return;
+        }
+
+        // The windows captured so far are dropped together with their scan state, which never reports any results
+        for (const auto& capturedRegion : capturedProcess.capturedRegions)
+        {
+            if (capturedRegion.windowedRegionScan == windowedRegionScan)
+            {
+                asyncScanQueue->releaseBytes(capturedRegion.pages.size());
+                capturedProcess.capturedBytes -= capturedRegion.pages.size();
+            }
+        }
+        std::erase_if(capturedProcess.capturedRegions,
+                      [&windowedRegionScan](const CapturedMemoryRegion& capturedRegion)
+                      { return capturedRegion.windowedRegionScan == windowedRegionScan; });
+
+        logger->debug(
+            "Asynchronous scan memory limit reached, scanning region synchronously",
+            {{"VA", fmt::format("{:x}", memoryRegionDescriptor.base)}, {"Size", memoryRegionDescriptor.size}});
+        std::deque<std::shared_ptr<ITaskHandle>> pendingWindowScans;
+        submitWindowedRegionScan(capturedProcess.pid,
+                                 processInformation.processUserDtb,
+                                 capturedProcess.processName,
+                                 memoryRegionDescriptor,
+                                 AdmissionPriority::Urgent,
+                                 pendingWindowScans);
+        for (const auto& pendingWindowScan : pendingWindowScans)
+        {
+            pendingWindowScan->wait();
+        }
+        // The memory of the process is still accessible, but not anymore once its captured regions are scanned
+        if (markDetectionDumped(capturedProcess.pid, memoryRegionDescriptor.base))
+        {
+            mapAndDumpMemoryRegion(processInformation, memoryRegionDescriptor, AdmissionPriority::Urgent);
+        }
+    }
+
+    std::unique_ptr<MemoryBudget::Reservation> Scanner::reserveCaptureMapping(std::size_t bytes,
+                                                                              const CapturedProcess& capturedProcess)
+    {
+        return memoryBudget->acquire(
+            bytes,
+            AdmissionPriority::Urgent,
+            [this]() { return pluginInterface->runPendingTask(); },
+            capturedProcess.capturedBytes);
+    }
+
+    std::optional<Scanner::CapturedMemoryRegion>
+    Scanner::tryCaptureMappedRegions(const MemoryRegion& memoryRegionDescriptor,
+                                     std::span<const MappedRegion> mappedRegions,
+                                     std::size_t mappedBytes)
+    {
+        // Accounts for the captured copy only, the mapping it is copied from is charged by the caller
+        auto reservation = memoryBudget->tryAcquire(mappedBytes, AdmissionPriority::Urgent);
+        if (!reservation || !asyncScanQueue->tryReserveBytes(mappedBytes))
+        {
+            return std::nullopt;
+        }
+
+        try
+        {
+            CapturedMemoryRegion capturedRegion{.memoryRegionDescriptor = &memoryRegionDescriptor,
+                                                .pages = {},
+                                                .mappedRegions = {},
+                                                .reservation = std::move(reservation),
+                                                .windowedRegionScan = nullptr,
+                                                .window = 0,
+                                                .windowBase = 0};
+            capturedRegion.pages.reserve(mappedBytes);
+            capturedRegion.mappedRegions.reserve(mappedRegions.size());
+            for (const auto& mappedRegion : mappedRegions)
+            {
+                auto mappedSpan = mappedRegion.asSpan();
+                capturedRegion.pages.insert(capturedRegion.pages.end(), mappedSpan.begin(), mappedSpan.end());
+            }
+            // The pages buffer does not reallocate anymore, so spans into it remain valid
+            auto* pagesCursor = capturedRegion.pages.data();
+            for (const auto& mappedRegion : mappedRegions)
+            {
+                capturedRegion.mappedRegions.emplace_back(
+                    mappedRegion.guestBaseVA, std::span<uint8_t>(pagesCursor, mappedRegion.asSpan().size()));
+                pagesCursor += mappedRegion.asSpan().size();
+            }
+            return capturedRegion;
+        }
+        catch (...)
+        {
+            asyncScanQueue->releaseBytes(mappedBytes);
+            throw;
+        }
+    }
+
+    void Scanner::scanCapturedProcess(const CapturedProcess& capturedProcess)
+    {
+        logger->info("Scanning captured process",
+                     {{"Pid", capturedProcess.pid}, {"Name", capturedProcess.processName}});
+        for (const auto& capturedRegion : capturedProcess.capturedRegions)
+        {
+            const auto& memoryRegionDescriptor = *capturedRegion.memoryRegionDescriptor;
+            if (capturedRegion.windowedRegionScan)
+            {
+                scanWindow(capturedProcess.pid,
+                           capturedProcess.processName,
+                           memoryRegionDescriptor,
+                           *capturedRegion.windowedRegionScan,
+                           capturedRegion.window,
+                           capturedRegion.windowBase,
+                           capturedRegion.mappedRegions);
+                continue;
+            }
+            handleRegionScanErrors(capturedProcess.processName,
+                                   memoryRegionDescriptor,
+                                   [this, &capturedProcess, &capturedRegion, &memoryRegionDescriptor]()
+                                   {
+                                       logger->info("Scanning Memory region",
+                                                    {{"VA", fmt::format("{:x}", memoryRegionDescriptor.base)},
+                                                     {"Size", memoryRegionDescriptor.size},
+                                                     {"Module", memoryRegionDescriptor.moduleName}});
+                                       scanMappedRegions(capturedProcess.pid,
+                                                         capturedProcess.processName,
+                                                         memoryRegionDescriptor,
+                                                         capturedRegion.mappedRegions);
+                                   });
+        }
+        if (isDetectionDumpingActivated())
+        {
+            // The process has terminated, so only regions that have been captured are available for dumping
+            dumpDetectionContext(capturedProcess.pid,
+                                 capturedProcess.processName,
+                                 *capturedProcess.memoryRegions,
+                                 [this, &capturedProcess](const MemoryRegion& memoryRegionDescriptor)
+                                 {
+                                     auto mappedRegions =
+                                         getCapturedMappedRegions(capturedProcess, memoryRegionDescriptor);
+                                     if (mappedRegions.empty())
+                                     {
+                                         logger->debug("Region has not been captured, skipping dump",
+                                                       {{"VA", fmt::format("{:x}", memoryRegionDescriptor.base)}});
+                                         return;
+                                     }
+                                     dumping->dumpMemoryRegion(capturedProcess.processName,
+                                                               capturedProcess.pid,
+                                                               memoryRegionDescriptor,
+                                                               mappedRegions);
+                                 });
+        }
+        logger->info("Done scanning captured process",
+                     {{"Pid", capturedProcess.pid}, {"Name", capturedProcess.processName}});
+    }
+
+    std::vector<MappedRegion> Scanner::getCapturedMappedRegions(const CapturedProcess& capturedProcess,
+                                                                const MemoryRegion& memoryRegionDescriptor)
+    {
+        std::vector<MappedRegion> mappedRegions;
+        // Windows are captured in ascending order, so every page not covered yet starts behind the previous ones
+        addr_t coveredEnd = memoryRegionDescriptor.base;
+        for (const auto& capturedRegion : capturedProcess.capturedRegions)
+        {
+            if (capturedRegion.memoryRegionDescriptor != &memoryRegionDescriptor)
+            {
+                continue;
+            }
+            if (!capturedRegion.windowedRegionScan)
+            {
+                return capturedRegion.mappedRegions;
+            }
+            for (const auto& mappedRegion : capturedRegion.mappedRegions)
+            {
+                auto mappedSpan = mappedRegion.asSpan();
+                auto mappedEnd = mappedRegion.guestBaseVA + mappedSpan.size();
+                if (mappedEnd <= coveredEnd)
+                {
+                    continue;
+                }
+                auto skippedBytes = coveredEnd > mappedRegion.guestBaseVA ? coveredEnd - mappedRegion.guestBaseVA : 0;
+                mappedRegions.emplace_back(mappedRegion.guestBaseVA + skippedBytes,
+                                           bytesToNumberOfPages(mappedSpan.size() - skippedBytes),
+                                           static_cast<uint8_t*>(mappedRegion.mappingBase) + skippedBytes);
+                coveredEnd = mappedEnd;
+            }
+        }
+        return mappedRegions;
+    }
+
+    void Scanner::finishPendingScans()
+    {
+        if (asyncScanQueue)
+        {
+            asyncScanQueue->drain();
+        }
+    }
+
+    void Scanner::handleRegionScanErrors(const std::string& processName,
+                                         const MemoryRegion& memoryRegionDescriptor,
+                                         const std::function<void()>& scanFunction)
+    {
+        try
+        {
+            scanFunction();
+        }
+        catch (const YaraTimeoutException&)
+        {
+            logger->warning("Scan timeout reached",
+                            {{"Process", processName},
+                             {"BaseVA", memoryRegionDescriptor.base},
+                             {"Size", memoryRegionDescriptor.size}});
+        }
+        catch (const std::exception& exc)
+        {
+            logger->error("Error scanning memory region of process",
+                          {{"Name", processName}, {"Exception", exc.what()}});
+            pluginInterface->sendErrorEvent(exc.what());
+        }
+    }
+
     void Scanner::scanAllProcesses()
     {
         auto processes = pluginInterface->getRunningProcesses();
-        std::vector<std::future<void>> scanProcessAsyncTasks;
+        std::vector<std::shared_ptr<VmiCore::ITaskHandle>> scanProcessTasks;
         for (const auto& process : *processes)
         {
             if (process->pid != 0)
             {
-                scanProcessAsyncTasks.push_back(std::async(&Scanner::scanProcess, this, process));
+                scanProcessTasks.push_back(
+                    pluginInterface->submitTask([this, process](const std::stop_token&) { scanProcess(process); }));
             }
         }
-        for (auto& currentTask : scanProcessAsyncTasks)
+        for (const auto& currentTask : scanProcessTasks)
+        {
+            currentTask->wait();
+        }
+        if (scanResultCache)
         {
-            currentTask.get();
+            logger->info("Deduplicated region scans",
+                         {{"Regions", scanResultCache->getHitCount()},
+                          {"Images", scanResultCache->getImageHitCount()},
+                          {"Bytes", scanResultCache->getSkippedBytes()}});
         }
+        logger->info("Scan coverage",
+                     {{"MappedBytes", totalMappedBytes.load()},
+                      {"ScannedBytes", totalScannedBytes.load()},
+                      {"ZeroBytes", totalZeroBytes.load()}});
+        auto budgetStatistics = memoryBudget->getStatistics();
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+        logger->info("Memory budget",
+                     {{"Admissions", budgetStatistics.admissions},
+                      {"DelayedAdmissions", budgetStatistics.delayedAdmissions},
+                      {"OvercommittedAdmissions", budgetStatistics.overcommittedAdmissions},
+                      {"RejectedRequests", budgetStatistics.rejectedRequests},
+                      {"TotalWaitMs", Milliseconds(budgetStatistics.totalWaitTime).count()},
+                      {"MaxWaitMs", Milliseconds(budgetStatistics.maxWaitTime).count()},
+                      {"PeakBytes", budgetStatistics.peakBytes}});
     }
 
     void Scanner::saveOutput()
     {
-        if (configuration->isDumpingMemoryActivated())
+        resultsWriter.flush();
+        if (scanProfiler)
         {
-            auto memoryRegionInformation = dumping->getAllMemoryRegionInformation();
-            std::ostringstream vts;
-
-            if (!memoryRegionInformation.empty())
-            {
-                std::copy(memoryRegionInformation.begin(),
-                          memoryRegionInformation.end(),
-                          std::ostream_iterator<std::string>(vts, "\n"));
-            }
-            pluginInterface->writeToFile(configuration->getOutputPath() /= "MemoryRegionInformation.json", vts.str());
+            pluginInterface->writeToFile(configuration->getOutputPath() /= PROFILE_REPORT_FILENAME,
+                                         scanProfiler->createReport(yaraInterface->getRuleCosts()));
         }
-        pluginInterface->writeToFile(configuration->getOutputPath() /= XML_RESULT_FILENAME, *outputXml.getString());
     }
 
     void Scanner::logInMemoryResultToTextFile(const std::string& processName,
@@ -1,14 +1,24 @@
 #pragma once
 
+#include "AsyncScanQueue.h"
 #include "Config.h"
 #include "Dumping.h"
 #include "IYaraInterface.h"
-#include "OutputXML.h"
+#include "MemoryBudget.h"
+#include "ResultsWriter.h"
+#include "ScanProfiler.h"
+#include "ScanResultCache.h"
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
 #include <memory>
-#include <semaphore>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <span>
 #include <vmicore/plugins/PluginInterface.h>
-#include <yara/limits.h> // NOLINT(modernize-deprecated-headers)
 
 namespace InMemoryScanner
 {
@@ -18,34 +28,244 @@ namespace InMemoryScanner
         Scanner(VmiCore::Plugin::PluginInterface* pluginInterface,
                 std::shared_ptr<IConfig> configuration,
                 std::unique_ptr<IYaraInterface> yaraInterface,
-                std::unique_ptr<IDumping> dumping);
+                std::unique_ptr<IDumping> dumping,
+                std::shared_ptr<MemoryBudget> memoryBudget);
 
         [[nodiscard]] static std::unique_ptr<std::string> getFilenameFromPath(const std::string& path);
 
-        void scanProcess(std::shared_ptr<const VmiCore::ActiveProcessInformation> processInformation);
+        void scanProcess(std::shared_ptr<const VmiCore::ActiveProcessInformation> processInformation,
+                         AdmissionPriority priority = AdmissionPriority::Normal);
+
+        /**
+         * Scans a process upon its termination. If asynchronous termination scans are activated, the memory of the
+         * process is only captured while the guest is paused and scanned in the background afterwards.
+         */
+        void scanTerminatedProcess(std::shared_ptr<const VmiCore::ActiveProcessInformation> processInformation);
+
+        /// Blocks until all asynchronous termination scans have finished.
+        void finishPendingScans();
 
         void scanAllProcesses();
 
         void saveOutput();
 
       private:
+        /// Results of the windows of a single memory region, which are reported together after the last window.
+        struct WindowedRegionScan
+        {
+            std::vector<std::vector<Rule>> windowResults;
+            std::atomic<std::size_t> pendingWindows;
+        };
+
+        /// Host copy of the mapped pages of a memory region or of a single window of it.
+        struct CapturedMemoryRegion
+        {
+            const VmiCore::MemoryRegion* memoryRegionDescriptor = nullptr;
+            std::vector<uint8_t> pages;
+            /// Refer to the pages buffer, guest addresses are retained.
+            std::vector<VmiCore::MappedRegion> mappedRegions;
+            std::unique_ptr<MemoryBudget::Reservation> reservation;
+            /// Only set for windows, which share the scan state of their region.
+            std::shared_ptr<WindowedRegionScan> windowedRegionScan;
+            std::size_t window = 0;
+            VmiCore::addr_t windowBase = 0;
+        };
+
+        struct CapturedProcess
+        {
+            pid_t pid = 0;
+            std::string processName;
+            /// Keeps the descriptors alive that captured regions refer to.
+            std::shared_ptr<const std::vector<VmiCore::MemoryRegion>> memoryRegions;
+            std::vector<CapturedMemoryRegion> capturedRegions;
+            std::size_t capturedBytes = 0;
+        };
+
+
+        /// Regions of a single process by base address, which determine what to dump once the process is scanned.
+        struct DetectionDumps
+        {
+            std::set<VmiCore::addr_t> detectedRegions;
+            std::set<VmiCore::addr_t> dumpedRegions;
+        };
+
+        struct ScanWindow
+        {
+            VmiCore::addr_t base;
+            std::size_t size;
+        };
+
+        static constexpr std::chrono::seconds resultsFlushInterval{1};
+
         VmiCore::Plugin::PluginInterface* pluginInterface;
         std::shared_ptr<IConfig> configuration;
         std::unique_ptr<IYaraInterface> yaraInterface;
-        OutputXML outputXml{};
+        ResultsWriter resultsWriter;
         std::unique_ptr<IDumping> dumping;
         std::unique_ptr<VmiCore::ILogger> logger;
         std::unique_ptr<VmiCore::ILogger> inMemResultsLogger;
-        std::counting_semaphore<> semaphore{YR_MAX_THREADS};
+        std::unique_ptr<ScanResultCache> scanResultCache;
+        std::unique_ptr<ScanProfiler> scanProfiler;
+        /// Coverage statistics. Mapped bytes that are neither scanned nor zero have been deduplicated.
+        std::atomic<std::size_t> totalMappedBytes = 0;
+        std::atomic<std::size_t> totalScannedBytes = 0;
+        std::atomic<std::size_t> totalZeroBytes = 0;
+        std::mutex detectionDumpsLock;
+        std::map<pid_t, DetectionDumps> detectionDumps;
+        /// Shared by mapped regions of pending scans, captured regions of terminated processes and dump compression.
+        std::shared_ptr<MemoryBudget> memoryBudget;
+        // Declared last so that pending scans are finished before any of the members they use are destroyed
+        std::unique_ptr<AsyncScanQueue> asyncScanQueue;
 
         [[nodiscard]] bool shouldRegionBeScanned(const VmiCore::MemoryRegion& memoryRegionDescriptor);
 
-        static std::vector<uint8_t> constructPaddedMemoryRegion(std::span<const VmiCore::MappedRegion> regions);
+        /// Returns the identity of file backed regions that are shared between processes.
+        [[nodiscard]] static std::optional<ImageIdentity>
+        getImageIdentity(const VmiCore::MemoryRegion& memoryRegionDescriptor);
+
+        /**
+         * Blocks until the given amount of memory fits into the memory budget. While waiting, the pending scans of the
+         * calling process are completed one after another. Afterwards, other pending tasks of the worker pool are run
+         * if called from within it.
+         */
+        [[nodiscard]] std::unique_ptr<MemoryBudget::Reservation>
+        reserveInFlightMemory(std::size_t bytes,
+                              AdmissionPriority priority,
+                              std::deque<std::shared_ptr<VmiCore::ITaskHandle>>& pendingRegionScans);
+
+        /// Host memory occupied by the given mapped regions, which may be less than the size of the mapped range.
+        [[nodiscard]] static std::size_t getMappedBytes(std::span<const VmiCore::MappedRegion> mappedRegions);
+
+        /// Maps the given region and submits its scan to the worker pool. The task is appended to the pending scans.
+        void submitMemoryRegionScan(pid_t pid,
+                                    uint64_t dtb,
+                                    const std::string& processName,
+                                    const VmiCore::MemoryRegion& memoryRegionDescriptor,
+                                    AdmissionPriority priority,
+                                    std::deque<std::shared_ptr<VmiCore::ITaskHandle>>& pendingRegionScans);
+
+        void scanMappedRegions(pid_t pid,
+                               const std::string& processName,
+                               const VmiCore::MemoryRegion& memoryRegionDescriptor,
+                               std::span<const VmiCore::MappedRegion> mappedRegions);
+
+        /// Regions exceeding the scan window size are scanned in windows, unless they have to be dumped as a whole.
+        [[nodiscard]] bool isWindowedScan(const VmiCore::MemoryRegion& memoryRegionDescriptor) const;
+
+        /// Splits a region into windows of the configured size, which overlap by the configured amount.
+        [[nodiscard]] std::vector<ScanWindow> getScanWindows(const VmiCore::MemoryRegion& memoryRegionDescriptor) const;
+
+        /**
+         * Maps the windows of the given region one after another and submits their scans to the worker pool. A failed
+         * or timed out window does not affect the others. The merged results are reported by the last window.
+         */
+        void submitWindowedRegionScan(pid_t pid,
+                                      uint64_t dtb,
+                                      const std::string& processName,
+                                      const VmiCore::MemoryRegion& memoryRegionDescriptor,
+                                      AdmissionPriority priority,
+                                      std::deque<std::shared_ptr<VmiCore::ITaskHandle>>& pendingRegionScans);
+
+        /// Scans a single window, which finishes the windowed scan of the region if it is the last one.
+        void scanWindow(pid_t pid,
+                        const std::string& processName,
+                        const VmiCore::MemoryRegion& memoryRegionDescriptor,
+                        WindowedRegionScan& windowedRegionScan,
+                        std::size_t window,
+                        VmiCore::addr_t windowBase,
+                        std::span<const VmiCore::MappedRegion> mappedRegions);
+
+        void finishWindow(pid_t pid,
+                          const std::string& processName,
+                          const VmiCore::MemoryRegion& memoryRegionDescriptor,
+                          WindowedRegionScan& windowedRegionScan);
+
+        /// Matches within the overlap of two windows are found twice, but only reported once.
+        [[nodiscard]] static std::vector<Rule> mergeWindowResults(const std::vector<std::vector<Rule>>& windowResults);
+
+        /// Scans the given mapped regions without the runs of zero pages within them.
+        [[nodiscard]] std::vector<Rule> scanNonZeroPages(pid_t pid,
+                                                         const std::string& processName,
+                                                         VmiCore::addr_t base,
+                                                         std::span<const VmiCore::MappedRegion> mappedRegions,
+                                                         std::size_t mappedBytes);
+
+        void reportResults(const std::string& processName,
+                           VmiCore::pid_t pid,
+                           VmiCore::addr_t baseAddress,
+                           const std::vector<Rule>& results);
+
+        [[nodiscard]] bool isDetectionDumpingActivated() const;
+
+        void recordDetection(pid_t pid, VmiCore::addr_t base, bool isDumped);
+
+        /// Marks a detected region as dumped. Returns false if it has not been detected or has been dumped already.
+        [[nodiscard]] bool markDetectionDumped(pid_t pid, VmiCore::addr_t base);
+
+        /**
+         * Dumps the regions within the configured detection dump scope that have not been dumped together with their
+         * scan already. Regions are looked up in the given list of all regions of the process and dumped via
+         * dumpRegion.
+         */
+        void dumpDetectionContext(pid_t pid,
+                                  const std::string& processName,
+                                  const std::vector<VmiCore::MemoryRegion>& memoryRegions,
+                                  const std::function<void(const VmiCore::MemoryRegion&)>& dumpRegion);
+
+        /// Maps a region of a live process again in order to dump it.
+        void mapAndDumpMemoryRegion(const VmiCore::ActiveProcessInformation& processInformation,
+                                    const VmiCore::MemoryRegion& memoryRegionDescriptor,
+                                    AdmissionPriority priority);
+
+        /// Runs the given scan of a single memory region and reports its errors instead of propagating them.
+        void handleRegionScanErrors(const std::string& processName,
+                                    const VmiCore::MemoryRegion& memoryRegionDescriptor,
+                                    const std::function<void()>& scanFunction);
+
+        /**
+         * Copies the scannable memory of a process into host memory as far as the memory limit of the asynchronous
+         * scan queue allows. Regions that do not fit anymore are scanned synchronously right away.
+         */
+        [[nodiscard]] std::unique_ptr<CapturedProcess>
+        captureProcess(const VmiCore::ActiveProcessInformation& processInformation);
+
+        /**
+         * Captures the windows of a region exceeding the scan window size one after another, so that never more than
+         * a single window is mapped. Windows that do not fit anymore are scanned synchronously right away. If
+         * detections are dumped, a region is either captured completely or scanned synchronously as a whole and dumped
+         * right away if it has detections, because it cannot be dumped from some of its windows once the process is
+         * gone.
+         */
+        void captureWindowedRegion(const VmiCore::ActiveProcessInformation& processInformation,
+                                   const VmiCore::MemoryRegion& memoryRegionDescriptor,
+                                   CapturedProcess& capturedProcess);
+
+        /**
+         * Blocks until a mapping of the given size fits into the memory budget while a process is captured. The copies
+         * captured so far are only released once the whole process has been scanned, so waiting for them would never
+         * end. The mapping is admitted beyond the limit instead if nothing but these copies occupy the budget.
+         */
+        [[nodiscard]] std::unique_ptr<MemoryBudget::Reservation>
+        reserveCaptureMapping(std::size_t bytes, const CapturedProcess& capturedProcess);
+
+        /**
+         * Copies the given mapped regions into host memory if both the memory budget and the memory limit of the
+         * asynchronous scan queue allow. Returns nullopt otherwise.
+         */
+        [[nodiscard]] std::optional<CapturedMemoryRegion>
+        tryCaptureMappedRegions(const VmiCore::MemoryRegion& memoryRegionDescriptor,
+                                std::span<const VmiCore::MappedRegion> mappedRegions,
+                                std::size_t mappedBytes);
+
+        void scanCapturedProcess(const CapturedProcess& capturedProcess);
 
-        void scanMemoryRegion(pid_t pid,
-                              uint64_t dtb,
-                              const std::string& processName,
-                              const VmiCore::MemoryRegion& memoryRegionDescriptor);
+        /**
+         * Returns the captured pages of the given region. A region that has been captured in windows is assembled from
+         * them, with overlapping pages taken from the earlier window. Empty if the region has not been captured.
+         */
+        [[nodiscard]] static std::vector<VmiCore::MappedRegion>
+        getCapturedMappedRegions(const CapturedProcess& capturedProcess,
+                                 const VmiCore::MemoryRegion& memoryRegionDescriptor);
 
         void logInMemoryResultToTextFile(const std::string& processName,
                                          VmiCore::pid_t pid,
@@ -0,0 +1,118 @@
+#include "SipHash.h"
+#include <bit>
+#include <cstring>
+#include <random>
+
+namespace InMemoryScanner
+{
+    namespace
+    {
+        constexpr int compressionRounds = 2;
+        constexpr int finalizationRounds = 4;
+    }
+
+    SipHash128::SipHash128(const Key& key)
+        : state{key[0] ^ 0x736f6d6570736575, key[1] ^ 0x646f72616e646f6d ^ 0xee, key[0] ^ 0x6c7967656e657261,
+                key[1] ^ 0x7465646279746573}
+    {
+    }
+
+    SipHash128::Key SipHash128::createRandomKey()
+    {
+        std::random_device randomDevice;
+        Key key{};
+        for (auto& keyPart : key)
+        {
+            keyPart = (static_cast<uint64_t>(randomDevice()) << 32) | randomDevice();
+        }
+        return key;
+    }
+
+    void SipHash128::update(std::span<const uint8_t> data)
+    {
+        length += data.size();
+
+        // Complete a word that has been started by a previous update
+        while (pendingByteCount > 0 && pendingByteCount < sizeof(uint64_t) && !data.empty())
+        {
+            pendingBytes |= static_cast<uint64_t>(data.front()) << (8 * pendingByteCount++);
+            data = data.subspan(1);
+        }
+        if (pendingByteCount == sizeof(uint64_t))
+        {
+            compressWord(pendingBytes);
+            pendingBytes = 0;
+            pendingByteCount = 0;
+        }
+
+        while (data.size() >= sizeof(uint64_t))
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, data.data(), sizeof(word));
+            compressWord(word);
+            data = data.subspan(sizeof(uint64_t));
+        }
+
+        for (const auto byte : data)
+        {
+            pendingBytes |= static_cast<uint64_t>(byte) << (8 * pendingByteCount++);
+        }
+    }
+
+    void SipHash128::update(uint64_t value)
+    {
+        if (pendingByteCount > 0)
+        {
+            std::array<uint8_t, sizeof(uint64_t)> bytes{};
+            std::memcpy(bytes.data(), &value, sizeof(value));
+            update(bytes);
+            return;
+        }
+        length += sizeof(uint64_t);
+        compressWord(value);
+    }
+
+    SipHash128::Digest SipHash128::finalize()
+    {
+        compressWord(pendingBytes | (length << 56));
+
+        Digest digest{};
+        state[2] ^= 0xee;
+        sipRounds(finalizationRounds);
+        digest[0] = state[0] ^ state[1] ^ state[2] ^ state[3];
+        state[1] ^= 0xdd;
+        sipRounds(finalizationRounds);
+        digest[1] = state[0] ^ state[1] ^ state[2] ^ state[3];
+
+        return digest;
+    }
+
+    void SipHash128::compressWord(uint64_t word)
+    {
+        state[3] ^= word;
+        sipRounds(compressionRounds);
+        state[0] ^= word;
+    }
+
+    void SipHash128::sipRounds(int rounds)
+    {
+        auto& [v0, v1, v2, v3] = state;
+        for (int i = 0; i < rounds; i++)
+        {
+            v0 += v1;
+            v1 = std::rotl(v1, 13);
+            v1 ^= v0;
+            v0 = std::rotl(v0, 32);
+            v2 += v3;
+            v3 = std::rotl(v3, 16);
+            v3 ^= v2;
+            v0 += v3;
+            v3 = std::rotl(v3, 21);
+            v3 ^= v0;
+            v2 += v1;
+            v1 = std::rotl(v1, 17);
+            v1 ^= v2;
+            v2 = std::rotl(v2, 32);
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef INMEMORYSCANNER_SIPHASH_H
+#define INMEMORYSCANNER_SIPHASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace InMemoryScanner
+{
+    /**
+     * Incremental SipHash-2-4 with 128 bit output, a keyed pseudorandom function. Without knowledge of the key,
+     * collisions cannot be found any faster than by guessing. Input may be passed in arbitrarily sized parts, the
+     * result only depends on their concatenation.
+     */
+    class SipHash128
+    {
+      public:
+        using Key = std::array<uint64_t, 2>;
+        using Digest = std::array<uint64_t, 2>;
+
+        explicit SipHash128(const Key& key);
+
+        /// Generates a key from std::random_device.
+        [[nodiscard]] static Key createRandomKey();
+
+        void update(std::span<const uint8_t> data);
+
+        /// Equivalent to updating with the little endian representation of the value.
+        void update(uint64_t value);
+
+        /// May only be called once.
+        [[nodiscard]] Digest finalize();
+
+      private:
+        std::array<uint64_t, 4> state;
+        uint64_t pendingBytes = 0;
+        std::size_t pendingByteCount = 0;
+        uint64_t length = 0;
+
+        void compressWord(uint64_t word);
+
+        void sipRounds(int rounds);
+    };
+}
+
+#endif // INMEMORYSCANNER_SIPHASH_H
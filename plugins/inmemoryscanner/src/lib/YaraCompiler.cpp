@@ -0,0 +1,296 @@
+#include "YaraCompiler.h"
+#include "Common.h"
+#include "Filenames.h"
+#include "IYaraInterface.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fmt/format.h>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <yara.h>
+
+using VmiCore::Plugin::PluginInterface;
+
+namespace InMemoryScanner
+{
+    namespace
+    {
+        constexpr std::string_view compiledRulesMagic = "YARA";
+        constexpr uint64_t fnvOffsetBasis = 0xCBF29CE484222325;
+        constexpr uint64_t fnvPrime = 0x100000001B3;
+
+        uint64_t hashBytes(uint64_t hash, std::string_view bytes)
+        {
+            for (auto byte : bytes)
+            {
+                hash ^= static_cast<uint8_t>(byte);
+                hash *= fnvPrime;
+            }
+            return hash;
+        }
+
+        /// Occurrences within comments or strings are found as well, which only leads to additional files being hashed.
+        std::vector<std::filesystem::path> findIncludedFiles(const std::filesystem::path& file,
+                                                             const std::string& content)
+        {
+            static const std::regex includeDirective(R"re(\binclude\s*"([^"]+)")re");
+            std::vector<std::filesystem::path> includedFiles;
+            for (auto match = std::sregex_iterator(content.begin(), content.end(), includeDirective);
+                 match != std::sregex_iterator();
+                 ++match)
+            {
+                // Relative includes are resolved against the directory of the including file
+                includedFiles.push_back(file.parent_path() / (*match)[1].str());
+            }
+            return includedFiles;
+        }
+
+        void collectCompilerMessage(int errorLevel,
+                                    const char* fileName,
+                                    int lineNumber,
+                                    [[maybe_unused]] const YR_RULE* rule,
+                                    const char* message,
+                                    void* userData)
+        {
+            if (errorLevel != YARA_ERROR_LEVEL_ERROR)
+            {
+                return;
+            }
+            static_cast<std::vector<std::string>*>(userData)->push_back(
+                fmt::format("{}:{}: {}", fileName != nullptr ? fileName : "", lineNumber, message));
+        }
+    }
+
+    YaraCompiler::YaraCompiler(const PluginInterface* pluginInterface, std::filesystem::path cacheDirectory)
+        : cacheDirectory(std::move(cacheDirectory)), logger(pluginInterface->newNamedLogger(INMEMORY_LOGGER_NAME))
+    {
+        logger->bind({{VmiCore::WRITE_TO_FILE_TAG, LOG_FILENAME}});
+    }
+
+    std::filesystem::path YaraCompiler::getCompiledRules(const std::filesystem::path& signatures) const
+    {
+        if (!std::filesystem::is_directory(signatures) && isCompiledRulesFile(signatures))
+        {
+            return signatures;
+        }
+
+        prepareCacheDirectory();
+        auto compiledRulesPath = cacheDirectory / fmt::format("{}-{:016x}.yarc", YR_VERSION, hashSources(signatures));
+        if (std::filesystem::exists(compiledRulesPath))
+        {
+            logger->info("Using cached compiled rules", {{"Rules", compiledRulesPath.string()}});
+            return compiledRulesPath;
+        }
+
+        auto sourceFiles = collectSourceFiles(signatures);
+        logger->info("Compiling rules",
+                     {{"Sources", signatures.string()},
+                      {"Files", sourceFiles.size()},
+                      {"Rules", compiledRulesPath.string()}});
+        // Written under a unique name first, so that concurrent instances never load partially written rules
+        auto temporaryPath = compiledRulesPath;
+        temporaryPath += fmt::format(".{}.tmp", getpid());
+        try
+        {
+            compile(sourceFiles, temporaryPath);
+            std::filesystem::rename(temporaryPath, compiledRulesPath);
+        }
+        catch (const std::exception&)
+        {
+            std::filesystem::remove(temporaryPath);
+            throw;
+        }
+
+        return compiledRulesPath;
+    }
+
+    bool YaraCompiler::isCompiledRulesFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            throw YaraException(fmt::format("Cannot open signatures {}", path.string()));
+        }
+        std::array<char, compiledRulesMagic.size()> magic{};
+        file.read(magic.data(), magic.size());
+
+        return file.gcount() == static_cast<std::streamsize>(magic.size()) &&
+               std::string_view(magic.data(), magic.size()) == compiledRulesMagic;
+    }
+
+    std::vector<YaraCompiler::SourceFile> YaraCompiler::collectSourceFiles(const std::filesystem::path& signatures)
+    {
+        std::vector<SourceFile> sourceFiles;
+        if (!std::filesystem::is_directory(signatures))
+        {
+            sourceFiles.push_back({.path = signatures, .ruleNamespace = "default"});
+            return sourceFiles;
+        }
+
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(signatures))
+        {
+            auto extension = entry.path().extension();
+            if (entry.is_regular_file() && (extension == ".yar" || extension == ".yara"))
+            {
+                auto relativePath = entry.path().lexically_relative(signatures);
+                relativePath.replace_extension();
+                sourceFiles.push_back({.path = entry.path(), .ruleNamespace = relativePath.generic_string()});
+            }
+        }
+        // Directory iteration order is unspecified, but rule order should not depend on the file system
+        std::ranges::sort(sourceFiles, {}, &SourceFile::path);
+        if (sourceFiles.empty())
+        {
+            throw YaraException(fmt::format("No rule sources found in {}", signatures.string()));
+        }
+
+        return sourceFiles;
+    }
+
+    void YaraCompiler::prepareCacheDirectory() const
+    {
+        if (cacheDirectory.has_parent_path())
+        {
+            std::filesystem::create_directories(cacheDirectory.parent_path());
+        }
+        if (mkdir(cacheDirectory.c_str(), S_IRWXU) != 0 && errno != EEXIST)
+        {
+            throw YaraException(fmt::format(
+                "Cannot create rules cache directory {}: {}", cacheDirectory.string(), std::strerror(errno)));
+        }
+
+        // Cached rules are loaded as is, therefore nobody else may be able to place files in the cache
+        struct stat status
+        {
+        };
+        if (lstat(cacheDirectory.c_str(), &status) != 0)
+        {
+            throw YaraException(fmt::format(
+                "Cannot access rules cache directory {}: {}", cacheDirectory.string(), std::strerror(errno)));
+        }
+        if (!S_ISDIR(status.st_mode) || status.st_uid != geteuid() || (status.st_mode & (S_IWGRP | S_IWOTH)) != 0)
+        {
+            throw YaraException(fmt::format("Rules cache directory {} has to be a directory owned by the current user "
+                                            "that is not writable by others",
+                                            cacheDirectory.string()));
+        }
+    }
+
+    uint64_t YaraCompiler::hashSources(const std::filesystem::path& signatures)
+    {
+        std::vector<std::filesystem::path> pendingFiles;
+        if (std::filesystem::is_directory(signatures))
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(signatures))
+            {
+                if (entry.is_regular_file())
+                {
+                    pendingFiles.push_back(entry.path());
+                }
+            }
+        }
+        else
+        {
+            pendingFiles.push_back(signatures);
+        }
+
+        // Included files may be located anywhere, so they are followed as well. Ordered by path, so that the hash does
+        // not depend on the file system.
+        std::map<std::filesystem::path, std::string> contents;
+        while (!pendingFiles.empty())
+        {
+            auto file = pendingFiles.back().lexically_normal();
+            pendingFiles.pop_back();
+            if (contents.contains(file))
+            {
+                continue;
+            }
+            // Missing files are hashed as empty, compiling will report them
+            std::ifstream fileStream(file, std::ios::binary);
+            std::string content{std::istreambuf_iterator<char>(fileStream), std::istreambuf_iterator<char>()};
+            std::ranges::copy(findIncludedFiles(file, content), std::back_inserter(pendingFiles));
+            contents.emplace(std::move(file), std::move(content));
+        }
+
+        auto hash = hashBytes(fnvOffsetBasis, YR_VERSION);
+        for (const auto& [file, content] : contents)
+        {
+            // Names and sizes delimit the contents, so that moving bytes between files changes the hash
+            hash = hashBytes(hash, file.lexically_relative(signatures.lexically_normal()).generic_string());
+            hash = hashBytes(hash, std::to_string(content.size()));
+            hash = hashBytes(hash, content);
+        }
+
+        return hash;
+    }
+
+    void YaraCompiler::compile(const std::vector<SourceFile>& sourceFiles,
+                               const std::filesystem::path& compiledRulesPath)
+    {
+        if (auto err = yr_initialize(); err != ERROR_SUCCESS)
+        {
+            throw YaraException(fmt::format("Cannot initialize Yara. Error code: {}", err));
+        }
+        YR_COMPILER* compiler = nullptr;
+        YR_RULES* rules = nullptr;
+        auto cleanup = [&compiler, &rules]()
+        {
+            if (rules)
+            {
+                yr_rules_destroy(rules);
+            }
+            if (compiler)
+            {
+                yr_compiler_destroy(compiler);
+            }
+            yr_finalize();
+        };
+
+        try
+        {
+            if (auto err = yr_compiler_create(&compiler); err != ERROR_SUCCESS)
+            {
+                throw YaraException(fmt::format("Cannot create compiler. Error code: {}", err));
+            }
+            std::vector<std::string> errors;
+            yr_compiler_set_callback(compiler, &collectCompilerMessage, &errors);
+
+            for (const auto& sourceFile : sourceFiles)
+            {
+                std::unique_ptr<FILE, decltype(&fclose)> file(fopen(sourceFile.path.c_str(), "r"), &fclose);
+                if (!file)
+                {
+                    throw YaraException(fmt::format("Cannot open rule source {}", sourceFile.path.string()));
+                }
+                // The compiler cannot be used any further after a file with errors
+                if (yr_compiler_add_file(
+                        compiler, file.get(), sourceFile.ruleNamespace.c_str(), sourceFile.path.c_str()) > 0)
+                {
+                    throw YaraException(fmt::format("Cannot compile rules. Errors: {}", fmt::join(errors, ", ")));
+                }
+            }
+
+            if (auto err = yr_compiler_get_rules(compiler, &rules); err != ERROR_SUCCESS)
+            {
+                throw YaraException(fmt::format("Cannot obtain rules from compiler. Error code: {}", err));
+            }
+            if (auto err = yr_rules_save(rules, compiledRulesPath.c_str()); err != ERROR_SUCCESS)
+            {
+                throw YaraException(fmt::format("Cannot save compiled rules. Error code: {}", err));
+            }
+        }
+        catch (const std::exception&)
+        {
+            cleanup();
+            throw;
+        }
+        cleanup();
+    }
+}
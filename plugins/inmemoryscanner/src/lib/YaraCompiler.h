@@ -0,0 +1,60 @@
+#ifndef INMEMORYSCANNER_YARACOMPILER_H
+#define INMEMORYSCANNER_YARACOMPILER_H
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include <vmicore/io/ILogger.h>
+#include <vmicore/plugins/PluginInterface.h>
+
+namespace InMemoryScanner
+{
+    /**
+     * Provides compiled yara rules for the configured signatures. Rule sources are compiled with the libyara version
+     * the plugin has been built with, so that compiled rules always match the scanning engine. The result is cached
+     * on disk, keyed by the content of all sources including the files they include and the libyara version, and loaded
+     * directly on later runs. The cache directory is created accessible to the current user only and is rejected if
+     * anybody else could place files in it.
+     */
+    class YaraCompiler
+    {
+      public:
+        YaraCompiler(const VmiCore::Plugin::PluginInterface* pluginInterface, std::filesystem::path cacheDirectory);
+
+        /**
+         * Returns the path of compiled rules. Compiled rules are returned as is. Sources, either a single file or a
+         * directory containing .yar and .yara files, are compiled unless a cached result exists. Rules of a single file
+         * are put into the default namespace, rules of a directory into a namespace named after the relative path of
+         * their file.
+         */
+        [[nodiscard]] std::filesystem::path getCompiledRules(const std::filesystem::path& signatures) const;
+
+      private:
+        struct SourceFile
+        {
+            std::filesystem::path path;
+            std::string ruleNamespace;
+        };
+
+        std::filesystem::path cacheDirectory;
+        std::unique_ptr<VmiCore::ILogger> logger;
+
+        [[nodiscard]] static bool isCompiledRulesFile(const std::filesystem::path& path);
+
+        [[nodiscard]] static std::vector<SourceFile> collectSourceFiles(const std::filesystem::path& signatures);
+
+        /// Creates the cache directory if necessary and verifies that it is owned by the current user and not writable
+        /// by anybody else.
+        void prepareCacheDirectory() const;
+
+        /// Covers all files below the signatures path and all files they include, so that changes of included files
+        /// are noticed as well.
+        [[nodiscard]] static uint64_t hashSources(const std::filesystem::path& signatures);
+
+        static void compile(const std::vector<SourceFile>& sourceFiles, const std::filesystem::path& compiledRulesPath);
+    };
+}
+
+#endif // INMEMORYSCANNER_YARACOMPILER_H
@@ -1,43 +1,12 @@
 #include "YaraInterface.h"
+#include <algorithm>
 #include <fmt/core.h>
+#include <map>
 
 using VmiCore::addr_t;
 using VmiCore::MappedRegion;
 using VmiCore::PagingDefinitions::pageSizeInBytes;
 
-namespace
-{
-    struct YaraIteratorContext
-    {
-        std::vector<YR_MEMORY_BLOCK> blocks;
-        std::size_t index;
-    };
-
-    YR_MEMORY_BLOCK* get_next_block(YR_MEMORY_BLOCK_ITERATOR* iterator)
-    {
-        if (auto* iteratorContext = static_cast<YaraIteratorContext*>(iterator->context);
-            ++iteratorContext->index < iteratorContext->blocks.size())
-        {
-            return &iteratorContext->blocks[iteratorContext->index];
-        }
-
-        return nullptr;
-    }
-
-    YR_MEMORY_BLOCK* get_first_block(YR_MEMORY_BLOCK_ITERATOR* iterator)
-    {
-        auto* iteratorContext = static_cast<YaraIteratorContext*>(iterator->context);
-        iteratorContext->index = 0;
-
-        return &iteratorContext->blocks[iteratorContext->index];
-    }
-
-    const uint8_t* fetch_block_data(YR_MEMORY_BLOCK* block)
-    {
-        return static_cast<const uint8_t*>(block->context);
-    }
-}
-
 namespace InMemoryScanner
 {
     YaraInterface::YaraInterface(const std::string& rulesFile, int scanTimeout) : scanTimeout(scanTimeout)
@@ -57,6 +26,11 @@ namespace InMemoryScanner
 
     YaraInterface::~YaraInterface()
     {
+        // All scans have finished at this point, so every scan context is idle
+        for (const auto& scanContext : idleScanContexts)
+        {
+            yr_scanner_destroy(scanContext->scanner);
+        }
         if (rules)
         {
             yr_rules_destroy(rules);
@@ -66,31 +40,43 @@ namespace InMemoryScanner
 
     std::vector<Rule> YaraInterface::scanMemory(std::span<const MappedRegion> mappedRegions)
     {
-        std::vector<Rule> results;
-
-        YaraIteratorContext iteratorContext{};
-        iteratorContext.blocks.reserve(mappedRegions.size());
-        for (const auto& mappedRegion : mappedRegions)
+        if (mappedRegions.empty())
         {
-            iteratorContext.blocks.emplace_back(mappedRegion.num_pages * pageSizeInBytes,
-                                                mappedRegion.guestBaseVA,
-                                                mappedRegion.mappingBase,
-                                                &fetch_block_data);
+            return {};
         }
 
-        YR_MEMORY_BLOCK_ITERATOR iterator{.context = &iteratorContext,
-                                          .first = &get_first_block,
-                                          .next = &get_next_block,
-                                          .file_size = nullptr,
-                                          .last_error = ERROR_SUCCESS};
+        auto scanContext = acquireScanContext();
+        int err = ERROR_SUCCESS;
+        try
+        {
+            scanContext->blocks.clear();
+            for (const auto& mappedRegion : mappedRegions)
+            {
+                scanContext->blocks.push_back({.size = mappedRegion.num_pages * pageSizeInBytes,
+                                               .base = mappedRegion.guestBaseVA,
+                                               .context = mappedRegion.mappingBase,
+                                               .fetch_data = &fetchBlockData});
+            }
 
-        if (auto err = yr_rules_scan_mem_blocks(rules,
-                                                &iterator,
-                                                SCAN_FLAGS_PROCESS_MEMORY | SCAN_FLAGS_REPORT_RULES_MATCHING,
-                                                yaraCallback,
-                                                &results,
-                                                scanTimeout);
-            err != ERROR_SUCCESS)
+            YR_MEMORY_BLOCK_ITERATOR iterator{.context = scanContext.get(),
+                                              .first = &getFirstBlock,
+                                              .next = &getNextBlock,
+                                              .file_size = nullptr,
+                                              .last_error = ERROR_SUCCESS};
+            // Matches of the previous scan are discarded by the scanner itself
+            err = yr_scanner_scan_mem_blocks(scanContext->scanner, &iterator);
+        }
+        catch (const std::exception&)
+        {
+            scanContext->results.clear();
+            releaseScanContext(std::move(scanContext));
+            throw;
+        }
+        auto results = std::move(scanContext->results);
+        scanContext->results.clear();
+        releaseScanContext(std::move(scanContext));
+
+        if (err != ERROR_SUCCESS)
         {
             if (err == ERROR_SCAN_TIMEOUT)
             {
@@ -103,6 +89,107 @@ namespace InMemoryScanner
         return results;
     }
 
+    std::vector<RuleCost> YaraInterface::getRuleCosts()
+    {
+        std::vector<RuleCost> ruleCosts;
+#ifdef YR_PROFILING_ENABLED
+        // Every scanner accumulates the costs of its own scans
+        std::map<YR_RULE*, uint64_t> accumulatedCosts;
+        std::scoped_lock guard(scanContextLock);
+        for (const auto& scanContext : idleScanContexts)
+        {
+            auto* profilingInfo = yr_scanner_get_profiling_info(scanContext->scanner);
+            if (profilingInfo == nullptr)
+            {
+                throw YaraException("Cannot obtain profiling information");
+            }
+            for (auto* entry = profilingInfo; entry->rule != nullptr; entry++)
+            {
+                accumulatedCosts[entry->rule] += entry->cost;
+            }
+            yr_free(profilingInfo);
+        }
+
+        ruleCosts.reserve(accumulatedCosts.size());
+        for (const auto& [rule, cost] : accumulatedCosts)
+        {
+            ruleCosts.push_back({.ruleNamespace = rule->ns->name, .ruleName = rule->identifier, .cost = cost});
+        }
+        std::ranges::sort(ruleCosts, std::ranges::greater{}, &RuleCost::cost);
+#endif
+        return ruleCosts;
+    }
+
+    std::unique_ptr<YaraInterface::ScanContext> YaraInterface::acquireScanContext()
+    {
+        std::unique_lock guard(scanContextLock);
+        // Yara rules must not be used by more than YR_MAX_THREADS scanners at once
+        scanContextReleased.wait(guard,
+                                 [this]() { return !idleScanContexts.empty() || scanContextCount < YR_MAX_THREADS; });
+        std::unique_ptr<ScanContext> scanContext;
+        if (!idleScanContexts.empty())
+        {
+            scanContext = std::move(idleScanContexts.back());
+            idleScanContexts.pop_back();
+        }
+        else
+        {
+            scanContext = std::make_unique<ScanContext>();
+            if (auto err = yr_scanner_create(rules, &scanContext->scanner); err != ERROR_SUCCESS)
+            {
+                throw YaraException(fmt::format("Cannot create scanner. Error code: {}", err));
+            }
+            yr_scanner_set_flags(scanContext->scanner, SCAN_FLAGS_PROCESS_MEMORY | SCAN_FLAGS_REPORT_RULES_MATCHING);
+            yr_scanner_set_timeout(scanContext->scanner, scanTimeout);
+            yr_scanner_set_callback(scanContext->scanner, yaraCallback, &scanContext->results);
+            scanContextCount++;
+        }
+        acquiredScanContextCount++;
+        maxAcquiredScanContextCount = std::max(maxAcquiredScanContextCount, acquiredScanContextCount);
+
+        return scanContext;
+    }
+
+    void YaraInterface::releaseScanContext(std::unique_ptr<ScanContext> scanContext)
+    {
+        {
+            std::scoped_lock guard(scanContextLock);
+            idleScanContexts.push_back(std::move(scanContext));
+            acquiredScanContextCount--;
+        }
+        scanContextReleased.notify_one();
+    }
+
+    std::size_t YaraInterface::getMaxConcurrentScanCount()
+    {
+        std::scoped_lock guard(scanContextLock);
+        return maxAcquiredScanContextCount;
+    }
+
+    YR_MEMORY_BLOCK* YaraInterface::getFirstBlock(YR_MEMORY_BLOCK_ITERATOR* iterator)
+    {
+        auto* scanContext = static_cast<ScanContext*>(iterator->context);
+        scanContext->blockIndex = 0;
+
+        return &scanContext->blocks[scanContext->blockIndex];
+    }
+
+    YR_MEMORY_BLOCK* YaraInterface::getNextBlock(YR_MEMORY_BLOCK_ITERATOR* iterator)
+    {
+        if (auto* scanContext = static_cast<ScanContext*>(iterator->context);
+            ++scanContext->blockIndex < scanContext->blocks.size())
+        {
+            return &scanContext->blocks[scanContext->blockIndex];
+        }
+
+        return nullptr;
+    }
+
+    const uint8_t* YaraInterface::fetchBlockData(YR_MEMORY_BLOCK* block)
+    {
+        return static_cast<const uint8_t*>(block->context);
+    }
+
     int YaraInterface::yaraCallback(YR_SCAN_CONTEXT* context, int message, void* message_data, void* user_data)
     {
         int ret = 0;
@@ -2,7 +2,11 @@
 
 #include "Common.h"
 #include "IYaraInterface.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 #include <yara.h>
 
 namespace InMemoryScanner
@@ -14,33 +18,55 @@ namespace InMemoryScanner
 
         YaraInterface(const YaraInterface& other) = delete;
 
-        YaraInterface(YaraInterface&& other) noexcept : rules(other.rules)
-        {
-            other.rules = nullptr;
-        }
+        YaraInterface(YaraInterface&& other) = delete;
 
         YaraInterface& operator=(const YaraInterface& other) = delete;
 
-        YaraInterface& operator=(YaraInterface&& other) noexcept
-        {
-            if (this == &other)
-            {
-                return *this;
-            }
-
-            rules = other.rules;
-            other.rules = nullptr;
-
-            return *this;
-        }
+        YaraInterface& operator=(YaraInterface&& other) = delete;
 
         ~YaraInterface() override;
 
+        /// Blocks while YR_MAX_THREADS scans are running already.
         std::vector<Rule> scanMemory(std::span<const VmiCore::MappedRegion> mappedRegions) override;
 
+        /// Must not be called while scans are running.
+        [[nodiscard]] std::vector<RuleCost> getRuleCosts() override;
+
+        /// Highest number of scans that have been running at the same time so far.
+        [[nodiscard]] std::size_t getMaxConcurrentScanCount();
+
       private:
+        /**
+         * A yara scanner together with all buffers that are needed for a single scan. Scan contexts are created on
+         * demand and reused by subsequent scans, so that scanner setup and allocations only happen once per
+         * concurrently scanning thread.
+         */
+        struct ScanContext
+        {
+            YR_SCANNER* scanner = nullptr;
+            std::vector<YR_MEMORY_BLOCK> blocks;
+            std::size_t blockIndex = 0;
+            std::vector<Rule> results;
+        };
+
         int scanTimeout;
         YR_RULES* rules = nullptr;
+        std::mutex scanContextLock;
+        std::condition_variable scanContextReleased;
+        std::vector<std::unique_ptr<ScanContext>> idleScanContexts;
+        std::size_t scanContextCount = 0;
+        std::size_t acquiredScanContextCount = 0;
+        std::size_t maxAcquiredScanContextCount = 0;
+
+        [[nodiscard]] std::unique_ptr<ScanContext> acquireScanContext();
+
+        void releaseScanContext(std::unique_ptr<ScanContext> scanContext);
+
+        static YR_MEMORY_BLOCK* getFirstBlock(YR_MEMORY_BLOCK_ITERATOR* iterator);
+
+        static YR_MEMORY_BLOCK* getNextBlock(YR_MEMORY_BLOCK_ITERATOR* iterator);
+
+        static const uint8_t* fetchBlockData(YR_MEMORY_BLOCK* block);
 
         static int yaraCallback(YR_SCAN_CONTEXT* context, int message, void* message_data, void* user_data);
 
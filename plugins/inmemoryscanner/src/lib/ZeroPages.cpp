@@ -0,0 +1,146 @@
+#include "ZeroPages.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vmicore/os/PagingDefinitions.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+using VmiCore::MappedRegion;
+using VmiCore::PagingDefinitions::pageSizeInBytes;
+
+namespace InMemoryScanner
+{
+    namespace
+    {
+        // Bytes that are combined before testing for a non-zero byte. Pages of non-zero data are usually rejected
+        // within the first block, while zero pages are read with a single branch per block.
+        constexpr std::size_t blockSize = 128;
+        static_assert(pageSizeInBytes % blockSize == 0);
+
+#if defined(__x86_64__)
+        // SSE2 is part of the x86-64 baseline and therefore always available
+        bool isZeroSse2(const uint8_t* data, std::size_t size)
+        {
+            const auto zero = _mm_setzero_si128();
+            for (std::size_t offset = 0; offset < size; offset += blockSize)
+            {
+                const auto* block = reinterpret_cast<const __m128i*>(data + offset);
+                auto accumulator = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(block), _mm_loadu_si128(block + 1)),
+                                                _mm_or_si128(_mm_loadu_si128(block + 2), _mm_loadu_si128(block + 3)));
+                accumulator = _mm_or_si128(
+                    accumulator,
+                    _mm_or_si128(_mm_or_si128(_mm_loadu_si128(block + 4), _mm_loadu_si128(block + 5)),
+                                 _mm_or_si128(_mm_loadu_si128(block + 6), _mm_loadu_si128(block + 7))));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(accumulator, zero)) != 0xFFFF)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        __attribute__((target("avx2"))) bool isZeroAvx2(const uint8_t* data, std::size_t size)
+        {
+            for (std::size_t offset = 0; offset < size; offset += blockSize)
+            {
+                const auto* block = reinterpret_cast<const __m256i*>(data + offset);
+                auto accumulator =
+                    _mm256_or_si256(_mm256_or_si256(_mm256_loadu_si256(block), _mm256_loadu_si256(block + 1)),
+                                    _mm256_or_si256(_mm256_loadu_si256(block + 2), _mm256_loadu_si256(block + 3)));
+                if (!_mm256_testz_si256(accumulator, accumulator))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+#else
+        bool isZeroScalar(const uint8_t* data, std::size_t size)
+        {
+            for (std::size_t offset = 0; offset < size; offset += blockSize)
+            {
+                std::array<uint64_t, blockSize / sizeof(uint64_t)> block{};
+                std::memcpy(block.data(), data + offset, blockSize);
+                uint64_t accumulator = 0;
+                for (auto word : block)
+                {
+                    accumulator |= word;
+                }
+                if (accumulator != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+#endif
+
+        using IsZeroFunction = bool (*)(const uint8_t*, std::size_t);
+
+        IsZeroFunction selectIsZeroFunction()
+        {
+#if defined(__x86_64__)
+            // Called during static initialization, possibly before the CPU model has been initialized otherwise
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return &isZeroAvx2;
+            }
+            return &isZeroSse2;
+#else
+            return &isZeroScalar;
+#endif
+        }
+
+        const IsZeroFunction isZero = selectIsZeroFunction();
+    }
+
+    bool isZeroPage(std::span<const uint8_t> page)
+    {
+        if (page.size() % blockSize != 0)
+        {
+            return std::ranges::all_of(page, [](uint8_t byte) { return byte == 0; });
+        }
+        return isZero(page.data(), page.size());
+    }
+
+    std::vector<MappedRegion> splitAtZeroPageRuns(std::span<const MappedRegion> mappedRegions)
+    {
+        std::vector<MappedRegion> runs;
+        runs.reserve(mappedRegions.size());
+        for (const auto& mappedRegion : mappedRegions)
+        {
+            auto* mappingBase = static_cast<uint8_t*>(mappedRegion.mappingBase);
+            std::vector<bool> zeroPages(mappedRegion.num_pages);
+            for (std::size_t page = 0; page < mappedRegion.num_pages; page++)
+            {
+                zeroPages[page] = isZeroPage({mappingBase + page * pageSizeInBytes, pageSizeInBytes});
+            }
+            auto isKept = [&zeroPages](std::size_t page)
+            {
+                return !zeroPages[page] || (page > 0 && !zeroPages[page - 1]) ||
+                       (page + 1 < zeroPages.size() && !zeroPages[page + 1]);
+            };
+
+            std::size_t runStart = 0;
+            for (std::size_t page = 0; page <= mappedRegion.num_pages; page++)
+            {
+                if (page < mappedRegion.num_pages && isKept(page))
+                {
+                    continue;
+                }
+                if (page > runStart)
+                {
+                    runs.emplace_back(mappedRegion.guestBaseVA + runStart * pageSizeInBytes,
+                                      page - runStart,
+                                      mappingBase + runStart * pageSizeInBytes);
+                }
+                runStart = page + 1;
+            }
+        }
+        return runs;
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef INMEMORYSCANNER_ZEROPAGES_H
+#define INMEMORYSCANNER_ZEROPAGES_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <vmicore/vmi/MappedRegion.h>
+
+namespace InMemoryScanner
+{
+    /// Checks whether all bytes of a page are zero. Uses AVX2 or SSE2 depending on the capabilities of the CPU.
+    [[nodiscard]] bool isZeroPage(std::span<const uint8_t> page);
+
+    /**
+     * Splits the mapped regions at runs of zero pages, which are left out just like unmapped pages. A zero page next to
+     * a page with non-zero bytes is kept, so that patterns reaching into zero padding, e.g. hex strings ending in 00
+     * bytes, still match. Hence, runs of one or two zero pages between data are not left out at all. Matches reaching
+     * more than a page into zero memory are lost. The resulting regions refer to the same mappings.
+     */
+    [[nodiscard]] std::vector<VmiCore::MappedRegion>
+    splitAtZeroPageRuns(std::span<const VmiCore::MappedRegion> mappedRegions);
+}
+
+#endif // INMEMORYSCANNER_ZEROPAGES_H
@@ -0,0 +1,80 @@
+#include "DumpArchive.h"
+#include <filesystem>
+#include <fmt/core.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <tclap/CmdLine.h>
+
+int main(int argc, char* argv[])
+{
+    TCLAP::CmdLine cmd(
+        "Verifies and extracts the memory regions dumped by the InMemory scanner plugin.", ' ', PLUGIN_VERSION);
+    TCLAP::UnlabeledValueArg<std::string> indexArgument(
+        "index",
+        "Index of the dumped regions, e.g. dumpedRegions.jsonl. The archives it refers to are expected next to it.",
+        true,
+        "",
+        "index",
+        cmd);
+    TCLAP::ValueArg<std::string> outputArgument(
+        "o", "output", "Directory to extract dump files to. Only verifies records if omitted.", false, "", "dir", cmd);
+    cmd.parse(argc, argv);
+
+    std::ifstream index(indexArgument.getValue());
+    if (!index)
+    {
+        std::cerr << fmt::format("Cannot open {}\n", indexArgument.getValue());
+        return 1;
+    }
+    std::size_t skippedLines = 0;
+    auto entries = InMemoryScanner::DumpArchiveReader::readIndex(index, skippedLines);
+    if (skippedLines > 0)
+    {
+        std::cerr << fmt::format("Skipped {} malformed index lines\n", skippedLines);
+    }
+
+    std::filesystem::path outputDirectory(outputArgument.getValue());
+    if (outputArgument.isSet())
+    {
+        std::filesystem::create_directories(outputDirectory);
+    }
+    // Archive names are taken from the index, so only file names are used to stay within the directory of the index
+    auto archiveDirectory = std::filesystem::path(indexArgument.getValue()).parent_path();
+    std::map<std::string, std::pair<std::ifstream, std::unique_ptr<InMemoryScanner::DumpArchiveReader>>> readers;
+    std::size_t failedRecords = 0;
+    for (const auto& entry : entries)
+    {
+        try
+        {
+            auto& [archive, reader] = readers[entry.record.archiveFileName];
+            if (!reader)
+            {
+                auto archiveFile = archiveDirectory / std::filesystem::path(entry.record.archiveFileName).filename();
+                archive.open(archiveFile, std::ios::binary);
+                if (!archive)
+                {
+                    throw std::runtime_error(fmt::format("Cannot open {}", archiveFile.string()));
+                }
+                reader = std::make_unique<InMemoryScanner::DumpArchiveReader>(archive);
+            }
+            if (outputArgument.isSet())
+            {
+                // Only the file name is used, so that an index entry cannot point outside of the output directory
+                reader->extract(entry.record, outputDirectory / std::filesystem::path(entry.dumpFileName).filename());
+            }
+            else
+            {
+                static_cast<void>(reader->readPayload(entry.record));
+            }
+            std::cout << fmt::format("{}: ok\n", entry.dumpFileName);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << fmt::format("{}: {}\n", entry.dumpFileName, e.what());
+            failedRecords++;
+        }
+    }
+    return failedRecords == 0 ? 0 : 1;
+}
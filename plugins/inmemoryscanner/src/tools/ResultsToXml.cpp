@@ -0,0 +1,37 @@
+#include "OutputXML.h"
+#include <fmt/core.h>
+#include <fstream>
+#include <iostream>
+#include <tclap/CmdLine.h>
+
+int main(int argc, char* argv[])
+{
+    TCLAP::CmdLine cmd("Converts the streamed results of the InMemory scanner plugin to XML.", ' ', PLUGIN_VERSION);
+    TCLAP::UnlabeledValueArg<std::string> inputArgument(
+        "input", "Results in JSON Lines format, e.g. inMemoryResults.jsonl", true, "", "input", cmd);
+    TCLAP::UnlabeledValueArg<std::string> outputArgument(
+        "output", "Path of the XML file to create, e.g. inMemoryResults.xml", true, "", "output", cmd);
+    cmd.parse(argc, argv);
+
+    std::ifstream jsonLines(inputArgument.getValue());
+    if (!jsonLines)
+    {
+        std::cerr << fmt::format("Cannot open {}\n", inputArgument.getValue());
+        return 1;
+    }
+    InMemoryScanner::OutputXML outputXml;
+    auto skippedLines = outputXml.addResults(jsonLines);
+    if (skippedLines > 0)
+    {
+        std::cerr << fmt::format("Skipped {} malformed lines\n", skippedLines);
+    }
+
+    std::ofstream xmlFile(outputArgument.getValue());
+    xmlFile << *outputXml.getString();
+    if (!xmlFile)
+    {
+        std::cerr << fmt::format("Cannot write {}\n", outputArgument.getValue());
+        return 1;
+    }
+    return 0;
+}
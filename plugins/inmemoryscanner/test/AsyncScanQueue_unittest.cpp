@@ -0,0 +1,63 @@
+#include <AsyncScanQueue.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vmicore_test/io/mock_Logger.h>
+#include <vmicore_test/plugins/mock_PluginInterface.h>
+#include <vmicore_test/threading/mock_TaskHandle.h>
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+using VmiCore::MockLogger;
+using VmiCore::MockTaskHandle;
+using VmiCore::Plugin::MockPluginInterface;
+
+namespace InMemoryScanner
+{
+    class AsyncScanQueueFixture : public testing::Test
+    {
+      protected:
+        static constexpr std::size_t maxPendingBytes = 0x1000;
+
+        std::unique_ptr<NiceMock<MockPluginInterface>> pluginInterface =
+            std::make_unique<NiceMock<MockPluginInterface>>();
+
+        void SetUp() override
+        {
+            ON_CALL(*pluginInterface, newNamedLogger(_))
+                .WillByDefault([]() { return std::make_unique<NiceMock<MockLogger>>(); });
+            ON_CALL(*pluginInterface, submitTask(_))
+                .WillByDefault(
+                    [](const std::function<void(std::stop_token)>& function)
+                    {
+                        function(std::stop_token{});
+                        auto taskHandle = std::make_shared<NiceMock<MockTaskHandle>>();
+                        ON_CALL(*taskHandle, isDone()).WillByDefault(Return(true));
+                        return taskHandle;
+                    });
+        }
+    };
+
+    TEST_F(AsyncScanQueueFixture, enqueue_taskFinished_bytesAndSlotReleased)
+    {
+        AsyncScanQueue asyncScanQueue(pluginInterface.get(), 1, maxPendingBytes);
+        ASSERT_TRUE(asyncScanQueue.tryReserveBytes(maxPendingBytes));
+
+        asyncScanQueue.enqueue(maxPendingBytes, []() {});
+
+        EXPECT_FALSE(asyncScanQueue.isFull());
+        EXPECT_TRUE(asyncScanQueue.tryReserveBytes(maxPendingBytes));
+    }
+
+    TEST_F(AsyncScanQueueFixture, enqueue_taskThrows_bytesAndSlotReleased)
+    {
+        AsyncScanQueue asyncScanQueue(pluginInterface.get(), 1, maxPendingBytes);
+        ASSERT_TRUE(asyncScanQueue.tryReserveBytes(maxPendingBytes));
+
+        ASSERT_NO_THROW(asyncScanQueue.enqueue(maxPendingBytes, []() { throw std::runtime_error("Scan failed"); }));
+
+        EXPECT_FALSE(asyncScanQueue.isFull());
+        EXPECT_TRUE(asyncScanQueue.tryReserveBytes(maxPendingBytes));
+    }
+}
@@ -0,0 +1,250 @@
+#include <DumpArchive.h>
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <vmicore/os/PagingDefinitions.h>
+#include <vmicore_test/plugins/mock_PluginInterface.h>
+
+using testing::_;
+using testing::An;
+using testing::DoDefault;
+using testing::NiceMock;
+using testing::Unused;
+using VmiCore::FileChunk;
+using VmiCore::PagingDefinitions::pageSizeInBytes;
+using VmiCore::Plugin::MockPluginInterface;
+
+namespace InMemoryScanner
+{
+    class DumpArchiveTestFixture : public testing::Test
+    {
+      protected:
+        NiceMock<MockPluginInterface> pluginInterface;
+        std::shared_ptr<MemoryBudget> memoryBudget = std::make_shared<MemoryBudget>(16 * pageSizeInBytes);
+        std::map<std::string, std::string> archiveContents;
+        std::string indexContent;
+        std::vector<uint8_t> firstPage = std::vector<uint8_t>(pageSizeInBytes, 0x11);
+        std::vector<uint8_t> secondPage = std::vector<uint8_t>(pageSizeInBytes, 0x22);
+        // Layout of the dump: 1 page, 2 zero pages, 1 page, 1 zero page
+        std::vector<FileChunk> chunks{{.data = firstPage, .holeSize = 2 * pageSizeInBytes},
+                                      {.data = secondPage, .holeSize = pageSizeInBytes}};
+
+        void SetUp() override
+        {
+            ON_CALL(pluginInterface, writeToFile(_, An<std::span<const FileChunk>>()))
+                .WillByDefault(
+                    [this](const std::string& archiveFile, std::span<const FileChunk> appendedChunks)
+                    {
+                        auto& archiveContent = archiveContents[archiveFile];
+                        for (const auto& chunk : appendedChunks)
+                        {
+                            archiveContent.append(chunk.data.begin(), chunk.data.end());
+                            archiveContent.append(chunk.holeSize, '\0');
+                        }
+                        return true;
+                    });
+            ON_CALL(pluginInterface, writeToFile("dumps/dumpedRegions.jsonl", An<const std::string&>()))
+                .WillByDefault([this](Unused, const std::string& line) { indexContent.append(line); });
+        }
+
+        [[nodiscard]] DumpArchive createDumpArchive(int compressionLevel = 0)
+        {
+            return {&pluginInterface, "dumps", compressionLevel, memoryBudget};
+        }
+
+        [[nodiscard]] std::string& archiveContent(const ArchiveRecord& record)
+        {
+            return archiveContents.at("dumps/" + record.archiveFileName);
+        }
+
+        void appendRegion(DumpArchive& dumpArchive, uint64_t uid)
+        {
+            auto record = dumpArchive.appendRecord(uid, chunks);
+            dumpArchive.appendIndexEntry(fmt::format(R"({{"Uid": {}, "DumpFileName": "region-{}", {} }})",
+                                                     uid,
+                                                     uid,
+                                                     DumpArchive::toJsonMembers(record)));
+        }
+
+        [[nodiscard]] std::vector<ArchiveIndexEntry> readIndex() const
+        {
+            std::istringstream index(indexContent);
+            std::size_t skippedLines = 0;
+            return DumpArchiveReader::readIndex(index, skippedLines);
+        }
+
+        std::vector<uint8_t> expectedDump() const
+        {
+            std::vector<uint8_t> dump(5 * pageSizeInBytes, 0);
+            std::ranges::copy(firstPage, dump.begin());
+            std::ranges::copy(secondPage, dump.begin() + 3 * pageSizeInBytes);
+            return dump;
+        }
+    };
+
+    TEST_F(DumpArchiveTestFixture, appendRecord_chunksWithHoles_onlyDataStoredAndDumpRestored)
+    {
+        auto dumpArchive = createDumpArchive();
+        appendRegion(dumpArchive, 0);
+        appendRegion(dumpArchive, 1);
+
+        std::istringstream index(indexContent);
+        std::size_t skippedLines = 0;
+        auto entries = DumpArchiveReader::readIndex(index, skippedLines);
+        ASSERT_EQ(entries.size(), 2);
+        std::istringstream archive(archiveContent(entries[0].record));
+        DumpArchiveReader reader(archive);
+
+        EXPECT_EQ(archive.str().size(), 2 * (DumpArchive::recordHeaderSize + 2 * pageSizeInBytes));
+        EXPECT_EQ(skippedLines, 0);
+        EXPECT_EQ(entries[1].dumpFileName, "region-1");
+        EXPECT_EQ(entries[1].record.archiveFileName, entries[0].record.archiveFileName);
+        EXPECT_EQ(entries[1].record.offset, DumpArchive::recordHeaderSize + 2 * pageSizeInBytes);
+        EXPECT_EQ(reader.readDump(entries[0].record), expectedDump());
+        EXPECT_EQ(reader.readDump(entries[1].record), expectedDump());
+    }
+
+    TEST_F(DumpArchiveTestFixture, readPayload_corruptedRecord_checksumMismatchReported)
+    {
+        auto dumpArchive = createDumpArchive();
+        appendRegion(dumpArchive, 0);
+
+        auto entries = readIndex();
+        ASSERT_EQ(entries.size(), 1);
+        archiveContent(entries[0].record)[DumpArchive::recordHeaderSize + 1] ^= 0x01;
+        std::istringstream archive(archiveContent(entries[0].record));
+        DumpArchiveReader reader(archive);
+
+        EXPECT_THROW(static_cast<void>(reader.readPayload(entries[0].record)), DumpArchiveException);
+    }
+
+    TEST_F(DumpArchiveTestFixture, appendRecord_archiveOfEarlierRunPresent_recordsWrittenToOwnArchiveFile)
+    {
+        auto earlierDumpArchive = createDumpArchive();
+        appendRegion(earlierDumpArchive, 0);
+        auto dumpArchive = createDumpArchive();
+        appendRegion(dumpArchive, 0);
+
+        auto entries = readIndex();
+        ASSERT_EQ(entries.size(), 2);
+        std::istringstream archive(archiveContent(entries[1].record));
+        DumpArchiveReader reader(archive);
+
+        EXPECT_NE(entries[1].record.archiveFileName, entries[0].record.archiveFileName);
+        EXPECT_EQ(entries[1].record.offset, 0);
+        EXPECT_EQ(reader.readDump(entries[1].record), expectedDump());
+    }
+
+    TEST_F(DumpArchiveTestFixture, appendRecord_failedWrite_recordNotIndexedAndFollowingRecordsInNewArchiveFile)
+    {
+        auto dumpArchive = createDumpArchive();
+        appendRegion(dumpArchive, 0);
+        EXPECT_CALL(pluginInterface, writeToFile(_, An<std::span<const FileChunk>>()))
+            .WillOnce(
+                [this](const std::string& archiveFile, Unused)
+                {
+                    // Only a part of the header has been written
+                    archiveContents[archiveFile].append(10, 'X');
+                    return false;
+                })
+            .WillRepeatedly(DoDefault());
+
+        EXPECT_THROW(appendRegion(dumpArchive, 1), DumpArchiveException);
+        appendRegion(dumpArchive, 2);
+
+        auto entries = readIndex();
+        ASSERT_EQ(entries.size(), 2);
+        std::istringstream archive(archiveContent(entries[1].record));
+        DumpArchiveReader reader(archive);
+        EXPECT_NE(entries[1].record.archiveFileName, entries[0].record.archiveFileName);
+        EXPECT_EQ(entries[1].record.uid, 2);
+        EXPECT_EQ(entries[1].record.offset, 0);
+        EXPECT_EQ(reader.readDump(entries[1].record), expectedDump());
+    }
+
+    TEST_F(DumpArchiveTestFixture, readPayload_recordMissingInArchive_throws)
+    {
+        auto dumpArchive = createDumpArchive();
+        appendRegion(dumpArchive, 0);
+        appendRegion(dumpArchive, 1);
+
+        auto entries = readIndex();
+        ASSERT_EQ(entries.size(), 2);
+        archiveContent(entries[0].record).resize(DumpArchive::recordHeaderSize + 2 * pageSizeInBytes);
+        std::istringstream archive(archiveContent(entries[0].record));
+        DumpArchiveReader reader(archive);
+
+        EXPECT_THROW(static_cast<void>(reader.readPayload(entries[1].record)), DumpArchiveException);
+    }
+
+    TEST_F(DumpArchiveTestFixture, readPayload_storedSizeBeyondArchive_throwsBeforeAllocating)
+    {
+        auto dumpArchive = createDumpArchive();
+        appendRegion(dumpArchive, 0);
+
+        auto entries = readIndex();
+        ASSERT_EQ(entries.size(), 1);
+        std::istringstream archive(archiveContent(entries[0].record));
+        DumpArchiveReader reader(archive);
+        auto record = entries[0].record;
+        record.storedSize = std::numeric_limits<uint64_t>::max() - DumpArchive::recordHeaderSize;
+
+        EXPECT_THROW(static_cast<void>(reader.readPayload(record)), DumpArchiveException);
+    }
+
+    TEST_F(DumpArchiveTestFixture, readIndex_partiallyWrittenLastLine_completeEntriesRead)
+    {
+        auto dumpArchive = createDumpArchive();
+        appendRegion(dumpArchive, 0);
+        appendRegion(dumpArchive, 1);
+        indexContent.resize(indexContent.size() - 20);
+
+        std::istringstream index(indexContent);
+        std::size_t skippedLines = 0;
+        auto entries = DumpArchiveReader::readIndex(index, skippedLines);
+
+        ASSERT_EQ(entries.size(), 1);
+        EXPECT_EQ(entries[0].dumpFileName, "region-0");
+        EXPECT_EQ(skippedLines, 1);
+    }
+
+#ifdef INMEMORYSCANNER_ZSTD_SUPPORT
+    TEST_F(DumpArchiveTestFixture, appendRecord_compressionActivated_compressedRecordRestored)
+    {
+        auto dumpArchive = createDumpArchive(3);
+        appendRegion(dumpArchive, 0);
+
+        auto entries = readIndex();
+        ASSERT_EQ(entries.size(), 1);
+        std::istringstream archive(archiveContent(entries[0].record));
+        DumpArchiveReader reader(archive);
+
+        EXPECT_EQ(entries[0].record.compression, DumpCompression::Zstd);
+        EXPECT_LT(entries[0].record.storedSize, 2 * pageSizeInBytes);
+        EXPECT_EQ(reader.readDump(entries[0].record), expectedDump());
+    }
+
+    TEST_F(DumpArchiveTestFixture, appendRecord_compressionBufferExceedsMemoryBudget_recordStoredUncompressed)
+    {
+        auto dumpArchive = createDumpArchive(3);
+        auto reservation = memoryBudget->tryAcquire(15 * pageSizeInBytes, AdmissionPriority::Normal);
+        appendRegion(dumpArchive, 0);
+
+        auto entries = readIndex();
+        ASSERT_EQ(entries.size(), 1);
+        std::istringstream archive(archiveContent(entries[0].record));
+        DumpArchiveReader reader(archive);
+
+        EXPECT_EQ(entries[0].record.compression, DumpCompression::None);
+        EXPECT_EQ(reader.readDump(entries[0].record), expectedDump());
+    }
+#else
+    TEST_F(DumpArchiveTestFixture, constructor_compressionWithoutZstdSupport_throws)
+    {
+        EXPECT_THROW(static_cast<void>(createDumpArchive(3)), DumpArchiveException);
+    }
+#endif
+}
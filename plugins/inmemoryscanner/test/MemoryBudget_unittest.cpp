@@ -0,0 +1,141 @@
+#include <MemoryBudget.h>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace InMemoryScanner
+{
+    TEST(MemoryBudgetTest, tryAcquire_limitExceeded_requestRejected)
+    {
+        MemoryBudget memoryBudget(100);
+        auto reservation = memoryBudget.tryAcquire(60, AdmissionPriority::Normal);
+
+        EXPECT_EQ(memoryBudget.tryAcquire(60, AdmissionPriority::Normal), nullptr);
+        EXPECT_EQ(memoryBudget.getStatistics().rejectedRequests, 1);
+    }
+
+    TEST(MemoryBudgetTest, tryAcquire_reservationReleased_memoryAvailableAgain)
+    {
+        MemoryBudget memoryBudget(100);
+        memoryBudget.tryAcquire(100, AdmissionPriority::Normal).reset();
+
+        EXPECT_NE(memoryBudget.tryAcquire(100, AdmissionPriority::Normal), nullptr);
+        EXPECT_EQ(memoryBudget.getStatistics().peakBytes, 100);
+    }
+
+    TEST(MemoryBudgetTest, acquire_requestExceedingLimitOnItsOwn_admittedAsOvercommitted)
+    {
+        MemoryBudget memoryBudget(100);
+
+        auto reservation = memoryBudget.acquire(200, AdmissionPriority::Normal, nullptr);
+
+        EXPECT_EQ(memoryBudget.getStatistics().overcommittedAdmissions, 1);
+        EXPECT_EQ(memoryBudget.getStatistics().delayedAdmissions, 0);
+    }
+
+    TEST(MemoryBudgetTest, acquire_pendingWorkReleasesMemory_admittedWithWaitTime)
+    {
+        MemoryBudget memoryBudget(100);
+        auto pendingReservation = memoryBudget.tryAcquire(100, AdmissionPriority::Normal);
+
+        auto reservation = memoryBudget.acquire(100,
+                                                AdmissionPriority::Normal,
+                                                [&pendingReservation]()
+                                                {
+                                                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                                                    pendingReservation.reset();
+                                                    return true;
+                                                });
+
+        auto statistics = memoryBudget.getStatistics();
+        EXPECT_EQ(pendingReservation, nullptr);
+        EXPECT_EQ(statistics.delayedAdmissions, 1);
+        EXPECT_EQ(statistics.overcommittedAdmissions, 0);
+        EXPECT_GE(statistics.maxWaitTime, std::chrono::milliseconds(10));
+    }
+
+    TEST(MemoryBudgetTest, acquire_memoryReleasedByOtherThread_waitingRequestAdmitted)
+    {
+        MemoryBudget memoryBudget(100);
+        auto otherReservation = memoryBudget.tryAcquire(100, AdmissionPriority::Normal);
+        std::thread otherThread(
+            [&otherReservation]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                otherReservation.reset();
+            });
+
+        auto reservation = memoryBudget.acquire(100, AdmissionPriority::Normal, nullptr);
+        otherThread.join();
+
+        EXPECT_EQ(memoryBudget.getStatistics().overcommittedAdmissions, 0);
+    }
+
+    TEST(MemoryBudgetTest, acquire_noPendingWorkForLongerThanPollInterval_waitsWithoutOvercommit)
+    {
+        MemoryBudget memoryBudget(100);
+        auto otherReservation = memoryBudget.tryAcquire(100, AdmissionPriority::Normal);
+        std::atomic<std::size_t> pendingWorkCalls = 0;
+        std::thread otherThread(
+            [&otherReservation]()
+            {
+                std::this_thread::sleep_for(10 * MemoryBudget::pendingWorkPollInterval);
+                otherReservation.reset();
+            });
+
+        auto reservation = memoryBudget.acquire(100,
+                                                AdmissionPriority::Normal,
+                                                [&pendingWorkCalls]()
+                                                {
+                                                    pendingWorkCalls++;
+                                                    return false;
+                                                });
+        otherThread.join();
+
+        EXPECT_EQ(memoryBudget.getStatistics().overcommittedAdmissions, 0);
+        EXPECT_GT(pendingWorkCalls, 1);
+    }
+
+    TEST(MemoryBudgetTest, acquire_urgentRequestWaiting_normalRequestHeldBack)
+    {
+        MemoryBudget memoryBudget(100);
+        auto pendingReservation = memoryBudget.tryAcquire(80, AdmissionPriority::Normal);
+        std::unique_ptr<MemoryBudget::Reservation> normalReservation;
+
+        auto urgentReservation = memoryBudget.acquire(50,
+                                                      AdmissionPriority::Urgent,
+                                                      [&memoryBudget, &pendingReservation, &normalReservation]()
+                                                      {
+                                                          normalReservation =
+                                                              memoryBudget.tryAcquire(10, AdmissionPriority::Normal);
+                                                          pendingReservation.reset();
+                                                          return true;
+                                                      });
+
+        EXPECT_EQ(normalReservation, nullptr);
+        EXPECT_NE(memoryBudget.tryAcquire(10, AdmissionPriority::Normal), nullptr);
+    }
+
+    TEST(MemoryBudgetTest, shrink_reservationShrunk_excessBytesAvailableAgain)
+    {
+        MemoryBudget memoryBudget(100);
+        auto reservation = memoryBudget.tryAcquire(100, AdmissionPriority::Normal);
+
+        reservation->shrink(40);
+
+        EXPECT_NE(memoryBudget.tryAcquire(60, AdmissionPriority::Normal), nullptr);
+        reservation.reset();
+        EXPECT_NE(memoryBudget.tryAcquire(100, AdmissionPriority::Normal), nullptr);
+    }
+
+    TEST(MemoryBudgetTest, acquire_budgetOnlyUsedByHeldBytes_admittedAsOvercommitted)
+    {
+        MemoryBudget memoryBudget(100);
+        auto heldReservation = memoryBudget.tryAcquire(80, AdmissionPriority::Normal);
+
+        auto reservation = memoryBudget.acquire(50, AdmissionPriority::Urgent, nullptr, 80);
+
+        EXPECT_EQ(memoryBudget.getStatistics().overcommittedAdmissions, 1);
+        EXPECT_EQ(memoryBudget.getStatistics().delayedAdmissions, 0);
+    }
+}
@@ -0,0 +1,86 @@
+#include <OutputXML.h>
+#include <ResultsWriter.h>
+#include <future>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vmicore_test/plugins/mock_PluginInterface.h>
+
+using testing::_;
+using testing::An;
+using testing::NiceMock;
+using testing::Unused;
+using VmiCore::Plugin::MockPluginInterface;
+
+namespace InMemoryScanner
+{
+    namespace
+    {
+        const std::vector<Rule> testResults{{"rule", "namespace", {{"$first", 0x10}, {"$second", 0x20}}},
+                                            {"otherRule", "namespace", {{"$string", 0x30}}}};
+    }
+
+    TEST(ResultsWriterTest, flush_bufferedResult_appendedAsJsonLine)
+    {
+        NiceMock<MockPluginInterface> pluginInterface;
+        ResultsWriter resultsWriter(&pluginInterface, "results.jsonl", std::chrono::hours(1));
+        resultsWriter.addResult("proc.exe", 4, 0x1000, {{"rule", "namespace", {{"$string", 0x10}}}});
+
+        EXPECT_CALL(pluginInterface,
+                    writeToFile("results.jsonl",
+                                 R"({"ProcessName": "proc.exe", "ProcessId": 4, "BaseAddress": "1000", "Rules": [)"
+                                 R"({"Namespace": "namespace", "Name": "rule", "Matches": [)"
+                                 R"({"Name": "$string", "Position": 16}]}]})"
+                                 "\n"))
+            .Times(1);
+        resultsWriter.flush();
+    }
+
+    TEST(ResultsWriterTest, addResult_noExplicitFlush_resultFlushedInBackground)
+    {
+        NiceMock<MockPluginInterface> pluginInterface;
+        std::promise<void> appended;
+        EXPECT_CALL(pluginInterface, writeToFile("results.jsonl", An<const std::string&>()))
+            .WillOnce([&appended]() { appended.set_value(); });
+        ResultsWriter resultsWriter(&pluginInterface, "results.jsonl", std::chrono::milliseconds(10));
+
+        resultsWriter.addResult("proc.exe", 4, 0x1000, testResults);
+
+        EXPECT_EQ(appended.get_future().wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    }
+
+    TEST(ResultsWriterTest, destructor_bufferedResults_resultsFlushed)
+    {
+        NiceMock<MockPluginInterface> pluginInterface;
+        std::string content;
+        ON_CALL(pluginInterface, writeToFile("results.jsonl", An<const std::string&>()))
+            .WillByDefault([&content](Unused, const std::string& appendedContent) { content += appendedContent; });
+
+        {
+            ResultsWriter resultsWriter(&pluginInterface, "results.jsonl", std::chrono::hours(1));
+            resultsWriter.addResult("first.exe", 4, 0x1000, testResults);
+            resultsWriter.addResult("second.exe", 8, 0x2000, testResults);
+        }
+
+        EXPECT_EQ(content,
+                  ResultsWriter::toJsonLine("first.exe", 4, 0x1000, testResults) +
+                      ResultsWriter::toJsonLine("second.exe", 8, 0x2000, testResults));
+    }
+
+    TEST(ResultsWriterTest, addResults_streamedResults_xmlIdenticalToDirectlyAddedResults)
+    {
+        std::string processName = R"(C:\path "with" quotes)";
+        std::stringstream jsonLines(ResultsWriter::toJsonLine(processName, 4, 0x1000, testResults) +
+                                    ResultsWriter::toJsonLine("proc.exe", 8, 0x2000, {}) +
+                                    R"({"ProcessName": "trunc)");
+        OutputXML expectedXml;
+        expectedXml.addResult(processName, 4, 0x1000, testResults);
+        expectedXml.addResult("proc.exe", 8, 0x2000, {});
+        OutputXML outputXml;
+
+        auto skippedLines = outputXml.addResults(jsonLines);
+
+        EXPECT_EQ(skippedLines, 1);
+        EXPECT_EQ(*outputXml.getString(), *expectedXml.getString());
+    }
+}
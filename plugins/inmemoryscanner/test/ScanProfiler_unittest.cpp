@@ -0,0 +1,94 @@
+#include <ScanProfiler.h>
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using testing::HasSubstr;
+using testing::Not;
+
+namespace InMemoryScanner
+{
+    namespace
+    {
+        Rule createRule(const std::string& ruleName, const std::vector<std::string>& matchNames)
+        {
+            Rule rule{.ruleName = ruleName, .ruleNamespace = "default", .matches = {}};
+            for (const auto& matchName : matchNames)
+            {
+                rule.matches.push_back({.matchName = matchName, .position = 0});
+            }
+            return rule;
+        }
+    }
+
+    TEST(ScanProfilerTest, createReport_multipleMatches_rulesSortedByMatchCount)
+    {
+        ScanProfiler scanProfiler("rules.yarc");
+        scanProfiler.recordRegionScan(
+            "proc", 1, 0x1000, 0x1000, std::chrono::milliseconds(1), {createRule("rare", {"$a"})});
+        scanProfiler.recordRegionScan("proc",
+                                      1,
+                                      0x2000,
+                                      0x1000,
+                                      std::chrono::milliseconds(1),
+                                      {createRule("frequent", {"$b", "$b"})});
+        scanProfiler.recordRegionScan(
+            "proc", 1, 0x3000, 0x1000, std::chrono::milliseconds(1), {createRule("frequent", {"$b"})});
+
+        auto report = scanProfiler.createReport({});
+
+        EXPECT_THAT(report, HasSubstr("Rule set: rules.yarc"));
+        EXPECT_LT(report.find("default:frequent\n"), report.find("default:rare\n"));
+        EXPECT_THAT(report, HasSubstr("3  default:frequent:$b"));
+        EXPECT_THAT(report, Not(HasSubstr("Rule costs reported by libyara")));
+    }
+
+    TEST(ScanProfilerTest, createReport_ruleCosts_costsListedInGivenOrder)
+    {
+        ScanProfiler scanProfiler("rules.yarc");
+
+        auto report = scanProfiler.createReport(
+            {{.ruleNamespace = "default", .ruleName = "expensive", .cost = 500},
+             {.ruleNamespace = "default", .ruleName = "cheap", .cost = 5}});
+
+        EXPECT_THAT(report, HasSubstr("Rule costs reported by libyara"));
+        EXPECT_LT(report.find("500  default:expensive"), report.find("5  default:cheap"));
+    }
+
+    TEST(ScanProfilerTest, createReport_timeout_slowestRegionFirstAndMarked)
+    {
+        ScanProfiler scanProfiler("rules.yarc");
+        scanProfiler.recordRegionScan("fast.exe", 1, 0x1000, 0x1000, std::chrono::milliseconds(1), {});
+        scanProfiler.recordTimeout("slow.exe", 2, 0x2000, 0x1000, std::chrono::seconds(10));
+
+        auto report = scanProfiler.createReport({});
+
+        EXPECT_THAT(report, HasSubstr("Scanned regions: 2, scanned bytes: 8192"));
+        EXPECT_THAT(report, HasSubstr("timeouts: 1"));
+        EXPECT_THAT(report, HasSubstr("slow.exe (timeout)"));
+        EXPECT_LT(report.find("slow.exe"), report.find("fast.exe"));
+    }
+
+    TEST(ScanProfilerTest, createReport_moreRegionsThanReported_totalsOfAllAndOnlySlowestListed)
+    {
+        ScanProfiler scanProfiler("rules.yarc");
+        const auto regionCount = 2 * ScanProfiler::maxReportedRegions;
+        for (std::size_t i = 0; i < regionCount; i++)
+        {
+            // Alternate between fast and slow regions, so that the retained regions have to be replaced
+            auto duration = i % 2 == 0 ? std::chrono::milliseconds(i) : std::chrono::milliseconds(1000 + i);
+            scanProfiler.recordRegionScan(
+                fmt::format("process{}.exe", i), static_cast<VmiCore::pid_t>(i), 0x1000, 0x10, duration, {});
+        }
+
+        auto report = scanProfiler.createReport({});
+
+        EXPECT_THAT(report,
+                    HasSubstr(fmt::format("Scanned regions: {}, scanned bytes: {}", regionCount, regionCount * 0x10)));
+        EXPECT_THAT(report, HasSubstr(fmt::format("process{}.exe\n", regionCount - 1)));
+        EXPECT_THAT(report, HasSubstr("process1.exe\n"));
+        EXPECT_THAT(report, Not(HasSubstr("process0.exe\n")));
+        EXPECT_THAT(report, Not(HasSubstr(fmt::format("process{}.exe\n", regionCount - 2))));
+        EXPECT_LT(report.find(fmt::format("process{}.exe", regionCount - 1)), report.find("process1.exe\n"));
+    }
+}
@@ -0,0 +1,107 @@
+#include <ScanResultCache.h>
+#include <gtest/gtest.h>
+
+using VmiCore::addr_t;
+using VmiCore::MappedRegion;
+using VmiCore::PagingDefinitions::pageSizeInBytes;
+
+namespace InMemoryScanner
+{
+    class ScanResultCacheFixture : public testing::Test
+    {
+      protected:
+        const addr_t regionBase = 0x10000;
+        const addr_t otherRegionBase = 0x50000;
+        std::vector<uint8_t> pages = std::vector<uint8_t>(2 * pageSizeInBytes, 0xCA);
+        ScanResultCache scanResultCache{2};
+    };
+
+    TEST_F(ScanResultCacheFixture, lookup_identicalContentAtOtherBase_matchPositionsRebased)
+    {
+        std::vector<MappedRegion> mappedRegions{{regionBase, pages}};
+        std::vector<Rule> results{{"rule", "namespace", {{"$string", static_cast<int64_t>(regionBase + 0x10)}}}};
+        scanResultCache.insert(scanResultCache.createFingerprint(regionBase, mappedRegions), regionBase, results);
+        std::vector<MappedRegion> otherMappedRegions{{otherRegionBase, pages}};
+
+        auto otherFingerprint = scanResultCache.createFingerprint(otherRegionBase, otherMappedRegions);
+
+        auto cachedResults = scanResultCache.lookup(otherFingerprint, otherRegionBase);
+
+        ASSERT_TRUE(cachedResults.has_value());
+        auto expectedPosition = static_cast<int64_t>(otherRegionBase + 0x10);
+        EXPECT_EQ(*cachedResults, (std::vector<Rule>{{"rule", "namespace", {{"$string", expectedPosition}}}}));
+        EXPECT_EQ(scanResultCache.getSkippedBytes(), pages.size());
+    }
+
+    TEST_F(ScanResultCacheFixture, createFingerprint_singleByteChanged_differentFingerprint)
+    {
+        std::vector<MappedRegion> mappedRegions{{regionBase, pages}};
+        auto fingerprint = scanResultCache.createFingerprint(regionBase, mappedRegions);
+
+        pages.back() = 0;
+
+        EXPECT_NE(scanResultCache.createFingerprint(regionBase, mappedRegions), fingerprint);
+    }
+
+    TEST_F(ScanResultCacheFixture, createFingerprint_sameContentAtOtherOffsetWithinRegion_differentFingerprint)
+    {
+        std::vector<MappedRegion> mappedRegions{{regionBase, pages}};
+        std::vector<MappedRegion> shiftedMappedRegions{{regionBase + pageSizeInBytes, pages}};
+
+        EXPECT_NE(scanResultCache.createFingerprint(regionBase, mappedRegions),
+                  scanResultCache.createFingerprint(regionBase, shiftedMappedRegions));
+    }
+
+    TEST_F(ScanResultCacheFixture, insert_capacityExceeded_leastRecentlyUsedEntryEvicted)
+    {
+        std::vector<uint8_t> otherPages(pageSizeInBytes, 1);
+        std::vector<uint8_t> thirdPages(pageSizeInBytes, 2);
+        std::vector<MappedRegion> mappedRegions{{regionBase, pages}};
+        std::vector<MappedRegion> otherMappedRegions{{regionBase, otherPages}};
+        std::vector<MappedRegion> thirdMappedRegions{{regionBase, thirdPages}};
+        auto fingerprint = scanResultCache.createFingerprint(regionBase, mappedRegions);
+        auto otherFingerprint = scanResultCache.createFingerprint(regionBase, otherMappedRegions);
+        auto thirdFingerprint = scanResultCache.createFingerprint(regionBase, thirdMappedRegions);
+        scanResultCache.insert(fingerprint, regionBase, {});
+        scanResultCache.insert(otherFingerprint, regionBase, {});
+        ASSERT_TRUE(scanResultCache.lookup(fingerprint, regionBase).has_value());
+
+        scanResultCache.insert(thirdFingerprint, regionBase, {});
+
+        EXPECT_TRUE(scanResultCache.lookup(fingerprint, regionBase).has_value());
+        EXPECT_FALSE(scanResultCache.lookup(otherFingerprint, regionBase).has_value());
+        EXPECT_TRUE(scanResultCache.lookup(thirdFingerprint, regionBase).has_value());
+    }
+
+    TEST_F(ScanResultCacheFixture, lookupImage_manyRegionsInsertedAfterImage_imageResultsReused)
+    {
+        const ImageIdentity imageIdentity{.moduleName = "\\Windows\\System32\\svchost.exe", .size = pages.size()};
+        std::vector<MappedRegion> mappedRegions{{regionBase, pages}};
+        auto fingerprint = scanResultCache.createFingerprint(regionBase, mappedRegions);
+        scanResultCache.insertImage(imageIdentity, fingerprint, regionBase, {});
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            std::vector<uint8_t> otherPages(pageSizeInBytes, i);
+            std::vector<MappedRegion> otherMappedRegions{{regionBase, otherPages}};
+            scanResultCache.insert(scanResultCache.createFingerprint(regionBase, otherMappedRegions), regionBase, {});
+        }
+
+        EXPECT_TRUE(scanResultCache.lookupImage(imageIdentity, fingerprint, otherRegionBase).has_value());
+        EXPECT_EQ(scanResultCache.getImageHitCount(), 1);
+    }
+
+    TEST_F(ScanResultCacheFixture, lookupImage_modifiedImage_noResults)
+    {
+        const ImageIdentity imageIdentity{.moduleName = "\\Windows\\System32\\svchost.exe", .size = pages.size()};
+        std::vector<MappedRegion> mappedRegions{{regionBase, pages}};
+        scanResultCache.insertImage(
+            imageIdentity, scanResultCache.createFingerprint(regionBase, mappedRegions), regionBase, {});
+
+        pages.front() = 0x90;
+
+        EXPECT_FALSE(
+            scanResultCache
+                .lookupImage(imageIdentity, scanResultCache.createFingerprint(regionBase, mappedRegions), regionBase)
+                .has_value());
+    }
+}
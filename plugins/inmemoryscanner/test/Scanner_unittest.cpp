@@ -1,4 +1,3 @@
-#include "FakeYaraInterface.h"
 #include "mock_Config.h"
 #include "mock_Dumping.h"
 #include "mock_YaraInterface.h"
@@ -6,28 +5,37 @@
 #include <fmt/core.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <sstream>
 #include <vmicore/os/PagingDefinitions.h>
 #include <vmicore_test/io/mock_Logger.h>
 #include <vmicore_test/os/mock_MemoryRegionExtractor.h>
 #include <vmicore_test/os/mock_PageProtection.h>
 #include <vmicore_test/plugins/mock_PluginInterface.h>
+#include <vmicore_test/threading/mock_TaskHandle.h>
 #include <vmicore_test/vmi/mock_MemoryMapping.h>
 
 using testing::_;
+using testing::AllOf;
 using testing::An;
 using testing::AnyNumber;
 using testing::ByMove;
 using testing::ContainsRegex;
+using testing::EndsWith;
+using testing::HasSubstr;
+using testing::Matcher;
 using testing::NiceMock;
 using testing::Return;
+using testing::StartsWith;
 using testing::Unused;
 using VmiCore::ActiveProcessInformation;
 using VmiCore::addr_t;
+using VmiCore::FileChunk;
 using VmiCore::MappedRegion;
 using VmiCore::MemoryRegion;
 using VmiCore::MockLogger;
 using VmiCore::MockMemoryRegionExtractor;
 using VmiCore::MockPageProtection;
+using VmiCore::MockTaskHandle;
 using VmiCore::pid_t;
 using VmiCore::PagingDefinitions::pageSizeInBytes;
 using VmiCore::Plugin::MockPluginInterface;
@@ -52,7 +60,9 @@ namespace InMemoryScanner
         std::string protectionAsString = "RWX";
 
         std::filesystem::path inMemoryDumpsPath = "inMemDumps";
-        std::filesystem::path dumpedRegionsPath = inMemoryDumpsPath / "dumpedRegions";
+        Matcher<const std::string&> dumpArchivePath =
+            AllOf(StartsWith((inMemoryDumpsPath / "dumpedRegions-").string()), EndsWith(".pack"));
+        std::filesystem::path dumpIndexPath = inMemoryDumpsPath / "dumpedRegions.jsonl";
         addr_t startAddress = 0x1234000;
         size_t size = pageSizeInBytes;
         std::vector<uint8_t> testPageContent = std::vector<uint8_t>(size, 1);
@@ -66,6 +76,17 @@ namespace InMemoryScanner
                 .WillByDefault([]() { return std::make_unique<NiceMock<MockLogger>>(); });
             ON_CALL(*configuration, getOutputPath())
                 .WillByDefault([inMemoryDumpsPath = inMemoryDumpsPath]() { return inMemoryDumpsPath; });
+            ON_CALL(*configuration, getInFlightMemoryLimit()).WillByDefault(Return(256 * pageSizeInBytes));
+            ON_CALL(*pluginInterface, writeToFile(_, An<std::span<const FileChunk>>())).WillByDefault(Return(true));
+            ON_CALL(*pluginInterface, submitTask(_))
+                .WillByDefault(
+                    [](const std::function<void(std::stop_token)>& function)
+                    {
+                        function(std::stop_token{});
+                        auto taskHandle = std::make_shared<NiceMock<MockTaskHandle>>();
+                        ON_CALL(*taskHandle, isDone()).WillByDefault(Return(true));
+                        return taskHandle;
+                    });
 
             runningProcesses = std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>();
             auto m1 = std::make_unique<MockMemoryRegionExtractor>();
@@ -99,6 +120,11 @@ namespace InMemoryScanner
             createMemoryMapping(dtbWithSharedBaseImageRegion, startAddress, bytesToNumberOfPages(size), regionMappings);
         }
 
+        [[nodiscard]] std::shared_ptr<MemoryBudget> createMemoryBudget() const
+        {
+            return std::make_shared<MemoryBudget>(configuration->getInFlightMemoryLimit());
+        }
+
         std::shared_ptr<const ActiveProcessInformation> getProcessInfoFromRunningProcesses(pid_t pid)
         {
             return *std::find_if(runningProcesses->cbegin(),
@@ -107,6 +133,21 @@ namespace InMemoryScanner
                                  { return a->pid == pid; });
         }
 
+        /// Defers submitted tasks until they are waited for, in order to make the pipeline stages observable.
+        void setupDeferredTasks()
+        {
+            ON_CALL(*pluginInterface, submitTask(_))
+                .WillByDefault(
+                    [](const std::function<void(std::stop_token)>& function)
+                    {
+                        auto taskHandle = std::make_shared<NiceMock<MockTaskHandle>>();
+                        ON_CALL(*taskHandle, wait())
+                            .WillByDefault([deferredFunction = function]() mutable
+                                           { std::exchange(deferredFunction, nullptr)(std::stop_token{}); });
+                        return taskHandle;
+                    });
+        }
+
         void
         createMemoryMapping(addr_t dtb, addr_t baseVA, std::size_t numberOfPages, std::span<MappedRegion> mappedRegions)
         {
@@ -135,7 +176,8 @@ namespace InMemoryScanner
             dumpingRawPointer = dumping.get();
             auto yara = std::make_unique<NiceMock<MockYaraInterface>>();
             ON_CALL(*yara, scanMemory(_)).WillByDefault(Return(std::vector<Rule>{}));
-            scanner.emplace(pluginInterface.get(), configuration, std::move(yara), std::move(dumping));
+            scanner.emplace(
+                pluginInterface.get(), configuration, std::move(yara), std::move(dumping), createMemoryBudget());
         };
     };
 
@@ -155,26 +197,28 @@ namespace InMemoryScanner
             ON_CALL(*configuration, isDumpingMemoryActivated()).WillByDefault(Return(true));
             ON_CALL(*dynamic_cast<MockPageProtection*>(memoryRegionDescriptor.protection.get()), toString())
                 .WillByDefault(Return(protectionAsString));
-            ON_CALL(*systemMemoryRegionExtractorRaw, extractAllMemoryRegions())
+            ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
                 .WillByDefault(
                     [&memoryRegionDescriptor = memoryRegionDescriptor]()
                     {
-                        auto memoryRegions = std::make_unique<std::vector<MemoryRegion>>();
+                        auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
                         memoryRegions->push_back(std::move(memoryRegionDescriptor));
                         return memoryRegions;
                     });
-            ON_CALL(*sharedBaseImageMemoryRegionExtractorRaw, extractAllMemoryRegions())
+            ON_CALL(*sharedBaseImageMemoryRegionExtractorRaw, getMemoryRegions())
                 .WillByDefault(
                     [&memoryRegionDescriptorForSharedMemory = memoryRegionDescriptorForSharedMemory]()
                     {
-                        auto memoryRegions = std::make_unique<std::vector<MemoryRegion>>();
+                        auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
                         memoryRegions->push_back(std::move(memoryRegionDescriptorForSharedMemory));
                         return memoryRegions;
                     });
-            auto dumping = std::make_unique<Dumping>(pluginInterface.get(), configuration);
+            auto memoryBudget = createMemoryBudget();
+            auto dumping = std::make_unique<Dumping>(pluginInterface.get(), configuration, memoryBudget);
             auto yara = std::make_unique<NiceMock<MockYaraInterface>>();
             ON_CALL(*yara, scanMemory(_)).WillByDefault(Return(std::vector<Rule>{}));
-            scanner.emplace(pluginInterface.get(), configuration, std::move(yara), std::move(dumping));
+            scanner.emplace(
+                pluginInterface.get(), configuration, std::move(yara), std::move(dumping), std::move(memoryBudget));
         };
 
         std::string getMemFileName(std::string& trimmedProcessName, pid_t pid)
@@ -189,6 +233,37 @@ namespace InMemoryScanner
         }
     };
 
+    class ScannerTestFixtureAsyncTerminationScan : public ScannerTestBaseFixture
+    {
+      protected:
+        MockYaraInterface* yaraRawPointer{};
+        MockDumping* dumpingRawPointer{};
+        std::shared_ptr<MemoryBudget> memoryBudget;
+
+        void setupScanner(std::size_t asyncScanMemoryLimit)
+        {
+            ON_CALL(*configuration, isDumpingMemoryActivated()).WillByDefault(Return(false));
+            ON_CALL(*configuration, isAsyncTerminationScanActivated()).WillByDefault(Return(true));
+            ON_CALL(*configuration, getAsyncScanQueueSize()).WillByDefault(Return(1));
+            ON_CALL(*configuration, getAsyncScanMemoryLimit()).WillByDefault(Return(asyncScanMemoryLimit));
+            ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
+                .WillByDefault(
+                    [startAddress = startAddress, size = size]()
+                    {
+                        auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                        memoryRegions->emplace_back(
+                            startAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
+                        return memoryRegions;
+                    });
+            auto yara = std::make_unique<NiceMock<MockYaraInterface>>();
+            yaraRawPointer = yara.get();
+            auto dumping = std::make_unique<NiceMock<MockDumping>>();
+            dumpingRawPointer = dumping.get();
+            memoryBudget = createMemoryBudget();
+            scanner.emplace(pluginInterface.get(), configuration, std::move(yara), std::move(dumping), memoryBudget);
+        }
+    };
+
     std::vector<uint8_t> constructPaddedRegion(const std::initializer_list<std::vector<uint8_t>>& list)
     {
         std::vector<uint8_t> paddedRegion{};
@@ -204,11 +279,11 @@ namespace InMemoryScanner
 
     TEST_F(ScannerTestFixtureDumpingDisabled, scanProcess_smallMemoryRegion_originalReadMemoryRegionSize)
     {
-        ON_CALL(*systemMemoryRegionExtractorRaw, extractAllMemoryRegions())
+        ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
             .WillByDefault(
                 [startAddress = startAddress, size = size]()
                 {
-                    auto memoryRegions = std::make_unique<std::vector<MemoryRegion>>();
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
                     memoryRegions->emplace_back(
                         startAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
                     return memoryRegions;
@@ -229,11 +304,11 @@ namespace InMemoryScanner
 
     TEST_F(ScannerTestFixtureDumpingDisabled, scanProcess_disabledDumping_dumpingNotCalled)
     {
-        ON_CALL(*systemMemoryRegionExtractorRaw, extractAllMemoryRegions())
+        ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
             .WillByDefault(
                 [startAddress = startAddress, size = size]()
                 {
-                    auto memoryRegions = std::make_unique<std::vector<MemoryRegion>>();
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
                     memoryRegions->emplace_back(
                         startAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
                     return memoryRegions;
@@ -263,11 +338,11 @@ namespace InMemoryScanner
                                      std::move(memoryRegionExtractor),
                                      false});
         // Redefine default mock return because a new MemoryRegionExtractor mock has been created
-        ON_CALL(*memoryRegionExtractorRaw, extractAllMemoryRegions())
+        ON_CALL(*memoryRegionExtractorRaw, getMemoryRegions())
             .WillByDefault(
                 [&memoryRegionDescriptor = memoryRegionDescriptor]()
                 {
-                    auto memoryRegions = std::make_unique<std::vector<MemoryRegion>>();
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
                     memoryRegions->push_back(std::move(memoryRegionDescriptor));
                     return memoryRegions;
                 });
@@ -278,14 +353,50 @@ namespace InMemoryScanner
                                                  startAddress,
                                                  startAddress + size,
                                                  uidRegEx);
-        auto expectedFileNameWithPathRegEx = "^" + (dumpedRegionsPath / expectedFileNameRegEx).string() + "$";
         createMemoryMapping(dtb, startAddress, bytesToNumberOfPages(size), regionMappings);
 
         EXPECT_CALL(*pluginInterface,
-                    writeToFile(ContainsRegex(expectedFileNameWithPathRegEx), An<const std::vector<uint8_t>&>()));
+                    writeToFile(dumpIndexPath.string(),
+                                 testing::Matcher<const std::string&>(
+                                     ContainsRegex(fmt::format(R"("DumpFileName": "{}")", expectedFileNameRegEx)))));
         EXPECT_NO_THROW(scanner->scanProcess(processWithLongName));
     }
 
+    TEST_F(ScannerTestFixtureDumpingEnabled, scanProcess_processNameWithJsonSpecialCharacters_indexEntryEscaped)
+    {
+        std::string processName = R"(a"b\c)";
+        pid_t pid = 123;
+        addr_t dtb = 0x4444;
+        auto memoryRegionExtractor = std::make_unique<MockMemoryRegionExtractor>();
+        auto* memoryRegionExtractorRaw = memoryRegionExtractor.get();
+        auto processWithSpecialName = std::make_shared<const ActiveProcessInformation>(
+            ActiveProcessInformation{0,
+                                     dtb,
+                                     dtb,
+                                     pid,
+                                     0,
+                                     processName,
+                                     std::make_unique<std::string>(processName),
+                                     std::make_unique<std::string>(),
+                                     std::move(memoryRegionExtractor),
+                                     false});
+        ON_CALL(*memoryRegionExtractorRaw, getMemoryRegions())
+            .WillByDefault(
+                [&memoryRegionDescriptor = memoryRegionDescriptor]()
+                {
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                    memoryRegions->push_back(std::move(memoryRegionDescriptor));
+                    return memoryRegions;
+                });
+        createMemoryMapping(dtb, startAddress, bytesToNumberOfPages(size), regionMappings);
+
+        EXPECT_CALL(*pluginInterface,
+                    writeToFile(dumpIndexPath.string(),
+                                Matcher<const std::string&>(AllOf(HasSubstr(R"("ProcessName": "a\"b\\c")"),
+                                                                  HasSubstr(R"("DumpFileName": "a\"b\\c-123-)")))));
+        EXPECT_NO_THROW(scanner->scanProcess(processWithSpecialName));
+    }
+
     TEST_F(ScannerTestFixtureDumpingEnabled, scanProcess_shortProcessName_memoryDumpWrittenWithOriginalName)
     {
         auto processWithShortName = getProcessInfoFromRunningProcesses(testPid);
@@ -297,57 +408,439 @@ namespace InMemoryScanner
                                                  startAddress,
                                                  startAddress + size,
                                                  uidRegEx);
-        auto expectedFileNameWithPathRegEx = "^" + (dumpedRegionsPath / expectedFileNameRegEx).string() + "$";
 
         EXPECT_CALL(*pluginInterface,
-                    writeToFile(ContainsRegex(expectedFileNameWithPathRegEx), An<const std::vector<uint8_t>&>()));
+                    writeToFile(dumpIndexPath.string(),
+                                 testing::Matcher<const std::string&>(
+                                     ContainsRegex(fmt::format(R"("DumpFileName": "{}")", expectedFileNameRegEx)))));
         EXPECT_NO_THROW(scanner->scanProcess(processWithShortName));
     }
 
-    TEST_F(ScannerTestFixtureDumpingDisabled,
-           scanAllProcesses_MoreScanningThreadThanAllowedByYara_ThreadLimitNotExceeded)
+    TEST_F(ScannerTestFixtureDumpingDisabled, scanProcess_inFlightMemoryLimitNotReached_nextRegionMappedBeforeScan)
     {
-        auto yaraFake = std::make_unique<FakeYaraInterface>();
-        auto* yaraFakeRaw = yaraFake.get();
-        scanner.emplace(
-            pluginInterface.get(), configuration, std::move(yaraFake), std::make_unique<NiceMock<MockDumping>>());
-        auto memoryRegionExtractor = std::make_unique<MockMemoryRegionExtractor>();
-        auto* memoryRegionExtractorRaw = memoryRegionExtractor.get();
-        auto processInfo = std::make_shared<ActiveProcessInformation>(
-            ActiveProcessInformation{0,
-                                     testDtb,
-                                     testDtb,
-                                     testPid,
-                                     0,
-                                     "System.exe",
-                                     std::make_unique<std::string>("System.exe"),
-                                     std::make_unique<std::string>(""),
-                                     std::move(memoryRegionExtractor),
-                                     false});
-        ON_CALL(*pluginInterface, getRunningProcesses())
+        setupDeferredTasks();
+        const addr_t secondStartAddress = startAddress + 2 * size;
+        ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
+            .WillByDefault(
+                [startAddress = startAddress, secondStartAddress, size = size]()
+                {
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                    memoryRegions->emplace_back(
+                        startAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
+                    memoryRegions->emplace_back(
+                        secondStartAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
+                    return memoryRegions;
+                });
+        auto yara = std::make_unique<NiceMock<MockYaraInterface>>();
+        auto* yaraRawPointer = yara.get();
+        scanner.emplace(pluginInterface.get(),
+                        configuration,
+                        std::move(yara),
+                        std::make_unique<NiceMock<MockDumping>>(),
+                        createMemoryBudget());
+        std::vector<std::string> events;
+        ON_CALL(*pluginInterface, mapProcessMemoryRegion(_, testDtb, _))
+            .WillByDefault(
+                [&events, regionMappings = regionMappings](addr_t baseVA, Unused, Unused)
+                {
+                    events.push_back(fmt::format("map {:x}", baseVA));
+                    auto mapping = std::make_unique<NiceMock<VmiCore::MockMemoryMapping>>();
+                    ON_CALL(*mapping, getMappedRegions()).WillByDefault(Return(regionMappings));
+                    return mapping;
+                });
+        ON_CALL(*yaraRawPointer, scanMemory(_))
+            .WillByDefault(
+                [&events](std::span<const MappedRegion>)
+                {
+                    events.emplace_back("scan");
+                    return std::vector<Rule>{};
+                });
+
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+
+        EXPECT_EQ(events,
+                  (std::vector<std::string>{fmt::format("map {:x}", startAddress),
+                                            fmt::format("map {:x}", secondStartAddress),
+                                            "scan",
+                                            "scan"}));
+    }
+
+    TEST_F(ScannerTestFixtureDumpingDisabled, scanProcess_inFlightMemoryLimitReached_pendingScanFinishedBeforeMapping)
+    {
+        setupDeferredTasks();
+        ON_CALL(*configuration, getInFlightMemoryLimit()).WillByDefault(Return(size));
+        const addr_t secondStartAddress = startAddress + 2 * size;
+        ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
             .WillByDefault(
-                [&processInfo]()
+                [startAddress = startAddress, secondStartAddress, size = size]()
                 {
-                    return std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>(
-                        YR_MAX_THREADS + 5, processInfo);
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                    memoryRegions->emplace_back(
+                        startAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
+                    memoryRegions->emplace_back(
+                        secondStartAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
+                    return memoryRegions;
+                });
+        auto yara = std::make_unique<NiceMock<MockYaraInterface>>();
+        auto* yaraRawPointer = yara.get();
+        scanner.emplace(pluginInterface.get(),
+                        configuration,
+                        std::move(yara),
+                        std::make_unique<NiceMock<MockDumping>>(),
+                        createMemoryBudget());
+        std::vector<std::string> events;
+        ON_CALL(*pluginInterface, mapProcessMemoryRegion(_, testDtb, _))
+            .WillByDefault(
+                [&events, regionMappings = regionMappings](addr_t baseVA, Unused, Unused)
+                {
+                    events.push_back(fmt::format("map {:x}", baseVA));
+                    auto mapping = std::make_unique<NiceMock<VmiCore::MockMemoryMapping>>();
+                    ON_CALL(*mapping, getMappedRegions()).WillByDefault(Return(regionMappings));
+                    return mapping;
                 });
-        ON_CALL(*memoryRegionExtractorRaw, extractAllMemoryRegions())
+        ON_CALL(*yaraRawPointer, scanMemory(_))
+            .WillByDefault(
+                [&events](std::span<const MappedRegion>)
+                {
+                    events.emplace_back("scan");
+                    return std::vector<Rule>{};
+                });
+
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+
+        EXPECT_EQ(events,
+                  (std::vector<std::string>{fmt::format("map {:x}", startAddress),
+                                            "scan",
+                                            fmt::format("map {:x}", secondStartAddress),
+                                            "scan"}));
+    }
+
+    TEST_F(ScannerTestFixtureDumpingDisabled, scanProcess_identicalContentInTwoProcesses_yaraCalledOnceResultsReported)
+    {
+        ON_CALL(*configuration, getScanCacheSize()).WillByDefault(Return(16));
+        const addr_t otherStartAddress = startAddress + 0x10000;
+        ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
             .WillByDefault(
                 [startAddress = startAddress, size = size]()
                 {
-                    auto memoryRegions = std::make_unique<std::vector<MemoryRegion>>();
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
                     memoryRegions->emplace_back(
                         startAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
+                    return memoryRegions;
+                });
+        ON_CALL(*sharedBaseImageMemoryRegionExtractorRaw, getMemoryRegions())
+            .WillByDefault(
+                [otherStartAddress, size = size]()
+                {
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                    memoryRegions->emplace_back(
+                        otherStartAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
+                    return memoryRegions;
+                });
+        std::vector<MappedRegion> otherRegionMappings{{otherStartAddress, testPageContent}};
+        createMemoryMapping(
+            dtbWithSharedBaseImageRegion, otherStartAddress, bytesToNumberOfPages(size), otherRegionMappings);
+        auto yara = std::make_unique<MockYaraInterface>();
+        EXPECT_CALL(*yara, scanMemory(_))
+            .WillOnce(Return(std::vector<Rule>{{"rule", "namespace", {{"$string", 0}}}}));
+        scanner.emplace(pluginInterface.get(),
+                        configuration,
+                        std::move(yara),
+                        std::make_unique<NiceMock<MockDumping>>(),
+                        createMemoryBudget());
+        EXPECT_CALL(*pluginInterface, sendInMemDetectionEvent(std::string_view("rule"))).Times(2);
 
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(processIdWithSharedBaseImageRegion));
+    }
+
+    TEST_F(ScannerTestFixtureDumpingDisabled, scanProcess_singlePageChanged_regionScannedAgain)
+    {
+        ON_CALL(*configuration, getScanCacheSize()).WillByDefault(Return(16));
+        ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
+            .WillByDefault(
+                [startAddress = startAddress, size = size]()
+                {
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                    memoryRegions->emplace_back(
+                        startAddress, 2 * size, "", std::make_unique<MockPageProtection>(), false, false, false);
                     return memoryRegions;
                 });
+        std::vector<uint8_t> twoPageContent(2 * pageSizeInBytes, 1);
+        std::vector<MappedRegion> twoPageMappings{{startAddress, twoPageContent}};
+        createMemoryMapping(testDtb, startAddress, 2, twoPageMappings);
+        auto yara = std::make_unique<MockYaraInterface>();
+        EXPECT_CALL(*yara, scanMemory(_)).Times(2).WillRepeatedly(Return(std::vector<Rule>{}));
+        scanner.emplace(pluginInterface.get(),
+                        configuration,
+                        std::move(yara),
+                        std::make_unique<NiceMock<MockDumping>>(),
+                        createMemoryBudget());
 
-        ASSERT_NO_THROW(scanner->scanAllProcesses());
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+        twoPageContent.back() = 2;
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+    }
+
+    TEST_F(ScannerTestFixtureDumpingDisabled, scanProcess_zeroPageRunWithinRegion_zeroPagesNextToDataScanned)
+    {
+        ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
+            .WillByDefault(
+                [startAddress = startAddress]()
+                {
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                    memoryRegions->emplace_back(startAddress,
+                                                5 * pageSizeInBytes,
+                                                "",
+                                                std::make_unique<MockPageProtection>(),
+                                                false,
+                                                false,
+                                                false);
+                    return memoryRegions;
+                });
+        std::vector<uint8_t> fivePageContent(5 * pageSizeInBytes, 1);
+        std::fill_n(fivePageContent.begin() + pageSizeInBytes, 3 * pageSizeInBytes, 0);
+        std::vector<MappedRegion> fivePageMappings{{startAddress, fivePageContent}};
+        createMemoryMapping(testDtb, startAddress, 5, fivePageMappings);
+        std::vector<MappedRegion> expectedScannedRegions{
+            {startAddress, 2, fivePageContent.data()},
+            {startAddress + 3 * pageSizeInBytes, 2, fivePageContent.data() + 3 * pageSizeInBytes}};
+
+        auto yara = std::make_unique<MockYaraInterface>();
+        EXPECT_CALL(*yara, scanMemory(testing::ElementsAreArray(expectedScannedRegions)))
+            .WillOnce(Return(std::vector<Rule>{}));
+        scanner.emplace(pluginInterface.get(),
+                        configuration,
+                        std::move(yara),
+                        std::make_unique<NiceMock<MockDumping>>(),
+                        createMemoryBudget());
+
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+    }
+
+    class ScannerTestFixtureWindowedScan : public ScannerTestFixtureDumpingDisabled
+    {
+      protected:
+        std::vector<uint8_t> threePageContent = std::vector<uint8_t>(3 * pageSizeInBytes, 1);
+        std::vector<MappedRegion> firstWindowMappings{{startAddress, 2, threePageContent.data()}};
+        std::vector<MappedRegion> secondWindowMappings{
+            {startAddress + pageSizeInBytes, 2, threePageContent.data() + pageSizeInBytes}};
+
+        void SetUp() override
+        {
+            ScannerTestFixtureDumpingDisabled::SetUp();
+
+            ON_CALL(*configuration, getScanWindowSize()).WillByDefault(Return(2 * pageSizeInBytes));
+            ON_CALL(*configuration, getScanWindowOverlap()).WillByDefault(Return(pageSizeInBytes));
+            ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
+                .WillByDefault(
+                    [startAddress = startAddress]()
+                    {
+                        auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                        memoryRegions->emplace_back(startAddress,
+                                                    3 * pageSizeInBytes,
+                                                    "",
+                                                    std::make_unique<MockPageProtection>(),
+                                                    false,
+                                                    false,
+                                                    false);
+                        return memoryRegions;
+                    });
+            createMemoryMapping(testDtb, startAddress, 2, firstWindowMappings);
+            createMemoryMapping(testDtb, startAddress + pageSizeInBytes, 2, secondWindowMappings);
+        }
+    };
+
+    TEST_F(ScannerTestFixtureWindowedScan, scanProcess_regionLargerThanWindow_overlappingWindowsScannedAndMerged)
+    {
+        auto overlapMatch = static_cast<int64_t>(startAddress + pageSizeInBytes + 0x10);
+        auto secondWindowMatch = static_cast<int64_t>(startAddress + 2 * pageSizeInBytes);
+        auto yara = std::make_unique<MockYaraInterface>();
+        EXPECT_CALL(*yara, scanMemory(testing::ElementsAreArray(firstWindowMappings)))
+            .WillOnce(Return(std::vector<Rule>{{"rule", "namespace", {{"$overlap", overlapMatch}}}}));
+        EXPECT_CALL(*yara, scanMemory(testing::ElementsAreArray(secondWindowMappings)))
+            .WillOnce(Return(std::vector<Rule>{
+                {"rule", "namespace", {{"$overlap", overlapMatch}, {"$second", secondWindowMatch}}}}));
+        scanner.emplace(pluginInterface.get(),
+                        configuration,
+                        std::move(yara),
+                        std::make_unique<NiceMock<MockDumping>>(),
+                        createMemoryBudget());
+        std::string streamedResults;
+        ON_CALL(*pluginInterface,
+                writeToFile((inMemoryDumpsPath / "inMemoryResults.jsonl").string(), An<const std::string&>()))
+            .WillByDefault([&streamedResults](Unused, const std::string& content) { streamedResults += content; });
+
+        EXPECT_CALL(*pluginInterface, sendInMemDetectionEvent(std::string_view("rule"))).Times(1);
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+        scanner->saveOutput();
+
+        EXPECT_EQ(streamedResults.find("$overlap"), streamedResults.rfind("$overlap"));
+        EXPECT_THAT(streamedResults, HasSubstr("$second"));
+    }
+
+    TEST_F(ScannerTestFixtureWindowedScan, scanProcess_timeoutInFirstWindow_resultsOfSecondWindowReported)
+    {
+        auto yara = std::make_unique<MockYaraInterface>();
+        EXPECT_CALL(*yara, scanMemory(testing::ElementsAreArray(firstWindowMappings)))
+            .WillOnce(testing::Throw(YaraTimeoutException("Scan timeout")));
+        EXPECT_CALL(*yara, scanMemory(testing::ElementsAreArray(secondWindowMappings)))
+            .WillOnce(Return(std::vector<Rule>{{"rule", "namespace", {{"$string", 0}}}}));
+        scanner.emplace(pluginInterface.get(),
+                        configuration,
+                        std::move(yara),
+                        std::make_unique<NiceMock<MockDumping>>(),
+                        createMemoryBudget());
+
+        EXPECT_CALL(*pluginInterface, sendInMemDetectionEvent(std::string_view("rule"))).Times(1);
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+    }
+
+    class ScannerTestFixtureDetectionDumping : public ScannerTestFixtureDumpingDisabled
+    {
+      protected:
+        const std::vector<addr_t> regionBases{
+            startAddress, startAddress + 2 * size, startAddress + 4 * size, startAddress + 6 * size};
+        /// Order in which the regions are returned by the extractor.
+        std::vector<addr_t> extractedRegionBases = regionBases;
+        std::vector<std::vector<MappedRegion>> regionMappingsPerRegion;
+        std::vector<addr_t> dumpedRegionBases;
 
-        EXPECT_FALSE(yaraFakeRaw->max_threads_exceeded) << "More threads spawned than allowed by yaraFake.";
+        void SetUp() override
+        {
+            ScannerTestFixtureDumpingDisabled::SetUp();
+
+            ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
+                .WillByDefault(
+                    [this]()
+                    {
+                        auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                        for (auto regionBase : extractedRegionBases)
+                        {
+                            memoryRegions->emplace_back(
+                                regionBase, size, "", std::make_unique<MockPageProtection>(), false, false, false);
+                        }
+                        return memoryRegions;
+                    });
+            for (auto regionBase : regionBases)
+            {
+                regionMappingsPerRegion.emplace_back(1, MappedRegion(regionBase, testPageContent));
+            }
+            for (std::size_t region = 0; region < regionBases.size(); region++)
+            {
+                createMemoryMapping(testDtb, regionBases[region], 1, regionMappingsPerRegion[region]);
+            }
+        }
+
+        void setupDetectionInRegion(addr_t detectedRegionBase)
+        {
+            auto yara = std::make_unique<NiceMock<MockYaraInterface>>();
+            ON_CALL(*yara, scanMemory(_))
+                .WillByDefault(
+                    [detectedRegionBase](std::span<const MappedRegion> mappedRegions)
+                    {
+                        return mappedRegions.front().guestBaseVA == detectedRegionBase
+                                   ? std::vector<Rule>{{"rule", "namespace", {{"$string", 0}}}}
+                                   : std::vector<Rule>{};
+                    });
+            auto dumping = std::make_unique<NiceMock<MockDumping>>();
+            ON_CALL(*dumping, dumpMemoryRegion(_, testPid, _, _))
+                .WillByDefault([this](Unused, Unused, const MemoryRegion& memoryRegionDescriptor, Unused)
+                               { dumpedRegionBases.push_back(memoryRegionDescriptor.base); });
+            scanner.emplace(
+                pluginInterface.get(), configuration, std::move(yara), std::move(dumping), createMemoryBudget());
+        }
+    };
+
+    TEST_F(ScannerTestFixtureDetectionDumping, scanProcess_regionScope_onlyDetectedRegionDumpedFromScanMapping)
+    {
+        ON_CALL(*configuration, getDetectionDumpScope()).WillByDefault(Return(DetectionDumpScope::Region));
+        setupDetectionInRegion(regionBases[1]);
+
+        EXPECT_CALL(*pluginInterface, mapProcessMemoryRegion(_, testDtb, 1)).Times(AnyNumber());
+        EXPECT_CALL(*pluginInterface, mapProcessMemoryRegion(regionBases[1], testDtb, 1)).Times(1);
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+
+        EXPECT_EQ(dumpedRegionBases, std::vector<addr_t>{regionBases[1]});
+    }
+
+    TEST_F(ScannerTestFixtureDetectionDumping, scanProcess_neighbouringRegionsScope_adjacentRegionsDumped)
+    {
+        ON_CALL(*configuration, getDetectionDumpScope())
+            .WillByDefault(Return(DetectionDumpScope::NeighbouringRegions));
+        setupDetectionInRegion(regionBases[1]);
+
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+
+        EXPECT_EQ(dumpedRegionBases, (std::vector<addr_t>{regionBases[1], regionBases[0], regionBases[2]}));
+    }
+
+    TEST_F(ScannerTestFixtureDetectionDumping, scanProcess_neighboursScopeUnorderedRegions_adjacentRegionsDumped)
+    {
+        ON_CALL(*configuration, getDetectionDumpScope())
+            .WillByDefault(Return(DetectionDumpScope::NeighbouringRegions));
+        extractedRegionBases = {regionBases[2], regionBases[0], regionBases[3], regionBases[1]};
+        setupDetectionInRegion(regionBases[1]);
+
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+
+        EXPECT_EQ(dumpedRegionBases, (std::vector<addr_t>{regionBases[1], regionBases[0], regionBases[2]}));
     }
 
-    TEST_F(ScannerTestFixtureDumpingEnabled, scanAllProcesses_ProcessWithLongNameScanned_ProcessInformationWritten)
+    TEST_F(ScannerTestFixtureDetectionDumping, scanProcess_processScopeWithoutDetection_nothingDumped)
+    {
+        ON_CALL(*configuration, getDetectionDumpScope()).WillByDefault(Return(DetectionDumpScope::Process));
+        setupDetectionInRegion(0);
+
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+
+        EXPECT_TRUE(dumpedRegionBases.empty());
+    }
+
+    TEST_F(ScannerTestFixtureDetectionDumping, scanProcess_processScope_allRegionsDumpedOnce)
+    {
+        ON_CALL(*configuration, getDetectionDumpScope()).WillByDefault(Return(DetectionDumpScope::Process));
+        setupDetectionInRegion(regionBases[3]);
+
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+
+        EXPECT_EQ(dumpedRegionBases,
+                  (std::vector<addr_t>{regionBases[3], regionBases[0], regionBases[1], regionBases[2]}));
+    }
+
+    TEST_F(ScannerTestFixtureDumpingDisabled, saveOutput_ruleProfilingActivated_profileWithScannedRegionWritten)
+    {
+        ON_CALL(*configuration, isRuleProfilingActivated()).WillByDefault(Return(true));
+        ON_CALL(*configuration, getSignatureFile()).WillByDefault(Return("rules.yarc"));
+        ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
+            .WillByDefault(
+                [startAddress = startAddress, size = size]()
+                {
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                    memoryRegions->emplace_back(
+                        startAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
+                    return memoryRegions;
+                });
+        auto yara = std::make_unique<NiceMock<MockYaraInterface>>();
+        ON_CALL(*yara, scanMemory(_)).WillByDefault(Return(std::vector<Rule>{}));
+        scanner.emplace(pluginInterface.get(),
+                        configuration,
+                        std::move(yara),
+                        std::make_unique<NiceMock<MockDumping>>(),
+                        createMemoryBudget());
+        scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid));
+
+        EXPECT_CALL(*pluginInterface, writeToFile(_, An<const std::string&>())).Times(AnyNumber());
+        EXPECT_CALL(*pluginInterface,
+                    writeToFile((inMemoryDumpsPath / "ruleProfile.txt").string(),
+                                testing::Matcher<const std::string&>(
+                                    testing::AllOf(HasSubstr("Rule set: rules.yarc"), HasSubstr("System.exe")))))
+            .Times(1);
+
+        scanner->saveOutput();
+    }
+
+    TEST_F(ScannerTestFixtureDumpingEnabled, scanAllProcesses_ProcessWithLongNameScanned_IndexEntryWritten)
     {
         std::string fullProcessName = "abcdefghijklmnop";
         std::string trimmedProcessName = "abcdefghijklmn";
@@ -366,9 +859,8 @@ namespace InMemoryScanner
                                      std::make_unique<std::string>(""),
                                      std::move(memoryRegionExtractor),
                                      false});
-        auto expectedFileName = inMemoryDumpsPath / "MemoryRegionInformation.json";
         std::string jsonStart = "{";
-        std::string expectedFileContent =
+        std::string expectedEntryStart =
             jsonStart + R"("ProcessName": ")" + fullProcessName + "\", " + "\"ProcessId\": " + std::to_string(pid) +
             ", " + "\"SharedMemory\": " + (memoryRegionDescriptor.isSharedMemory ? "true" : "false") + ", " +
             R"("AccessRights": ")" + protectionAsString + "\", " + R"("StartAddress": ")" +
@@ -377,7 +869,12 @@ namespace InMemoryScanner
             "\"BeingDeleted\": " + (memoryRegionDescriptor.isBeingDeleted ? "true" : "false") + ", " +
             "\"ProcessBaseImage\": " + (memoryRegionDescriptor.isProcessBaseImage ? "true" : "false") + ", " +
             "\"Uid\": " + uidFirstRegion + ", " + R"("DumpFileName": ")" + getMemFileName(trimmedProcessName, pid) +
-            "\" " + "}";
+            "\", ";
+        // The run id is random
+        std::string expectedEntryEnd =
+            R"("Offset": 0, "StoredSize": 4096, "DumpSize": 4096, "Compression": "none", )" +
+            fmt::format(R"("Checksum": "{:08x}", )", DumpArchive::updateChecksum(0, testPageContent)) +
+            R"("Extents": [[0, 4096]] })" + "\n";
         ON_CALL(*pluginInterface, getRunningProcesses())
             .WillByDefault(
                 [&processInfo]() {
@@ -385,11 +882,11 @@ namespace InMemoryScanner
                                                                                                           processInfo);
                 });
         // Redefine default mock return because a new MemoryRegionExtractor mock has been created
-        ON_CALL(*memoryRegionExtractorRaw, extractAllMemoryRegions())
+        ON_CALL(*memoryRegionExtractorRaw, getMemoryRegions())
             .WillByDefault(
                 [&memoryRegionDescriptor = memoryRegionDescriptor]()
                 {
-                    auto memoryRegions = std::make_unique<std::vector<MemoryRegion>>();
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
                     memoryRegions->push_back(std::move(memoryRegionDescriptor));
 
                     return memoryRegions;
@@ -397,7 +894,14 @@ namespace InMemoryScanner
         createMemoryMapping(dtb, startAddress, bytesToNumberOfPages(size), regionMappings);
 
         EXPECT_CALL(*pluginInterface, writeToFile(_, An<const std::string&>())).Times(AnyNumber());
-        EXPECT_CALL(*pluginInterface, writeToFile(expectedFileName.string(), expectedFileContent + "\n")).Times(1);
+        EXPECT_CALL(*pluginInterface,
+                    writeToFile(dumpIndexPath.string(),
+                                Matcher<const std::string&>(
+                                    AllOf(StartsWith(expectedEntryStart),
+                                          ContainsRegex(R"("RunId": "[0-9a-f]{16}", )"
+                                                        R"("Archive": "dumpedRegions-[0-9a-f]{16}-0\.pack")"),
+                                          EndsWith(expectedEntryEnd)))))
+            .Times(1);
 
         ASSERT_NO_THROW(scanner->scanAllProcesses());
         ASSERT_NO_THROW(scanner->saveOutput());
@@ -424,11 +928,11 @@ namespace InMemoryScanner
         std::size_t complexRegionSize = 5 * pageSizeInBytes;
         auto complexRegionDescriptor = MemoryRegion(
             startAddress, complexRegionSize, "", std::make_unique<MockPageProtection>(), false, false, false);
-        ON_CALL(*memoryRegionExtractorRaw, extractAllMemoryRegions())
+        ON_CALL(*memoryRegionExtractorRaw, getMemoryRegions())
             .WillByDefault(
                 [&memoryRegionDescriptor = complexRegionDescriptor]()
                 {
-                    auto memoryRegions = std::make_unique<std::vector<MemoryRegion>>();
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
                     memoryRegions->push_back(std::move(memoryRegionDescriptor));
 
                     return memoryRegions;
@@ -440,7 +944,285 @@ namespace InMemoryScanner
         auto paddingPage = std::vector<uint8_t>(pageSizeInBytes, 0);
         auto expectedPaddedRegion = constructPaddedRegion({testPageContent, paddingPage, twoPageRegionContent});
 
-        EXPECT_CALL(*pluginInterface, writeToFile(_, expectedPaddedRegion)).Times(1);
+        std::string archiveContent;
+        std::string indexContent;
+        EXPECT_CALL(*pluginInterface, writeToFile(dumpArchivePath, An<std::span<const FileChunk>>()))
+            .WillOnce(
+                [&archiveContent](Unused, std::span<const FileChunk> chunks)
+                {
+                    for (const auto& chunk : chunks)
+                    {
+                        archiveContent.append(chunk.data.begin(), chunk.data.end());
+                        archiveContent.append(chunk.holeSize, '\0');
+                    }
+                    return true;
+                });
+        EXPECT_CALL(*pluginInterface, writeToFile(dumpIndexPath.string(), An<const std::string&>()))
+            .WillOnce([&indexContent](Unused, const std::string& line) { indexContent = line; });
         ASSERT_NO_THROW(scanner->scanProcess(processInfo));
+
+        std::istringstream index(indexContent);
+        std::size_t skippedLines = 0;
+        auto indexEntries = DumpArchiveReader::readIndex(index, skippedLines);
+        ASSERT_EQ(indexEntries.size(), 1);
+        std::istringstream archive(archiveContent);
+        EXPECT_EQ(DumpArchiveReader(archive).readDump(indexEntries[0].record), expectedPaddedRegion);
+    }
+
+    TEST_F(ScannerTestFixtureDumpingEnabled,
+           scanProcess_contiguousMappingsInSeparateBuffers_regionDumpedWithoutPadding)
+    {
+        ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
+            .WillByDefault(
+                [startAddress = startAddress]()
+                {
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                    memoryRegions->emplace_back(startAddress,
+                                                2 * pageSizeInBytes,
+                                                "",
+                                                std::make_unique<MockPageProtection>(),
+                                                false,
+                                                false,
+                                                false);
+                    return memoryRegions;
+                });
+        auto secondPageContent = std::vector<uint8_t>(pageSizeInBytes, 0xCA);
+        std::vector<MappedRegion> contiguousMappings{{startAddress, testPageContent},
+                                                     {startAddress + pageSizeInBytes, secondPageContent}};
+        createMemoryMapping(testDtb, startAddress, 2, contiguousMappings);
+
+        std::string archiveContent;
+        std::string indexContent;
+        ON_CALL(*pluginInterface, writeToFile(dumpArchivePath, An<std::span<const FileChunk>>()))
+            .WillByDefault(
+                [&archiveContent](Unused, std::span<const FileChunk> chunks)
+                {
+                    for (const auto& chunk : chunks)
+                    {
+                        archiveContent.append(chunk.data.begin(), chunk.data.end());
+                        archiveContent.append(chunk.holeSize, '\0');
+                    }
+                    return true;
+                });
+        ON_CALL(*pluginInterface, writeToFile(dumpIndexPath.string(), An<const std::string&>()))
+            .WillByDefault([&indexContent](Unused, const std::string& line) { indexContent = line; });
+        ASSERT_NO_THROW(scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid)));
+
+        std::istringstream index(indexContent);
+        std::size_t skippedLines = 0;
+        auto indexEntries = DumpArchiveReader::readIndex(index, skippedLines);
+        ASSERT_EQ(indexEntries.size(), 1);
+        std::istringstream archive(archiveContent);
+        EXPECT_EQ(DumpArchiveReader(archive).readDump(indexEntries[0].record),
+                  constructPaddedRegion({testPageContent, secondPageContent}));
+    }
+
+    TEST_F(ScannerTestFixtureAsyncTerminationScan, scanTerminatedProcess_asyncScanActivated_capturedCopyScanned)
+    {
+        setupScanner(size);
+        std::vector<uint8_t> scannedContent;
+        addr_t scannedBaseVA = 0;
+        const void* scannedMappingBase = nullptr;
+        EXPECT_CALL(*yaraRawPointer, scanMemory(_))
+            .WillOnce(
+                [&](std::span<const MappedRegion> mappedRegions)
+                {
+                    auto mappedSpan = mappedRegions.front().asSpan();
+                    scannedContent.assign(mappedSpan.begin(), mappedSpan.end());
+                    scannedBaseVA = mappedRegions.front().guestBaseVA;
+                    scannedMappingBase = mappedRegions.front().mappingBase;
+                    return std::vector<Rule>{};
+                });
+
+        ASSERT_NO_THROW(scanner->scanTerminatedProcess(getProcessInfoFromRunningProcesses(testPid)));
+        scanner->finishPendingScans();
+
+        EXPECT_EQ(scannedContent, testPageContent);
+        EXPECT_EQ(scannedBaseVA, startAddress);
+        EXPECT_NE(scannedMappingBase, testPageContent.data());
+    }
+
+    TEST_F(ScannerTestFixtureAsyncTerminationScan, scanTerminatedProcess_memoryLimitExceeded_regionScannedSynchronously)
+    {
+        setupScanner(0);
+        const void* scannedMappingBase = nullptr;
+        EXPECT_CALL(*yaraRawPointer, scanMemory(_))
+            .WillOnce(
+                [&](std::span<const MappedRegion> mappedRegions)
+                {
+                    scannedMappingBase = mappedRegions.front().mappingBase;
+                    return std::vector<Rule>{};
+                });
+
+        ASSERT_NO_THROW(scanner->scanTerminatedProcess(getProcessInfoFromRunningProcesses(testPid)));
+
+        EXPECT_EQ(scannedMappingBase, testPageContent.data());
+        scanner->finishPendingScans();
+    }
+
+    TEST_F(ScannerTestFixtureAsyncTerminationScan,
+           scanTerminatedProcess_copyExceedsMemoryBudget_synchronousScanChargedForMapping)
+    {
+        ON_CALL(*configuration, getInFlightMemoryLimit()).WillByDefault(Return(size));
+        setupScanner(size);
+        const void* scannedMappingBase = nullptr;
+        std::unique_ptr<MemoryBudget::Reservation> reservationDuringScan;
+        EXPECT_CALL(*yaraRawPointer, scanMemory(_))
+            .WillOnce(
+                [&](std::span<const MappedRegion> mappedRegions)
+                {
+                    scannedMappingBase = mappedRegions.front().mappingBase;
+                    reservationDuringScan = memoryBudget->tryAcquire(1, AdmissionPriority::Normal);
+                    return std::vector<Rule>{};
+                });
+
+        ASSERT_NO_THROW(scanner->scanTerminatedProcess(getProcessInfoFromRunningProcesses(testPid)));
+        scanner->finishPendingScans();
+
+        EXPECT_EQ(scannedMappingBase, testPageContent.data());
+        EXPECT_EQ(reservationDuringScan, nullptr);
+    }
+
+    TEST_F(ScannerTestFixtureAsyncTerminationScan, scanTerminatedProcess_regionPartiallyMapped_mappedBytesCharged)
+    {
+        // The mapping and its copy only fit into the budget if the unmapped page is not charged
+        ON_CALL(*configuration, getInFlightMemoryLimit()).WillByDefault(Return(2 * size));
+        setupScanner(size);
+        ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
+            .WillByDefault(
+                [startAddress = startAddress, size = size]()
+                {
+                    auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                    memoryRegions->emplace_back(
+                        startAddress, 2 * size, "", std::make_unique<MockPageProtection>(), false, false, false);
+                    return memoryRegions;
+                });
+        createMemoryMapping(testDtb, startAddress, 2 * bytesToNumberOfPages(size), regionMappings);
+        const void* scannedMappingBase = nullptr;
+        EXPECT_CALL(*yaraRawPointer, scanMemory(_))
+            .WillOnce(
+                [&](std::span<const MappedRegion> mappedRegions)
+                {
+                    scannedMappingBase = mappedRegions.front().mappingBase;
+                    return std::vector<Rule>{};
+                });
+
+        ASSERT_NO_THROW(scanner->scanTerminatedProcess(getProcessInfoFromRunningProcesses(testPid)));
+        scanner->finishPendingScans();
+
+        ASSERT_NE(scannedMappingBase, nullptr);
+        EXPECT_NE(scannedMappingBase, testPageContent.data());
+    }
+
+    class ScannerTestFixtureAsyncWindowedScan : public ScannerTestFixtureAsyncTerminationScan
+    {
+      protected:
+        std::vector<uint8_t> threePageContent = std::vector<uint8_t>(3 * pageSizeInBytes, 1);
+        std::vector<MappedRegion> firstWindowMappings{{startAddress, 2, threePageContent.data()}};
+        std::vector<MappedRegion> secondWindowMappings{
+            {startAddress + pageSizeInBytes, 2, threePageContent.data() + pageSizeInBytes}};
+        std::vector<const void*> scannedMappingBases;
+
+        void setupWindowedScanner(std::size_t asyncScanMemoryLimit)
+        {
+            setupScanner(asyncScanMemoryLimit);
+            ON_CALL(*configuration, getScanWindowSize()).WillByDefault(Return(2 * pageSizeInBytes));
+            ON_CALL(*configuration, getScanWindowOverlap()).WillByDefault(Return(pageSizeInBytes));
+            ON_CALL(*systemMemoryRegionExtractorRaw, getMemoryRegions())
+                .WillByDefault(
+                    [startAddress = startAddress]()
+                    {
+                        auto memoryRegions = std::make_shared<std::vector<MemoryRegion>>();
+                        memoryRegions->emplace_back(startAddress,
+                                                    3 * pageSizeInBytes,
+                                                    "",
+                                                    std::make_unique<MockPageProtection>(),
+                                                    false,
+                                                    false,
+                                                    false);
+                        return memoryRegions;
+                    });
+            createMemoryMapping(testDtb, startAddress, 2, firstWindowMappings);
+            createMemoryMapping(testDtb, startAddress + pageSizeInBytes, 2, secondWindowMappings);
+            ON_CALL(*yaraRawPointer, scanMemory(_))
+                .WillByDefault(
+                    [this](std::span<const MappedRegion> mappedRegions)
+                    {
+                        scannedMappingBases.push_back(mappedRegions.front().mappingBase);
+                        auto position = static_cast<int64_t>(mappedRegions.front().guestBaseVA);
+                        return std::vector<Rule>{{"rule", "namespace", {{"$string", position}}}};
+                    });
+        }
+    };
+
+    TEST_F(ScannerTestFixtureAsyncWindowedScan,
+           scanTerminatedProcess_regionLargerThanWindow_capturedWindowsScannedAndMerged)
+    {
+        setupWindowedScanner(4 * pageSizeInBytes);
+
+        EXPECT_CALL(*pluginInterface, sendInMemDetectionEvent(std::string_view("rule"))).Times(1);
+        ASSERT_NO_THROW(scanner->scanTerminatedProcess(getProcessInfoFromRunningProcesses(testPid)));
+        scanner->finishPendingScans();
+
+        ASSERT_EQ(scannedMappingBases.size(), 2);
+        EXPECT_NE(scannedMappingBases[0], firstWindowMappings.front().mappingBase);
+        EXPECT_NE(scannedMappingBases[1], secondWindowMappings.front().mappingBase);
+    }
+
+    TEST_F(ScannerTestFixtureAsyncWindowedScan,
+           scanTerminatedProcess_windowExceedsMemoryLimit_windowScannedSynchronously)
+    {
+        setupWindowedScanner(2 * pageSizeInBytes);
+
+        EXPECT_CALL(*pluginInterface, sendInMemDetectionEvent(std::string_view("rule"))).Times(1);
+        ASSERT_NO_THROW(scanner->scanTerminatedProcess(getProcessInfoFromRunningProcesses(testPid)));
+        scanner->finishPendingScans();
+
+        // The captured first window uses up the memory limit, so the second one is scanned during the capture
+        ASSERT_EQ(scannedMappingBases.size(), 2);
+        EXPECT_EQ(scannedMappingBases[0], secondWindowMappings.front().mappingBase);
+        EXPECT_NE(scannedMappingBases[1], firstWindowMappings.front().mappingBase);
+    }
+
+    TEST_F(ScannerTestFixtureAsyncWindowedScan,
+           scanTerminatedProcess_detectionInCapturedWindows_regionDumpedFromWindows)
+    {
+        setupWindowedScanner(4 * pageSizeInBytes);
+        ON_CALL(*configuration, getDetectionDumpScope()).WillByDefault(Return(DetectionDumpScope::Region));
+        std::vector<MappedRegion> dumpedMappings;
+        EXPECT_CALL(*dumpingRawPointer, dumpMemoryRegion(_, testPid, _, _))
+            .WillOnce([&dumpedMappings](Unused, Unused, Unused, std::span<const MappedRegion> mappedRegions)
+                      { dumpedMappings.assign(mappedRegions.begin(), mappedRegions.end()); });
+
+        ASSERT_NO_THROW(scanner->scanTerminatedProcess(getProcessInfoFromRunningProcesses(testPid)));
+        scanner->finishPendingScans();
+
+        // The overlapping page is only taken from the first window
+        ASSERT_EQ(dumpedMappings.size(), 2);
+        EXPECT_EQ(dumpedMappings[0].guestBaseVA, startAddress);
+        EXPECT_EQ(dumpedMappings[0].num_pages, 2);
+        EXPECT_EQ(dumpedMappings[1].guestBaseVA, startAddress + 2 * pageSizeInBytes);
+        EXPECT_EQ(dumpedMappings[1].num_pages, 1);
+        EXPECT_NE(dumpedMappings[0].mappingBase, threePageContent.data());
+    }
+
+    TEST_F(ScannerTestFixtureAsyncWindowedScan,
+           scanTerminatedProcess_detectionDumpingAndWindowExceedsMemoryLimit_regionScannedAndDumpedWhileCapturing)
+    {
+        setupWindowedScanner(2 * pageSizeInBytes);
+        ON_CALL(*configuration, getDetectionDumpScope()).WillByDefault(Return(DetectionDumpScope::Region));
+        std::vector<MappedRegion> regionMappings{{startAddress, 3, threePageContent.data()}};
+        createMemoryMapping(testDtb, startAddress, 3, regionMappings);
+
+        EXPECT_CALL(*dumpingRawPointer, dumpMemoryRegion(_, testPid, _, testing::ElementsAreArray(regionMappings)))
+            .Times(1);
+        EXPECT_CALL(*pluginInterface, sendInMemDetectionEvent(std::string_view("rule"))).Times(1);
+        ASSERT_NO_THROW(scanner->scanTerminatedProcess(getProcessInfoFromRunningProcesses(testPid)));
+
+        // Both windows are scanned from the guest mapping before the capture has finished
+        EXPECT_EQ(scannedMappingBases,
+                  (std::vector<const void*>{firstWindowMappings.front().mappingBase,
+                                            secondWindowMappings.front().mappingBase}));
+        scanner->finishPendingScans();
     }
 }
@@ -0,0 +1,69 @@
+#include <SipHash.h>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+namespace InMemoryScanner
+{
+    namespace
+    {
+        // Key and messages of the reference test vectors: 00 01 02 ...
+        constexpr SipHash128::Key referenceKey{0x0706050403020100, 0x0f0e0d0c0b0a0908};
+
+        std::vector<uint8_t> createReferenceMessage(std::size_t size)
+        {
+            std::vector<uint8_t> message(size);
+            std::iota(message.begin(), message.end(), 0);
+            return message;
+        }
+
+        SipHash128::Digest hash(std::span<const uint8_t> message)
+        {
+            SipHash128 sipHash(referenceKey);
+            sipHash.update(message);
+            return sipHash.finalize();
+        }
+    }
+
+    TEST(SipHashTests, finalize_referenceMessages_referenceDigests)
+    {
+        EXPECT_EQ(hash(createReferenceMessage(0)), (SipHash128::Digest{0xe6a825ba047f81a3, 0x930255c71472f66d}));
+        EXPECT_EQ(hash(createReferenceMessage(15)), (SipHash128::Digest{0x11a8b03399e99354, 0xd9c3cf970fec087e}));
+        EXPECT_EQ(hash(createReferenceMessage(63)), (SipHash128::Digest{0x4a83502f77d15051, 0x7cbd3f979a063e50}));
+        EXPECT_EQ(hash(createReferenceMessage(64)), (SipHash128::Digest{0x3fcdd4c07d07af1e, 0x4ba75836384dad8c}));
+    }
+
+    TEST(SipHashTests, update_messageSplitIntoUnalignedParts_sameDigest)
+    {
+        auto message = createReferenceMessage(63);
+        SipHash128 sipHash(referenceKey);
+
+        sipHash.update(std::span(message).first(3));
+        sipHash.update(std::span(message).subspan(3, 5));
+        sipHash.update(std::span(message).subspan(8, 1));
+        sipHash.update(std::span(message).subspan(9));
+
+        EXPECT_EQ(sipHash.finalize(), hash(message));
+    }
+
+    TEST(SipHashTests, update_unalignedWord_sameDigestAsLittleEndianBytes)
+    {
+        auto message = createReferenceMessage(15);
+        SipHash128 sipHash(referenceKey);
+
+        sipHash.update(std::span(message).first(3));
+        sipHash.update(uint64_t{0x0a09080706050403});
+        sipHash.update(std::span(message).subspan(11));
+
+        EXPECT_EQ(sipHash.finalize(), hash(message));
+    }
+
+    TEST(SipHashTests, finalize_differentKeys_differentDigests)
+    {
+        auto message = createReferenceMessage(64);
+        SipHash128 sipHash(SipHash128::Key{referenceKey[0] ^ 1, referenceKey[1]});
+        sipHash.update(message);
+
+        EXPECT_NE(sipHash.finalize(), hash(message));
+    }
+}
@@ -0,0 +1,148 @@
+#include <YaraCompiler.h>
+#include <YaraInterface.h>
+#include <fstream>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <vmicore/os/PagingDefinitions.h>
+#include <vmicore_test/io/mock_Logger.h>
+#include <vmicore_test/plugins/mock_PluginInterface.h>
+
+using testing::_;
+using testing::NiceMock;
+using VmiCore::MockLogger;
+using VmiCore::PagingDefinitions::pageSizeInBytes;
+using VmiCore::Plugin::MockPluginInterface;
+
+namespace InMemoryScanner
+{
+    class YaraCompilerFixture : public testing::Test
+    {
+      protected:
+        std::filesystem::path testDirectory =
+            std::filesystem::path(testing::TempDir()) /
+            testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::path sourceDirectory = testDirectory / "sources";
+        std::filesystem::path cacheDirectory = testDirectory / "cache";
+        NiceMock<MockPluginInterface> pluginInterface;
+
+        void SetUp() override
+        {
+            std::filesystem::remove_all(testDirectory);
+            std::filesystem::create_directories(sourceDirectory);
+            ON_CALL(pluginInterface, newNamedLogger(_))
+                .WillByDefault([]() { return std::make_unique<NiceMock<MockLogger>>(); });
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(testDirectory);
+        }
+
+        void writeSource(const std::filesystem::path& relativePath, std::string_view rule) const
+        {
+            auto path = sourceDirectory / relativePath;
+            std::filesystem::create_directories(path.parent_path());
+            std::ofstream(path) << rule;
+        }
+    };
+
+    constexpr std::string_view abcdRule = R"(
+                                            rule testRule
+                                            {
+                                                strings:
+                                                    $test = "ABCD"
+
+                                                condition:
+                                                    all of them
+                                            }
+                                        )";
+
+    TEST_F(YaraCompilerFixture, getCompiledRules_sourceDirectory_rulesInNamespaceOfFileMatch)
+    {
+        writeSource("family/sample.yar", abcdRule);
+        YaraCompiler yaraCompiler(&pluginInterface, cacheDirectory);
+        std::vector<uint8_t> page(pageSizeInBytes, 0);
+        std::string_view content = "ABCD";
+        std::copy(content.begin(), content.end(), page.begin());
+        std::vector<VmiCore::MappedRegion> memoryRegions{{0x0, page}};
+
+        auto yaraInterface = YaraInterface(yaraCompiler.getCompiledRules(sourceDirectory), 0);
+        auto matches = yaraInterface.scanMemory(memoryRegions);
+
+        ASSERT_EQ(matches.size(), 1);
+        EXPECT_EQ(matches.front().ruleNamespace, "family/sample");
+    }
+
+    TEST_F(YaraCompilerFixture, getCompiledRules_compiledRules_pathUnchanged)
+    {
+        writeSource("sample.yar", abcdRule);
+        YaraCompiler yaraCompiler(&pluginInterface, cacheDirectory);
+        auto compiledRules = yaraCompiler.getCompiledRules(sourceDirectory / "sample.yar");
+
+        EXPECT_EQ(yaraCompiler.getCompiledRules(compiledRules), compiledRules);
+    }
+
+    TEST_F(YaraCompilerFixture, getCompiledRules_unchangedSources_cachedRulesReused)
+    {
+        writeSource("sample.yar", abcdRule);
+        auto compiledRules = YaraCompiler(&pluginInterface, cacheDirectory).getCompiledRules(sourceDirectory);
+        auto lastWriteTime = std::filesystem::last_write_time(compiledRules);
+
+        auto cachedRules = YaraCompiler(&pluginInterface, cacheDirectory).getCompiledRules(sourceDirectory);
+
+        EXPECT_EQ(cachedRules, compiledRules);
+        EXPECT_EQ(std::filesystem::last_write_time(cachedRules), lastWriteTime);
+    }
+
+    TEST_F(YaraCompilerFixture, getCompiledRules_modifiedSource_rulesCompiledAgain)
+    {
+        writeSource("sample.yar", abcdRule);
+        YaraCompiler yaraCompiler(&pluginInterface, cacheDirectory);
+        auto compiledRules = yaraCompiler.getCompiledRules(sourceDirectory);
+
+        writeSource("other.yara", "rule otherRule { condition: true }");
+
+        EXPECT_NE(yaraCompiler.getCompiledRules(sourceDirectory), compiledRules);
+    }
+
+    TEST_F(YaraCompilerFixture, getCompiledRules_syntaxError_throwsAndNothingCached)
+    {
+        writeSource("broken.yar", "rule brokenRule { condition: }");
+        YaraCompiler yaraCompiler(&pluginInterface, cacheDirectory);
+
+        EXPECT_THROW(auto compiledRules = yaraCompiler.getCompiledRules(sourceDirectory), YaraException);
+        EXPECT_TRUE(std::filesystem::is_empty(cacheDirectory));
+    }
+
+    TEST_F(YaraCompilerFixture, getCompiledRules_sourceFileWithModifiedInclude_rulesCompiledAgain)
+    {
+        std::ofstream(testDirectory / "common.yar") << abcdRule;
+        writeSource("sample.yar", R"(include "../common.yar")");
+        YaraCompiler yaraCompiler(&pluginInterface, cacheDirectory);
+        auto compiledRules = yaraCompiler.getCompiledRules(sourceDirectory / "sample.yar");
+
+        std::ofstream(testDirectory / "common.yar") << "rule otherRule { condition: true }";
+
+        EXPECT_NE(yaraCompiler.getCompiledRules(sourceDirectory / "sample.yar"), compiledRules);
+    }
+
+    TEST_F(YaraCompilerFixture, getCompiledRules_newCacheDirectory_onlyAccessibleByOwner)
+    {
+        writeSource("sample.yar", abcdRule);
+        YaraCompiler yaraCompiler(&pluginInterface, cacheDirectory);
+
+        auto compiledRules = yaraCompiler.getCompiledRules(sourceDirectory);
+
+        EXPECT_EQ(std::filesystem::status(cacheDirectory).permissions(), std::filesystem::perms::owner_all);
+    }
+
+    TEST_F(YaraCompilerFixture, getCompiledRules_cacheDirectoryWritableByOthers_throws)
+    {
+        writeSource("sample.yar", abcdRule);
+        std::filesystem::create_directories(cacheDirectory);
+        std::filesystem::permissions(cacheDirectory, std::filesystem::perms::all);
+        YaraCompiler yaraCompiler(&pluginInterface, cacheDirectory);
+
+        EXPECT_THROW(auto compiledRules = yaraCompiler.getCompiledRules(sourceDirectory), YaraException);
+    }
+}
@@ -1,5 +1,7 @@
 #include <YaraInterface.h>
+#include <ZeroPages.h>
 #include <fmt/core.h>
+#include <future>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <string_view>
@@ -94,6 +96,28 @@ namespace InMemoryScanner
         EXPECT_EQ(matches.size(), 0);
     }
 
+    TEST(YaraTest, scanMemory_hexStringReachingIntoZeroPageRun_Matches)
+    {
+        auto* rules = R"(
+                        rule testRule
+                        {
+                            strings:
+                                $test = { 41 42 43 44 00 00 00 00 }
+
+                            condition:
+                                all of them
+                        }
+                    )";
+        auto yaraInterface = YaraInterface(compileYaraRules(rules), 0);
+        auto pages = constructPageWithContent("ABCD", true);
+        pages.resize(4 * pageSizeInBytes, 0);
+        std::vector<VmiCore::MappedRegion> memoryRegions{{0x0, pages}};
+
+        auto matches = yaraInterface.scanMemory(splitAtZeroPageRuns(memoryRegions));
+
+        EXPECT_EQ(matches.size(), 1);
+    }
+
     TEST(YaraTest, scanMemory_AllOfConditionStringsInDifferentRegions_NoMatch)
     {
         auto* rules = R"(
@@ -183,4 +207,60 @@ namespace InMemoryScanner
         ASSERT_EQ(matches.size(), 2);
         EXPECT_THAT(matches, UnorderedElementsAre(expectedMatch1, expectedMatch2));
     }
+
+    TEST(YaraTest, scanMemory_scanAfterMatchingScan_previousMatchesNotReported)
+    {
+        auto* rules = R"(
+                        rule testRule
+                        {
+                            strings:
+                                $test = "ABCD"
+
+                            condition:
+                                all of them
+                        }
+                    )";
+        auto yaraInterface = YaraInterface(compileYaraRules(rules), 0);
+        auto matchingRegion = constructPageWithContent("ABCD");
+        auto otherRegion = constructPageWithContent("EFGH");
+        std::vector<VmiCore::MappedRegion> matchingMemoryRegions{{0x0, matchingRegion}};
+        std::vector<VmiCore::MappedRegion> otherMemoryRegions{{0x0, otherRegion}};
+        ASSERT_EQ(yaraInterface.scanMemory(matchingMemoryRegions).size(), 1);
+
+        auto matches = yaraInterface.scanMemory(otherMemoryRegions);
+
+        EXPECT_EQ(matches.size(), 0);
+    }
+
+    TEST(YaraTest, scanMemory_moreConcurrentScansThanYaraThreads_allScansMatch)
+    {
+        auto* rules = R"(
+                        rule testRule
+                        {
+                            strings:
+                                $test = "ABCD"
+
+                            condition:
+                                all of them
+                        }
+                    )";
+        auto yaraInterface = YaraInterface(compileYaraRules(rules), 0);
+        auto subRegion = constructPageWithContent("ABCD");
+        std::vector<VmiCore::MappedRegion> memoryRegions{{0x0, subRegion}};
+        std::vector<std::future<std::size_t>> scans;
+
+        for (int i = 0; i < YR_MAX_THREADS + 5; i++)
+        {
+            scans.push_back(std::async(std::launch::async,
+                                       [&yaraInterface, &memoryRegions]()
+                                       { return yaraInterface.scanMemory(memoryRegions).size(); }));
+        }
+
+        for (auto& scan : scans)
+        {
+            EXPECT_EQ(scan.get(), 1);
+        }
+        EXPECT_LE(yaraInterface.getMaxConcurrentScanCount(), YR_MAX_THREADS);
+        EXPECT_GE(yaraInterface.getMaxConcurrentScanCount(), 1);
+    }
 }
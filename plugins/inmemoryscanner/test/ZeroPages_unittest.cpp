@@ -0,0 +1,68 @@
+#include <ZeroPages.h>
+#include <gtest/gtest.h>
+#include <vmicore/os/PagingDefinitions.h>
+
+using VmiCore::addr_t;
+using VmiCore::MappedRegion;
+using VmiCore::PagingDefinitions::pageSizeInBytes;
+
+namespace InMemoryScanner
+{
+    TEST(ZeroPagesTests, isZeroPage_zeroPage_true)
+    {
+        std::vector<uint8_t> page(pageSizeInBytes, 0);
+
+        EXPECT_TRUE(isZeroPage(page));
+    }
+
+    TEST(ZeroPagesTests, isZeroPage_singleNonZeroByteAtAnyOffset_false)
+    {
+        std::vector<uint8_t> page(pageSizeInBytes, 0);
+
+        for (std::size_t offset = 0; offset < page.size(); offset++)
+        {
+            page[offset] = 0x80;
+            EXPECT_FALSE(isZeroPage(page)) << "Offset " << offset;
+            page[offset] = 0;
+        }
+    }
+
+    TEST(ZeroPagesTests, splitAtZeroPageRuns_shortZeroRunWithinAndZeroRunAtEnd_zeroPagesNextToDataKept)
+    {
+        const addr_t regionBase = 0x10000;
+        // Layout: 2 non-zero pages, 1 zero page, 1 non-zero page, 3 zero pages
+        std::vector<uint8_t> pages(7 * pageSizeInBytes, 0);
+        std::fill_n(pages.begin(), 2 * pageSizeInBytes, 1);
+        std::fill_n(pages.begin() + 3 * pageSizeInBytes, pageSizeInBytes, 1);
+        std::vector<MappedRegion> mappedRegions{{regionBase, pages}};
+
+        auto runs = splitAtZeroPageRuns(mappedRegions);
+
+        EXPECT_EQ(runs, (std::vector<MappedRegion>{{regionBase, 5, pages.data()}}));
+    }
+
+    TEST(ZeroPagesTests, splitAtZeroPageRuns_longZeroRunWithin_splitWithZeroPageOnEachSide)
+    {
+        const addr_t regionBase = 0x10000;
+        // Layout: 1 non-zero page, 4 zero pages, 1 non-zero page
+        std::vector<uint8_t> pages(6 * pageSizeInBytes, 0);
+        std::fill_n(pages.begin(), pageSizeInBytes, 1);
+        std::fill_n(pages.begin() + 5 * pageSizeInBytes, pageSizeInBytes, 1);
+        std::vector<MappedRegion> mappedRegions{{regionBase, pages}};
+
+        auto runs = splitAtZeroPageRuns(mappedRegions);
+
+        EXPECT_EQ(runs,
+                  (std::vector<MappedRegion>{
+                      {regionBase, 2, pages.data()},
+                      {regionBase + 4 * pageSizeInBytes, 2, pages.data() + 4 * pageSizeInBytes}}));
+    }
+
+    TEST(ZeroPagesTests, splitAtZeroPageRuns_onlyZeroPages_empty)
+    {
+        std::vector<uint8_t> pages(2 * pageSizeInBytes, 0);
+        std::vector<MappedRegion> mappedRegions{{0x10000, pages}};
+
+        EXPECT_TRUE(splitAtZeroPageRuns(mappedRegions).empty());
+    }
+}
@@ -10,11 +10,22 @@ namespace InMemoryScanner
       public:
         MOCK_METHOD(void, parseConfiguration, (const VmiCore::Plugin::IPluginConfig&), (override));
         MOCK_METHOD(std::filesystem::path, getSignatureFile, (), (const, override));
+        MOCK_METHOD(std::filesystem::path, getRulesCacheDirectory, (), (const, override));
         MOCK_METHOD(std::filesystem::path, getOutputPath, (), (const, override));
         MOCK_METHOD(int, getScanTimeout, (), (const, override));
         MOCK_METHOD(bool, isProcessIgnored, (const std::string& processName), (const, override));
         MOCK_METHOD(bool, isScanAllRegionsActivated, (), (const, override));
         MOCK_METHOD(bool, isDumpingMemoryActivated, (), (const, override));
+        MOCK_METHOD(bool, isAsyncTerminationScanActivated, (), (const, override));
+        MOCK_METHOD(std::size_t, getAsyncScanMemoryLimit, (), (const, override));
+        MOCK_METHOD(std::size_t, getAsyncScanQueueSize, (), (const, override));
+        MOCK_METHOD(std::size_t, getInFlightMemoryLimit, (), (const, override));
+        MOCK_METHOD(std::size_t, getScanCacheSize, (), (const, override));
+        MOCK_METHOD(bool, isRuleProfilingActivated, (), (const, override));
+        MOCK_METHOD(std::size_t, getScanWindowSize, (), (const, override));
+        MOCK_METHOD(std::size_t, getScanWindowOverlap, (), (const, override));
+        MOCK_METHOD(DetectionDumpScope, getDetectionDumpScope, (), (const, override));
+        MOCK_METHOD(int, getDumpCompressionLevel, (), (const, override));
         MOCK_METHOD(void, overrideDumpMemoryFlag, (bool value), (override));
     };
 }
@@ -9,5 +9,7 @@ namespace InMemoryScanner
     {
       public:
         MOCK_METHOD(std::vector<Rule>, scanMemory, (std::span<const VmiCore::MappedRegion>), (override));
+
+        MOCK_METHOD(std::vector<RuleCost>, getRuleCosts, (), (override));
     };
 }
@@ -0,0 +1,22 @@
+#ifndef VMICORE_FILECHUNK_H
+#define VMICORE_FILECHUNK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace VmiCore
+{
+    /**
+     * Part of a file that is written without assembling the whole content in a single buffer first.
+     */
+    struct FileChunk
+    {
+        std::span<const uint8_t> data;
+        /// Number of zero bytes following the data. They are not backed by any buffer and are written as a hole if the
+        /// file is stored on a file system that supports sparse files.
+        std::size_t holeSize = 0;
+    };
+}
+
+#endif // VMICORE_FILECHUNK_H
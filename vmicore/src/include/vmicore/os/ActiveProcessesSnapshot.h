@@ -0,0 +1,23 @@
+#ifndef VMICORE_ACTIVEPROCESSESSNAPSHOT_H
+#define VMICORE_ACTIVEPROCESSESSNAPSHOT_H
+
+#include "ActiveProcessInformation.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace VmiCore
+{
+    /// Immutable view of all processes that have been considered active at a certain point in time. A new snapshot is
+    /// only created whenever a process is added or removed, so holding on to an instance is cheap.
+    struct ActiveProcessesSnapshot
+    {
+        /// Monotonically increasing counter that is incremented every time the set of active processes changes. Two
+        /// snapshots with the same generation contain the same processes.
+        uint64_t generation;
+        /// All processes that have been active when this snapshot was created.
+        std::vector<std::shared_ptr<const ActiveProcessInformation>> processes;
+    };
+}
+
+#endif // VMICORE_ACTIVEPROCESSESSNAPSHOT_H
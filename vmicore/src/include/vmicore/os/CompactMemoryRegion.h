@@ -0,0 +1,67 @@
+#ifndef VMICORE_COMPACTMEMORYREGION_H
+#define VMICORE_COMPACTMEMORYREGION_H
+
+#include "../types.h"
+#include "IPageProtection.h"
+#include "ModuleNameTable.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace VmiCore
+{
+    /**
+     * Flat counterpart of MemoryRegion that does not own any heap memory. See <a href=./MemoryRegion.h>MemoryRegion.h
+     * </a> for the meaning of the individual members.
+     */
+    struct CompactMemoryRegion
+    {
+        addr_t base;
+        uint64_t size;
+        /// Id of the module name in the ModuleNameTable of the CompactMemoryRegions this region belongs to.
+        ModuleNameId moduleName;
+        /// Protection value in the same representation as IPageProtection::getRaw().
+        uint64_t rawProtection;
+        ProtectionValues protection;
+        bool isSharedMemory;
+        bool isBeingDeleted;
+        bool isProcessBaseImage;
+    };
+
+    static_assert(std::is_trivially_copyable_v<CompactMemoryRegion>);
+
+    /**
+     * All memory regions of a process at a certain point in time. The regions are stored in a single contiguous
+     * allocation owned by this object, module names are shared with all other processes.
+     */
+    class CompactMemoryRegions
+    {
+      public:
+        CompactMemoryRegions(std::vector<CompactMemoryRegion> regions,
+                             std::shared_ptr<const ModuleNameTable> moduleNames)
+            : regions(std::move(regions)), moduleNames(std::move(moduleNames))
+        {
+        }
+
+        [[nodiscard]] std::span<const CompactMemoryRegion> get() const
+        {
+            return regions;
+        }
+
+        /// The returned view stays valid as long as this object exists.
+        [[nodiscard]] std::string_view getModuleName(const CompactMemoryRegion& region) const
+        {
+            return moduleNames->get(region.moduleName);
+        }
+
+      private:
+        std::vector<CompactMemoryRegion> regions;
+        std::shared_ptr<const ModuleNameTable> moduleNames;
+    };
+}
+
+#endif // VMICORE_COMPACTMEMORYREGION_H
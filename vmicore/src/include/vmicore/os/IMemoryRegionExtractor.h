@@ -1,12 +1,18 @@
 #ifndef VMICORE_IMEMORYREGIONEXTRACTOR_H
 #define VMICORE_IMEMORYREGIONEXTRACTOR_H
 
+#include "CompactMemoryRegion.h"
 #include "MemoryRegion.h"
+#include "MemoryRegionFilter.h"
+#include <functional>
 #include <memory>
 #include <vector>
 
 namespace VmiCore
 {
+    /// Receives a single memory region. Returning false stops the walk.
+    using MemoryRegionVisitor = std::function<bool(const MemoryRegion&)>;
+
     class IMemoryRegionExtractor
     {
       public:
@@ -17,6 +23,29 @@ namespace VmiCore
          */
         [[nodiscard]] virtual std::unique_ptr<std::vector<MemoryRegion>> extractAllMemoryRegions() const = 0;
 
+        /**
+         * Provides a shared, read-only view of all memory regions for a specific process. Does not guarantee any
+         * ordering. The list is memoized and refreshed incrementally on every call: Only nodes that have changed since
+         * the previous call are decoded again. If nothing has changed, the exact same list instance is returned, so
+         * callers may compare pointers in order to detect modifications. Prefer this function over
+         * extractAllMemoryRegions() if the regions are only inspected, especially if several plugins query the same
+         * process.
+         */
+        [[nodiscard]] virtual std::shared_ptr<const std::vector<MemoryRegion>> getMemoryRegions() const = 0;
+
+        /**
+         * Same as getMemoryRegions() but in a flat representation that requires a single allocation for all regions
+         * instead of two per region. Memoized the same way as getMemoryRegions().
+         */
+        [[nodiscard]] virtual std::shared_ptr<const CompactMemoryRegions> getCompactMemoryRegions() const = 0;
+
+        /**
+         * Walks the memory regions of a specific process and passes each region that matches the filter to the visitor
+         * as soon as it has been decoded. No list of regions is materialized. The walk stops as soon as the visitor
+         * returns false. Regions are only valid for the duration of the visitor call. Does not guarantee any ordering.
+         */
+        virtual void visitMemoryRegions(const MemoryRegionFilter& filter, const MemoryRegionVisitor& visitor) const = 0;
+
       protected:
         IMemoryRegionExtractor() = default;
     };
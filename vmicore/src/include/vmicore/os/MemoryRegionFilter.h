@@ -0,0 +1,63 @@
+#ifndef VMICORE_MEMORYREGIONFILTER_H
+#define VMICORE_MEMORYREGIONFILTER_H
+
+#include "MemoryRegion.h"
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace VmiCore
+{
+    /**
+     * Criteria that are evaluated while the memory regions of a process are being walked. Criteria that can be decided
+     * from the raw kernel structures are checked before any further guest memory is read, e.g. private memory is
+     * skipped without resolving file names if only file-backed regions are requested. All criteria have to match.
+     */
+    struct MemoryRegionFilter
+    {
+        /// Only yield regions that are executable.
+        bool onlyExecutable = false;
+        /// Only yield regions that are backed by a file on disk.
+        bool onlyFileBacked = false;
+        /// Only yield regions backed by a file with the given name, e.g. "ntdll.dll". The comparison only considers the
+        /// last component of the path and ignores case. Implies onlyFileBacked.
+        std::optional<std::string> moduleName = std::nullopt;
+
+        [[nodiscard]] bool requiresFileBacking() const
+        {
+            return onlyFileBacked || moduleName.has_value();
+        }
+
+        [[nodiscard]] bool matches(const MemoryRegion& region) const
+        {
+            if (onlyExecutable && !region.protection->get().executable)
+            {
+                return false;
+            }
+            if (requiresFileBacking() && region.moduleName.empty())
+            {
+                return false;
+            }
+            if (moduleName)
+            {
+                std::string_view fileName(region.moduleName);
+                if (auto separator = fileName.find_last_of("\\/"); separator != std::string_view::npos)
+                {
+                    fileName.remove_prefix(separator + 1);
+                }
+                return std::ranges::equal(fileName,
+                                          *moduleName,
+                                          [](char lhs, char rhs)
+                                          {
+                                              return std::tolower(static_cast<unsigned char>(lhs)) ==
+                                                     std::tolower(static_cast<unsigned char>(rhs));
+                                          });
+            }
+            return true;
+        }
+    };
+}
+
+#endif // VMICORE_MEMORYREGIONFILTER_H
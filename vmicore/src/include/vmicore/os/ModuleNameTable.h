@@ -0,0 +1,110 @@
+#ifndef VMICORE_MODULENAMETABLE_H
+#define VMICORE_MODULENAMETABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace VmiCore
+{
+    using ModuleNameId = uint32_t;
+
+    /**
+     * Append-only table of interned module names that is shared between all processes. Every distinct name is stored
+     * exactly once and identified by a small integer. Ids and the views returned by get() stay valid for the lifetime
+     * of the table. Its growth is bounded by ModuleNameTableGenerations. Thread safe.
+     */
+    class ModuleNameTable
+    {
+      public:
+        /// Id of the empty name, used for regions that are not backed by a file.
+        constexpr static ModuleNameId noModuleName = 0;
+
+        ModuleNameTable()
+        {
+            idsByName.emplace(names.emplace_back(), noModuleName);
+        }
+
+        /// Returns the id of the given name. The name is added to the table if it is not known yet.
+        [[nodiscard]] ModuleNameId intern(std::string_view name)
+        {
+            {
+                std::shared_lock<std::shared_mutex> lock(tableLock);
+                if (auto id = idsByName.find(name); id != idsByName.end())
+                {
+                    return id->second;
+                }
+            }
+            std::unique_lock<std::shared_mutex> lock(tableLock);
+            if (auto id = idsByName.find(name); id != idsByName.end())
+            {
+                return id->second;
+            }
+            auto id = static_cast<ModuleNameId>(names.size());
+            // Elements of a deque are never relocated on insertion at the end, so the view on the new element is stable
+            idsByName.emplace(names.emplace_back(name), id);
+            return id;
+        }
+
+        [[nodiscard]] std::string_view get(ModuleNameId id) const
+        {
+            std::shared_lock<std::shared_mutex> lock(tableLock);
+            if (id >= names.size())
+            {
+                throw std::out_of_range("Unknown module name id " + std::to_string(id));
+            }
+            return names[id];
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            std::shared_lock<std::shared_mutex> lock(tableLock);
+            return names.size();
+        }
+
+      private:
+        mutable std::shared_mutex tableLock;
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, ModuleNameId> idsByName;
+    };
+
+    /**
+     * Provides the module name table that new region lists intern their names into. Once the current table holds the
+     * given number of names, a new generation is started instead of growing it any further, e.g. on guests that keep
+     * mapping uniquely named temporary files. Region lists keep the table they have been created with alive, so an old
+     * generation is released as soon as no region list refers to it anymore. Thread safe.
+     */
+    class ModuleNameTableGenerations
+    {
+      public:
+        constexpr static std::size_t defaultMaxNamesPerGeneration = 0x10000;
+
+        explicit ModuleNameTableGenerations(std::size_t maxNamesPerGeneration = defaultMaxNamesPerGeneration)
+            : maxNamesPerGeneration(maxNamesPerGeneration)
+        {
+        }
+
+        [[nodiscard]] std::shared_ptr<ModuleNameTable> getCurrent()
+        {
+            std::lock_guard<std::mutex> lock(generationLock);
+            if (currentTable->size() >= maxNamesPerGeneration)
+            {
+                currentTable = std::make_shared<ModuleNameTable>();
+            }
+            return currentTable;
+        }
+
+      private:
+        std::size_t maxNamesPerGeneration;
+        std::mutex generationLock;
+        std::shared_ptr<ModuleNameTable> currentTable = std::make_shared<ModuleNameTable>();
+    };
+}
+
+#endif // VMICORE_MODULENAMETABLE_H
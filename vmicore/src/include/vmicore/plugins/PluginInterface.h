@@ -1,8 +1,11 @@
 #ifndef VMICORE_PLUGININTERFACE_H
 #define VMICORE_PLUGININTERFACE_H
 
+#include "../io/FileChunk.h"
 #include "../io/ILogger.h"
 #include "../os/ActiveProcessInformation.h"
+#include "../os/ActiveProcessesSnapshot.h"
+#include "../threading/ITaskHandle.h"
 #include "../types.h"
 #include "../vmi/BpResponse.h"
 #include "../vmi/IBreakpoint.h"
@@ -11,6 +14,8 @@
 #include "../vmi/events/IInterruptEvent.h"
 #include <functional>
 #include <memory>
+#include <span>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -23,7 +28,7 @@ namespace VmiCore::Plugin
     class PluginInterface
     {
       public:
-        constexpr static uint8_t API_VERSION = 16;
+        constexpr static uint8_t API_VERSION = 28;
 
         virtual ~PluginInterface() = default;
 
@@ -46,6 +51,45 @@ namespace VmiCore::Plugin
         [[nodiscard]] virtual std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
         getRunningProcesses() const = 0;
 
+        /**
+         * Obtain a shared, immutable snapshot of all currently running processes. In contrast to getRunningProcesses()
+         * this neither reads guest memory nor copies the process list. The snapshot is replaced as a whole whenever a
+         * process starts or terminates, so comparing the generation of two snapshots is sufficient to detect changes.
+         */
+        [[nodiscard]] virtual std::shared_ptr<const ActiveProcessesSnapshot> getRunningProcessesSnapshot() const = 0;
+
+        /**
+         * Look up a running process by one of its directory table bases. Both the kernel and the user dtb of a process
+         * are accepted, page offset bits (e.g. a PCID) are ignored. The lookup is served from an index that is kept up
+         * to date by process start and termination events and therefore does not read any guest memory.
+         *
+         * @param dtb A directory table base, e.g. the CR3 value of an interrupt event.
+         * @return The corresponding process information or nullptr if no running process uses this dtb.
+         */
+        [[nodiscard]] virtual std::shared_ptr<const ActiveProcessInformation>
+        getProcessInformationByDtb(addr_t dtb) const = 0;
+
+        /**
+         * Obtain all running processes that have been started by the given process, either directly or by one of its
+         * descendants. Processes whose parent has already terminated are still reported. The result is served from a
+         * process tree that is maintained on process start and termination, so only the result itself is visited.
+         *
+         * @param pid Process id of the root of the subtree. The process itself is not part of the result.
+         * @return Descendants in breadth first order. Empty if the pid is unknown.
+         */
+        [[nodiscard]] virtual std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getProcessDescendants(pid_t pid) const = 0;
+
+        /**
+         * Obtain the chain of running processes that the given process descends from. Terminated ancestors are
+         * skipped, the chain ends at the first process whose parent is unknown.
+         *
+         * @param pid Process id of the process whose ancestors should be reported.
+         * @return Ancestors starting with the direct parent. Empty if the pid is unknown.
+         */
+        [[nodiscard]] virtual std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getProcessAncestors(pid_t pid) const = 0;
+
         /**
          * Subscribe to process start events. The supplied lambda function will be called once the event occurs.
          *
@@ -94,17 +138,27 @@ namespace VmiCore::Plugin
         [[nodiscard]] virtual std::unique_ptr<ILogger> newNamedLogger(std::string_view name) const = 0;
 
         /**
-         * Saves content to a file with the given name. Does not append. Saving the same file more than once is
-         * undefined behavior. Use the other overload for raw data.
+         * Appends content to a file with the given name, which is created by the first call. Content is handed to the
+         * file transport right away, so that results written incrementally survive an abnormal termination. Use the
+         * other overload for raw data.
          */
         virtual void writeToFile(const std::string& filename, const std::string& message) const = 0;
 
         /**
-         * Saves content to a file with the given name. Does not append. Saving the same file more than once is
-         * undefined behavior. Use the other overload for strings.
+         * Appends content to a file with the given name, which is created by the first call. Use the other overload for
+         * strings.
          */
         virtual void writeToFile(const std::string& filename, const std::vector<uint8_t>& data) const = 0;
 
+        /**
+         * Appends the concatenation of all chunks to a file with the given name. In contrast to the other overloads,
+         * the data does not have to be assembled in a single buffer. Zero filled parts, e.g. padding, can be described
+         * as holes instead of being backed by memory. Returns false if the chunks could not be written, in which case a
+         * part of them may have been appended nevertheless.
+         */
+        [[nodiscard]] virtual bool writeToFile(const std::string& filename,
+                                               std::span<const FileChunk> chunks) const = 0;
+
         /**
          * Only useful if using a gRPC connection, does nothing otherwise. Will send an error event via a separate
          * channel which indicates that the run is not successful.
@@ -125,6 +179,28 @@ namespace VmiCore::Plugin
          */
         [[nodiscard]] virtual std::shared_ptr<IIntrospectionAPI> getIntrospectionAPI() const = 0;
 
+        /**
+         * Runs a function on the worker pool that is shared by VMICore and all plugins. Plugins should use this instead
+         * of spawning their own threads, so that the total number of threads stays bounded. Tasks that are submitted
+         * from within a running task are preferably executed by the same worker. Tasks that have not been started yet
+         * are skipped once plugins are being unloaded, so a plugin has to wait for its tasks in IPlugin::unload if it
+         * depends on their completion.
+         *
+         * @param function Work to perform. The stop token indicates that cancellation has been requested.
+         * @return Handle for waiting on or cancelling the task. See ITaskHandle.h for details.
+         */
+        [[nodiscard]] virtual std::shared_ptr<ITaskHandle>
+        submitTask(std::function<void(std::stop_token)> function) const = 0;
+
+        /**
+         * Runs a single pending task of the worker pool on the calling thread, provided that it is a worker itself. A
+         * task that has to wait for resources held by other tasks should call this while waiting, so that it does not
+         * occupy a worker that the other tasks need in order to make progress.
+         *
+         * @return False if there was no pending task or the caller is not a worker.
+         */
+        virtual bool runPendingTask() const = 0;
+
       protected:
         PluginInterface() = default;
     };
@@ -0,0 +1,42 @@
+#ifndef VMICORE_ITASKHANDLE_H
+#define VMICORE_ITASKHANDLE_H
+
+namespace VmiCore
+{
+    /**
+     * Handle of a task that has been submitted to the worker pool of VMICore.
+     */
+    class ITaskHandle
+    {
+      public:
+        virtual ~ITaskHandle() = default;
+
+        /**
+         * Requests cancellation of the task. A task that has not been started yet will not run at all. A running task
+         * is notified via the stop token that has been passed to it and may decide to finish early.
+         */
+        virtual void cancel() = 0;
+
+        /**
+         * Blocks until the task has either finished or been skipped due to cancellation. If the task has thrown an
+         * exception, it is rethrown. Waiting from within another task of the pool is allowed, the waiting worker will
+         * process other pending tasks in the meantime.
+         */
+        virtual void wait() = 0;
+
+        /**
+         * @return True if the task has finished or been skipped due to cancellation.
+         */
+        [[nodiscard]] virtual bool isDone() const = 0;
+
+        /**
+         * @return True if cancellation has been requested.
+         */
+        [[nodiscard]] virtual bool isCancelled() const = 0;
+
+      protected:
+        ITaskHandle() = default;
+    };
+}
+
+#endif // VMICORE_ITASKHANDLE_H
@@ -1,6 +1,7 @@
 #ifndef VMICORE_IINTERRUPTEVENT_H
 #define VMICORE_IINTERRUPTEVENT_H
 
+#include "../../os/ActiveProcessInformation.h"
 #include "../../types.h"
 #include "IRegisterReadable.h"
 
@@ -30,6 +31,15 @@ namespace VmiCore
          */
         [[nodiscard]] virtual addr_t getOffset() const = 0;
 
+        /**
+         * Retrieve the process whose address space has been active when the event occurred. The lookup is based on
+         * the current CR3 value and does not require any guest memory reads.
+         *
+         * @return The corresponding process information or nullptr if the CR3 value does not belong to any known
+         * process.
+         */
+        [[nodiscard]] virtual std::shared_ptr<const ActiveProcessInformation> getProcessInformation() const = 0;
+
       protected:
         IInterruptEvent() = default;
     };
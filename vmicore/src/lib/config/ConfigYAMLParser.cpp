@@ -16,6 +16,10 @@ namespace VmiCore
         }
         configuration.offsetsFile = configRootNode["vm"]["offsets_file"].as<std::string>();
         configuration.pluginDirectory = configRootNode["plugin_system"]["directory"].as<std::string>();
+        if (configRootNode["plugin_system"]["worker_threads"].IsDefined())
+        {
+            configuration.workerThreadCount = configRootNode["plugin_system"]["worker_threads"].as<std::size_t>();
+        }
 
         for (const auto& node : configRootNode["plugin_system"]["plugins"])
         {
@@ -75,6 +79,11 @@ namespace VmiCore
         return configuration.pluginDirectory;
     }
 
+    std::size_t ConfigYAMLParser::getWorkerThreadCount() const
+    {
+        return configuration.workerThreadCount;
+    }
+
     const std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>>&
     ConfigYAMLParser::getPlugins() const
     {
@@ -33,6 +33,8 @@ namespace VmiCore
 
         [[nodiscard]] std::filesystem::path getPluginDirectory() const override;
 
+        [[nodiscard]] std::size_t getWorkerThreadCount() const override;
+
         [[nodiscard]] const std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>>&
         getPlugins() const override;
 
@@ -45,6 +47,7 @@ namespace VmiCore
             std::filesystem::path socketPath;
             std::string offsetsFile;
             std::filesystem::path pluginDirectory;
+            std::size_t workerThreadCount = 0;
             std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>> plugins{};
         };
         vmiConfiguration configuration;
@@ -1,6 +1,7 @@
 #ifndef VMICORE_CONFIGPARSER_H
 #define VMICORE_CONFIGPARSER_H
 
+#include <cstddef>
 #include <filesystem>
 #include <map>
 #include <memory>
@@ -36,6 +37,9 @@ namespace VmiCore
 
         [[nodiscard]] virtual std::filesystem::path getPluginDirectory() const = 0;
 
+        /// Number of threads of the shared worker pool. Zero selects the number of hardware threads.
+        [[nodiscard]] virtual std::size_t getWorkerThreadCount() const = 0;
+
         [[nodiscard]] virtual const std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>>&
         getPlugins() const = 0;
 
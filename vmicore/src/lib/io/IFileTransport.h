@@ -2,7 +2,9 @@
 #define VMICORE_IFILETRANSPORT_H
 
 #include <cstdint>
+#include <span>
 #include <string_view>
+#include <vmicore/io/FileChunk.h>
 #include <vector>
 
 namespace VmiCore
@@ -12,8 +14,12 @@ namespace VmiCore
       public:
         virtual ~IFileTransport() = default;
 
+        /// Appends the data to the file, which is created if it does not exist yet.
         virtual void saveBinaryToFile(std::string_view logFileName, const std::vector<uint8_t>& data) = 0;
 
+        /// Appends the concatenation of all chunks to the file without assembling them in a single buffer first.
+        virtual void saveBinaryToFile(std::string_view logFileName, std::span<const FileChunk> chunks) = 0;
+
       protected:
         IFileTransport() = default;
     };
@@ -1,7 +1,15 @@
 #include "LegacyLogging.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <cstdint>
 #include <exception>
+#include <fcntl.h>
 #include <filesystem>
+#include <fmt/core.h>
+#include <sys/uio.h>
+#include <system_error>
+#include <unistd.h>
 
 namespace VmiCore
 {
@@ -12,12 +20,7 @@ namespace VmiCore
 
     void LegacyLogging::saveBinaryToFile(std::string_view logFileName, const std::vector<uint8_t>& data)
     {
-        auto path = configInterface->getResultsDirectory() / logFileName;
-        auto parentPath = path.parent_path();
-        if (!parentPath.empty())
-        {
-            std::filesystem::create_directories(parentPath);
-        }
+        auto path = createFilePath(logFileName);
 
         std::ofstream ofStream;
         ofStream.exceptions(std::ios::failbit | std::ios::badbit);
@@ -33,4 +36,108 @@ namespace VmiCore
         }
         ofStream.close();
     }
+
+    void LegacyLogging::saveBinaryToFile(std::string_view logFileName, std::span<const FileChunk> chunks)
+    {
+        auto path = createFilePath(logFileName);
+
+        // Not opened in append mode, because holes are created by seeking past the end of the file
+        auto fileDescriptor = open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+        if (fileDescriptor < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), fmt::format("Unable to open {}", path.string()));
+        }
+
+        try
+        {
+            auto fileOffset = seekFile(fileDescriptor, 0, SEEK_END, path);
+            std::vector<iovec> ioVectors;
+            ioVectors.reserve(chunks.size());
+            for (const auto& chunk : chunks)
+            {
+                if (!chunk.data.empty())
+                {
+                    // writev does not modify the buffers despite the non const pointer
+                    ioVectors.push_back({const_cast<uint8_t*>(chunk.data.data()), chunk.data.size()});
+                    fileOffset += static_cast<off_t>(chunk.data.size());
+                }
+                if (chunk.holeSize > 0)
+                {
+                    writeVectors(fileDescriptor, ioVectors, path);
+                    ioVectors.clear();
+                    fileOffset = seekFile(fileDescriptor, static_cast<off_t>(chunk.holeSize), SEEK_CUR, path);
+                }
+            }
+            writeVectors(fileDescriptor, ioVectors, path);
+
+            // Seeking alone does not extend the file, which matters if it ends with a hole
+            if (ftruncate(fileDescriptor, fileOffset) != 0)
+            {
+                throw std::system_error(
+                    errno, std::generic_category(), fmt::format("Unable to resize {}", path.string()));
+            }
+        }
+        catch (const std::exception&)
+        {
+            close(fileDescriptor);
+            throw;
+        }
+
+        close(fileDescriptor);
+    }
+
+    void
+    LegacyLogging::writeVectors(int fileDescriptor, std::vector<iovec>& ioVectors, const std::filesystem::path& path)
+    {
+        std::size_t currentVector = 0;
+        while (currentVector < ioVectors.size())
+        {
+            auto vectorCount = std::min(ioVectors.size() - currentVector, static_cast<std::size_t>(IOV_MAX));
+            auto writtenBytes = writev(fileDescriptor, &ioVectors[currentVector], static_cast<int>(vectorCount));
+            if (writtenBytes < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::system_error(
+                    errno, std::generic_category(), fmt::format("Unable to write {}", path.string()));
+            }
+
+            // Skip all completely written vectors and continue within a partially written one
+            auto remainingBytes = static_cast<std::size_t>(writtenBytes);
+            while (currentVector < ioVectors.size() && remainingBytes >= ioVectors[currentVector].iov_len)
+            {
+                remainingBytes -= ioVectors[currentVector].iov_len;
+                currentVector++;
+            }
+            if (remainingBytes > 0)
+            {
+                auto& partialVector = ioVectors[currentVector];
+                partialVector.iov_base = static_cast<uint8_t*>(partialVector.iov_base) + remainingBytes;
+                partialVector.iov_len -= remainingBytes;
+            }
+        }
+    }
+
+    off_t LegacyLogging::seekFile(int fileDescriptor, off_t offset, int whence, const std::filesystem::path& path)
+    {
+        auto fileOffset = lseek(fileDescriptor, offset, whence);
+        if (fileOffset < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), fmt::format("Unable to seek in {}", path.string()));
+        }
+        return fileOffset;
+    }
+
+    std::filesystem::path LegacyLogging::createFilePath(std::string_view logFileName) const
+    {
+        auto path = configInterface->getResultsDirectory() / logFileName;
+        auto parentPath = path.parent_path();
+        if (!parentPath.empty())
+        {
+            std::filesystem::create_directories(parentPath);
+        }
+        return path;
+    }
 }
@@ -3,9 +3,13 @@
 
 #include "../../config/IConfigParser.h"
 #include "../IFileTransport.h"
+#include <filesystem>
 #include <fstream>
 #include <map>
 #include <memory>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <vector>
 
 namespace VmiCore
 {
@@ -17,8 +21,19 @@ namespace VmiCore
 
         void saveBinaryToFile(std::string_view logFileName, const std::vector<uint8_t>& data) override;
 
+        /// The file is not opened with O_APPEND, but written at the end of the file as determined on opening it.
+        /// Appends are therefore only safe as long as there is a single writer per file.
+        void saveBinaryToFile(std::string_view logFileName, std::span<const FileChunk> chunks) override;
+
       private:
         std::shared_ptr<IConfigParser> configInterface;
+
+        [[nodiscard]] std::filesystem::path createFilePath(std::string_view logFileName) const;
+
+        /// Writes all vectors completely. Vectors are modified in case of partial writes.
+        static void writeVectors(int fileDescriptor, std::vector<iovec>& ioVectors, const std::filesystem::path& path);
+
+        static off_t seekFile(int fileDescriptor, off_t offset, int whence, const std::filesystem::path& path);
     };
 }
 
@@ -47,6 +47,24 @@ namespace VmiCore
         (*server)->write_message_to_file(toRustStr(logFileName), data);
     }
 
+    void GRPCServer::saveBinaryToFile(std::string_view logFileName, std::span<const FileChunk> chunks)
+    {
+        // The file content is sent as a single message, so the chunks have to be assembled anyway
+        std::size_t size = 0;
+        for (const auto& chunk : chunks)
+        {
+            size += chunk.data.size() + chunk.holeSize;
+        }
+        std::vector<uint8_t> data;
+        data.reserve(size);
+        for (const auto& chunk : chunks)
+        {
+            data.insert(data.end(), chunk.data.begin(), chunk.data.end());
+            data.resize(data.size() + chunk.holeSize);
+        }
+        saveBinaryToFile(logFileName, data);
+    }
+
     void GRPCServer::sendProcessEvent(::grpc::ProcessState processState,
                                       std::string_view processName,
                                       uint32_t processID,
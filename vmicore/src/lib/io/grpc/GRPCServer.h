@@ -29,6 +29,8 @@ namespace VmiCore
 
         void saveBinaryToFile(std::string_view logFileName, const std::vector<uint8_t>& data) override;
 
+        void saveBinaryToFile(std::string_view logFileName, std::span<const FileChunk> chunks) override;
+
         void sendProcessEvent(::grpc::ProcessState processState,
                               std::string_view processName,
                               uint32_t processID,
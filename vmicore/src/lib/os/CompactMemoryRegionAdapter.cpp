@@ -0,0 +1,46 @@
+#include "CompactMemoryRegionAdapter.h"
+#include "PageProtection.h"
+
+namespace VmiCore
+{
+    CompactMemoryRegion toCompactMemoryRegion(addr_t base,
+                                              uint64_t size,
+                                              ModuleNameId moduleName,
+                                              uint64_t rawProtection,
+                                              OperatingSystem os,
+                                              bool isSharedMemory,
+                                              bool isBeingDeleted,
+                                              bool isProcessBaseImage)
+    {
+        return {.base = base,
+                .size = size,
+                .moduleName = moduleName,
+                .rawProtection = rawProtection,
+                .protection = PageProtection(rawProtection, os).get(),
+                .isSharedMemory = isSharedMemory,
+                .isBeingDeleted = isBeingDeleted,
+                .isProcessBaseImage = isProcessBaseImage};
+    }
+
+    MemoryRegion toMemoryRegion(const CompactMemoryRegion& region, std::string_view moduleName, OperatingSystem os)
+    {
+        return {region.base,
+                region.size,
+                std::string(moduleName),
+                std::make_unique<PageProtection>(region.rawProtection, os),
+                region.isSharedMemory,
+                region.isBeingDeleted,
+                region.isProcessBaseImage};
+    }
+
+    std::unique_ptr<std::vector<MemoryRegion>> toMemoryRegions(const CompactMemoryRegions& regions, OperatingSystem os)
+    {
+        auto memoryRegions = std::make_unique<std::vector<MemoryRegion>>();
+        memoryRegions->reserve(regions.get().size());
+        for (const auto& region : regions.get())
+        {
+            memoryRegions->push_back(toMemoryRegion(region, regions.getModuleName(region), os));
+        }
+        return memoryRegions;
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef VMICORE_COMPACTMEMORYREGIONADAPTER_H
+#define VMICORE_COMPACTMEMORYREGIONADAPTER_H
+
+#include <memory>
+#include <string_view>
+#include <vector>
+#include <vmicore/os/CompactMemoryRegion.h>
+#include <vmicore/os/MemoryRegion.h>
+#include <vmicore/os/OperatingSystem.h>
+
+namespace VmiCore
+{
+    [[nodiscard]] CompactMemoryRegion toCompactMemoryRegion(addr_t base,
+                                                            uint64_t size,
+                                                            ModuleNameId moduleName,
+                                                            uint64_t rawProtection,
+                                                            OperatingSystem os,
+                                                            bool isSharedMemory,
+                                                            bool isBeingDeleted,
+                                                            bool isProcessBaseImage);
+
+    [[nodiscard]] MemoryRegion
+    toMemoryRegion(const CompactMemoryRegion& region, std::string_view moduleName, OperatingSystem os);
+
+    [[nodiscard]] std::unique_ptr<std::vector<MemoryRegion>> toMemoryRegions(const CompactMemoryRegions& regions,
+                                                                           OperatingSystem os);
+}
+
+#endif // VMICORE_COMPACTMEMORYREGIONADAPTER_H
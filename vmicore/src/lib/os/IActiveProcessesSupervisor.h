@@ -5,6 +5,7 @@
 #include <memory>
 #include <vector>
 #include <vmicore/os/ActiveProcessInformation.h>
+#include <vmicore/os/ActiveProcessesSnapshot.h>
 
 namespace VmiCore
 {
@@ -22,6 +23,9 @@ namespace VmiCore
         [[nodiscard]] virtual std::shared_ptr<ActiveProcessInformation>
         getProcessInformationByBase(uint64_t base) const = 0;
 
+        [[nodiscard]] virtual std::shared_ptr<ActiveProcessInformation>
+        getProcessInformationByDtb(uint64_t dtb) const = 0;
+
         virtual void addNewProcess(uint64_t base) = 0;
 
         virtual void removeActiveProcess(uint64_t base) = 0;
@@ -29,6 +33,14 @@ namespace VmiCore
         [[nodiscard]] virtual std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
         getActiveProcesses() const = 0;
 
+        [[nodiscard]] virtual std::shared_ptr<const ActiveProcessesSnapshot> getActiveProcessesSnapshot() const = 0;
+
+        [[nodiscard]] virtual std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getProcessDescendants(pid_t pid) const = 0;
+
+        [[nodiscard]] virtual std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getProcessAncestors(pid_t pid) const = 0;
+
       protected:
         IActiveProcessesSupervisor() = default;
     };
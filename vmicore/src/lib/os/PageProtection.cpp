@@ -5,7 +5,7 @@
 
 namespace VmiCore
 {
-    PageProtection::PageProtection(uint32_t value, OperatingSystem os) : raw(value), os(os)
+    PageProtection::PageProtection(uint64_t value, OperatingSystem os) : raw(value), os(os)
     {
         switch (os)
         {
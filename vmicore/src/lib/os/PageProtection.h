@@ -13,7 +13,7 @@ namespace VmiCore
       public:
         PageProtection() = default;
 
-        PageProtection(uint32_t value, OperatingSystem os);
+        PageProtection(uint64_t value, OperatingSystem os);
 
         [[nodiscard]] ProtectionValues get() const override;
 
@@ -23,7 +23,7 @@ namespace VmiCore
 
       private:
         ProtectionValues protection{};
-        uint32_t raw = 0;
+        uint64_t raw = 0;
         OperatingSystem os = OperatingSystem::INVALID;
     };
 }
@@ -0,0 +1,139 @@
+#include "ProcessTree.h"
+
+namespace VmiCore
+{
+    void ProcessTree::addProcess(const std::shared_ptr<const ActiveProcessInformation>& processInformation)
+    {
+        std::scoped_lock<std::mutex> lock(treeLock);
+
+        // References to elements of an unordered_map stay valid when other elements are inserted
+        auto& node = nodes[processInformation->pid];
+        // Everything that is still attached to this pid belongs to its previous owner
+        detachChildren(node);
+        unlinkFromParent(processInformation->pid, node);
+        node.processInformation = processInformation;
+
+        if (processInformation->parentPid != processInformation->pid)
+        {
+            node.parentPid = processInformation->parentPid;
+            nodes[processInformation->parentPid].childPids.insert(processInformation->pid);
+        }
+    }
+
+    void ProcessTree::removeProcess(const std::shared_ptr<const ActiveProcessInformation>& processInformation)
+    {
+        std::scoped_lock<std::mutex> lock(treeLock);
+
+        auto nodeIterator = nodes.find(processInformation->pid);
+        if (nodeIterator == nodes.end() || nodeIterator->second.processInformation != processInformation)
+        {
+            return;
+        }
+        nodeIterator->second.processInformation.reset();
+        erasePlaceholderIfUnused(processInformation->pid);
+    }
+
+    std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+    ProcessTree::getDescendants(pid_t pid) const
+    {
+        auto descendants = std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>();
+        std::scoped_lock<std::mutex> lock(treeLock);
+
+        auto nodeIterator = nodes.find(pid);
+        if (nodeIterator == nodes.end())
+        {
+            return descendants;
+        }
+
+        std::vector<pid_t> pendingPids(nodeIterator->second.childPids.cbegin(), nodeIterator->second.childPids.cend());
+        for (std::size_t i = 0; i < pendingPids.size(); i++)
+        {
+            const auto& node = nodes.at(pendingPids[i]);
+            if (node.processInformation)
+            {
+                descendants->push_back(node.processInformation);
+            }
+            pendingPids.insert(pendingPids.end(), node.childPids.cbegin(), node.childPids.cend());
+        }
+
+        return descendants;
+    }
+
+    std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+    ProcessTree::getAncestors(pid_t pid) const
+    {
+        auto ancestors = std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>();
+        std::scoped_lock<std::mutex> lock(treeLock);
+
+        auto nodeIterator = nodes.find(pid);
+        if (nodeIterator == nodes.end())
+        {
+            return ancestors;
+        }
+
+        // Pids are detached from their children on reuse, so the tree is acyclic. The bound is merely defensive.
+        auto parentPid = nodeIterator->second.parentPid;
+        for (std::size_t depth = 0; parentPid && depth < nodes.size(); depth++)
+        {
+            nodeIterator = nodes.find(*parentPid);
+            if (nodeIterator == nodes.end())
+            {
+                break;
+            }
+            if (nodeIterator->second.processInformation)
+            {
+                ancestors->push_back(nodeIterator->second.processInformation);
+            }
+            parentPid = nodeIterator->second.parentPid;
+        }
+
+        return ancestors;
+    }
+
+    void ProcessTree::detachChildren(Node& node)
+    {
+        for (auto childPid : node.childPids)
+        {
+            nodes.at(childPid).parentPid.reset();
+        }
+        node.childPids.clear();
+    }
+
+    void ProcessTree::unlinkFromParent(pid_t pid, Node& node)
+    {
+        if (!node.parentPid)
+        {
+            return;
+        }
+        auto parentPid = *node.parentPid;
+        node.parentPid.reset();
+        if (auto parentIterator = nodes.find(parentPid); parentIterator != nodes.end())
+        {
+            parentIterator->second.childPids.erase(pid);
+            erasePlaceholderIfUnused(parentPid);
+        }
+    }
+
+    void ProcessTree::erasePlaceholderIfUnused(pid_t pid)
+    {
+        // Removing a placeholder may leave its parent as an unused placeholder as well
+        for (auto nodeIterator = nodes.find(pid); nodeIterator != nodes.end(); nodeIterator = nodes.find(pid))
+        {
+            if (nodeIterator->second.processInformation || !nodeIterator->second.childPids.empty())
+            {
+                return;
+            }
+            auto parentPid = nodeIterator->second.parentPid;
+            nodes.erase(nodeIterator);
+            if (!parentPid)
+            {
+                return;
+            }
+            if (auto parentIterator = nodes.find(*parentPid); parentIterator != nodes.end())
+            {
+                parentIterator->second.childPids.erase(pid);
+            }
+            pid = *parentPid;
+        }
+    }
+}
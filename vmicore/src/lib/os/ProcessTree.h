@@ -0,0 +1,57 @@
+#ifndef VMICORE_PROCESSTREE_H
+#define VMICORE_PROCESSTREE_H
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <vmicore/os/ActiveProcessInformation.h>
+
+namespace VmiCore
+{
+    /**
+     * Parent/child index of all active processes. Processes that exit while still having active children are kept as
+     * placeholders, so that descendants stay reachable through them. Since a child can never be created before its
+     * parent, children that are still attached to a pid when a new process with that pid appears belong to the
+     * previous owner of the pid and are detached.
+     */
+    class ProcessTree
+    {
+      public:
+        void addProcess(const std::shared_ptr<const ActiveProcessInformation>& processInformation);
+
+        /// Only removes the process if it is still the one that is stored for its pid.
+        void removeProcess(const std::shared_ptr<const ActiveProcessInformation>& processInformation);
+
+        /// All active processes that have been started by the given process directly or indirectly in breadth first
+        /// order. Children of exited processes are included. Unknown pids yield an empty result.
+        [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getDescendants(pid_t pid) const;
+
+        /// All active ancestors of the given process, starting with its parent. Exited ancestors are skipped.
+        [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getAncestors(pid_t pid) const;
+
+      private:
+        struct Node
+        {
+            /// Null for placeholders of exited processes.
+            std::shared_ptr<const ActiveProcessInformation> processInformation;
+            std::optional<pid_t> parentPid;
+            std::unordered_set<pid_t> childPids;
+        };
+
+        mutable std::mutex treeLock;
+        std::unordered_map<pid_t, Node> nodes;
+
+        void detachChildren(Node& node);
+
+        void unlinkFromParent(pid_t pid, Node& node);
+
+        void erasePlaceholderIfUnused(pid_t pid);
+    };
+}
+
+#endif // VMICORE_PROCESSTREE_H
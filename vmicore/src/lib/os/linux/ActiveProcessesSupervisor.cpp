@@ -5,6 +5,7 @@
 #include <fmt/core.h>
 #include <string>
 #include <vmicore/filename.h>
+#include <vmicore/os/PagingDefinitions.h>
 
 namespace VmiCore::Linux
 {
@@ -16,7 +17,7 @@ namespace VmiCore::Linux
           logging(loggingLib),
           logger(loggingLib->newNamedLogger(FILENAME_STEM)),
           eventStream(std::move(eventStream)),
-          pathExtractor(std::move(vmiInterface), loggingLib)
+          pathExtractor(std::make_shared<PathExtractor>(std::move(vmiInterface), loggingLib))
     {
     }
 
@@ -34,6 +35,8 @@ namespace VmiCore::Linux
             pti = x86CapabilityEntry & PTI_FEATURE_MASK;
         }
 
+        vmAreaWalker = createVmAreaWalker();
+
         logger->info("--- Initialization ---");
         auto taskOffset = vmiInterface->getOffset("linux_tasks");
         auto initTaskVA = vmiInterface->translateKernelSymbolToVA("init_task") + taskOffset;
@@ -64,14 +67,15 @@ namespace VmiCore::Linux
                                             vmiInterface->convertPidToDtb(SYSTEM_PID));
             processInformation->processUserDtb =
                 pti ? processInformation->processDtb + USER_DTB_OFFSET : processInformation->processDtb;
-            processInformation->processPath = std::make_unique<std::string>(pathExtractor.extractDPath(
+            processInformation->processPath = std::make_unique<std::string>(pathExtractor->extractDPath(
                 vmiInterface->read64VA(mm + vmiInterface->getKernelStructOffset("mm_struct", "exe_file"),
                                        vmiInterface->convertPidToDtb(SYSTEM_PID)) +
                 vmiInterface->getKernelStructOffset("file", "f_path")));
             processInformation->fullName = processInformation->processPath
                                                ? splitProcessFileNameFromPath(*processInformation->processPath)
                                                : nullptr;
-            processInformation->memoryRegionExtractor = std::make_unique<MMExtractor>(vmiInterface, logging, mm);
+            processInformation->memoryRegionExtractor =
+                std::make_unique<MMExtractor>(vmiInterface, logging, pathExtractor, vmAreaWalker, moduleNameTables, mm);
         }
 
         processInformation->pid = extractPid(taskStruct);
@@ -131,6 +135,18 @@ namespace VmiCore::Linux
         return getProcessInformationByPid(pidIterator->second);
     }
 
+    std::shared_ptr<ActiveProcessInformation> ActiveProcessesSupervisor::getProcessInformationByDtb(uint64_t dtb) const
+    {
+        std::scoped_lock<std::mutex> lock(activeProcessesSnapshotLock);
+        const auto processInformationIterator =
+            processInformationByDtb.find(dtb & PagingDefinitions::stripPageOffsetMask);
+        if (processInformationIterator == processInformationByDtb.cend())
+        {
+            return nullptr;
+        }
+        return processInformationIterator->second;
+    }
+
     void ActiveProcessesSupervisor::addNewProcess(uint64_t taskStruct)
     {
         std::shared_ptr<ActiveProcessInformation> processInformation(extractProcessInformation(taskStruct));
@@ -156,8 +172,17 @@ namespace VmiCore::Linux
                       {"ParentProcessName", parentName},
                       {"ParentProcessId", parentPid},
                       {"ParentProcessDtb", parentDtb}});
+        if (auto previousProcessInformation = processInformationByPid.find(processInformation->pid);
+            previousProcessInformation != processInformationByPid.end())
+        {
+            removeFromDtbIndex(previousProcessInformation->second);
+            processTree.removeProcess(previousProcessInformation->second);
+        }
         processInformationByPid[processInformation->pid] = processInformation;
         pidsByTaskStruct[processInformation->base] = processInformation->pid;
+        addToDtbIndex(processInformation);
+        processTree.addProcess(processInformation);
+        updateActiveProcessesSnapshot();
     }
 
     void ActiveProcessesSupervisor::removeActiveProcess(uint64_t taskStruct)
@@ -200,9 +225,14 @@ namespace VmiCore::Linux
                      {"ParentProcessId", parentPid},
                      {"ParentProcessDtb", parentDtb}});
 
+                removeFromDtbIndex(processInformationIterator->second);
+                processTree.removeProcess(processInformationIterator->second);
                 processInformationByPid.erase(processInformationIterator);
             }
             pidsByTaskStruct.erase(taskStructIterator);
+            // Files and mounts of the exited process may be released from now on
+            pathExtractor->invalidateCache();
+            updateActiveProcessesSnapshot();
         }
         else
         {
@@ -214,12 +244,75 @@ namespace VmiCore::Linux
     std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
     ActiveProcessesSupervisor::getActiveProcesses() const
     {
-        auto runningProcesses = std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>();
+        return std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>(
+            getActiveProcessesSnapshot()->processes);
+    }
+
+    std::shared_ptr<const ActiveProcessesSnapshot> ActiveProcessesSupervisor::getActiveProcessesSnapshot() const
+    {
+        std::scoped_lock<std::mutex> lock(activeProcessesSnapshotLock);
+        return activeProcessesSnapshot;
+    }
+
+    std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+    ActiveProcessesSupervisor::getProcessDescendants(pid_t pid) const
+    {
+        return processTree.getDescendants(pid);
+    }
+
+    std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+    ActiveProcessesSupervisor::getProcessAncestors(pid_t pid) const
+    {
+        return processTree.getAncestors(pid);
+    }
+
+    void ActiveProcessesSupervisor::addToDtbIndex(const std::shared_ptr<ActiveProcessInformation>& processInformation)
+    {
+        std::scoped_lock<std::mutex> lock(activeProcessesSnapshotLock);
+        for (auto dtb : {processInformation->processDtb, processInformation->processUserDtb})
+        {
+            dtb &= PagingDefinitions::stripPageOffsetMask;
+            if (dtb == 0)
+            {
+                continue;
+            }
+            if (auto [dtbIterator, inserted] = processInformationByDtb.try_emplace(dtb, processInformation);
+                !inserted && dtbIterator->second != processInformation)
+            {
+                logger->debug("Dtb is already associated with another process",
+                              {{"Dtb", fmt::format("{:#x}", dtb)},
+                               {"ProcessId", static_cast<uint64_t>(processInformation->pid)},
+                               {"OtherProcessId", static_cast<uint64_t>(dtbIterator->second->pid)}});
+            }
+        }
+    }
+
+    void
+    ActiveProcessesSupervisor::removeFromDtbIndex(const std::shared_ptr<ActiveProcessInformation>& processInformation)
+    {
+        std::scoped_lock<std::mutex> lock(activeProcessesSnapshotLock);
+        for (auto dtb : {processInformation->processDtb, processInformation->processUserDtb})
+        {
+            auto dtbIterator = processInformationByDtb.find(dtb & PagingDefinitions::stripPageOffsetMask);
+            if (dtbIterator != processInformationByDtb.end() && dtbIterator->second == processInformation)
+            {
+                processInformationByDtb.erase(dtbIterator);
+            }
+        }
+    }
+
+    void ActiveProcessesSupervisor::updateActiveProcessesSnapshot()
+    {
+        auto snapshot = std::make_shared<ActiveProcessesSnapshot>();
+        snapshot->generation = ++activeProcessesGeneration;
+        snapshot->processes.reserve(processInformationByPid.size());
         for (const auto& element : processInformationByPid)
         {
-            runningProcesses->push_back(element.second);
+            snapshot->processes.push_back(element.second);
         }
-        return runningProcesses;
+
+        std::scoped_lock<std::mutex> lock(activeProcessesSnapshotLock);
+        activeProcessesSnapshot = std::move(snapshot);
     }
 
     std::unique_ptr<std::string> ActiveProcessesSupervisor::splitProcessFileNameFromPath(const std::string& path) const
@@ -251,4 +344,20 @@ namespace VmiCore::Linux
 
         return {std::stoi(matches[1].str()), std::stoi(matches[2].str()), std::stoi(matches[3].str())};
     }
+
+    std::shared_ptr<IVmAreaWalker> ActiveProcessesSupervisor::createVmAreaWalker() const
+    {
+        // Starting with 6.1 vm_area_structs are stored in the maple tree mm_struct.mm_mt instead of a linked list
+        try
+        {
+            auto mapleTreeVmAreaWalker = std::make_shared<MapleTreeVmAreaWalker>(vmiInterface, logging);
+            logger->info("Using maple tree of vm_area_structs");
+            return mapleTreeVmAreaWalker;
+        }
+        catch (const VmiException&)
+        {
+            logger->info("Using linked list of vm_area_structs");
+            return std::make_shared<LinkedListVmAreaWalker>(vmiInterface);
+        }
+    }
 }
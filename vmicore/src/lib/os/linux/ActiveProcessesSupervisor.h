@@ -5,10 +5,14 @@
 #include "../../io/ILogging.h"
 #include "../../vmi/LibvmiInterface.h"
 #include "../IActiveProcessesSupervisor.h"
+#include "../ProcessTree.h"
 #include "PathExtractor.h"
+#include "VmAreaWalker.h"
 #include <map>
 #include <memory>
+#include <mutex>
 #include <regex>
+#include <unordered_map>
 #include <vmicore/io/ILogger.h>
 
 namespace VmiCore::Linux
@@ -29,6 +33,8 @@ namespace VmiCore::Linux
         [[nodiscard]] std::shared_ptr<ActiveProcessInformation>
         getProcessInformationByBase(uint64_t taskStruct) const override;
 
+        [[nodiscard]] std::shared_ptr<ActiveProcessInformation> getProcessInformationByDtb(uint64_t dtb) const override;
+
         void addNewProcess(uint64_t taskStruct) override;
 
         void removeActiveProcess(uint64_t taskStruct) override;
@@ -36,17 +42,40 @@ namespace VmiCore::Linux
         [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
         getActiveProcesses() const override;
 
+        [[nodiscard]] std::shared_ptr<const ActiveProcessesSnapshot> getActiveProcessesSnapshot() const override;
+
+        [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getProcessDescendants(pid_t pid) const override;
+
+        [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getProcessAncestors(pid_t pid) const override;
+
       private:
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         std::shared_ptr<ILogging> logging;
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<IEventStream> eventStream;
-        PathExtractor pathExtractor;
+        std::shared_ptr<PathExtractor> pathExtractor;
+        std::shared_ptr<IVmAreaWalker> vmAreaWalker;
+        std::shared_ptr<ModuleNameTableGenerations> moduleNameTables = std::make_shared<ModuleNameTableGenerations>();
         std::map<pid_t, std::shared_ptr<ActiveProcessInformation>> processInformationByPid;
         std::map<uint64_t, pid_t> pidsByTaskStruct;
+        std::unordered_map<uint64_t, std::shared_ptr<ActiveProcessInformation>> processInformationByDtb;
+        ProcessTree processTree;
+        std::shared_ptr<const ActiveProcessesSnapshot> activeProcessesSnapshot =
+            std::make_shared<const ActiveProcessesSnapshot>();
+        /// Guards the snapshot as well as the dtb index, both of which are read by other threads than the event thread.
+        mutable std::mutex activeProcessesSnapshotLock;
+        uint64_t activeProcessesGeneration = 0;
         std::regex kernelBannerVersionMatcher{R"(Linux version ([0-9]+)\.([0-9]+)\.([0-9]+))"};
         bool pti = false;
 
+        void updateActiveProcessesSnapshot();
+
+        void addToDtbIndex(const std::shared_ptr<ActiveProcessInformation>& processInformation);
+
+        void removeFromDtbIndex(const std::shared_ptr<ActiveProcessInformation>& processInformation);
+
         [[nodiscard]] std::unique_ptr<ActiveProcessInformation> extractProcessInformation(uint64_t taskStruct);
 
         [[nodiscard]] pid_t extractPid(uint64_t taskStruct) const;
@@ -54,6 +83,8 @@ namespace VmiCore::Linux
         [[nodiscard]] std::unique_ptr<std::string> splitProcessFileNameFromPath(const std::string& path) const;
 
         [[nodiscard]] std::tuple<int, int, int> extractKernelVersion() const;
+
+        [[nodiscard]] std::shared_ptr<IVmAreaWalker> createVmAreaWalker() const;
     };
 }
 
@@ -1,4 +1,6 @@
 #include "MMExtractor.h"
+#include "../../vmi/VmiException.h"
+#include "../CompactMemoryRegionAdapter.h"
 #include "../PageProtection.h"
 #include "Constants.h"
 #include "ProtectionValues.h"
@@ -6,60 +8,222 @@
 
 namespace VmiCore::Linux
 {
+    namespace
+    {
+        std::optional<addr_t> findKernelStructOffset(ILibvmiInterface& vmiInterface,
+                                                     const std::string& structName,
+                                                     const std::string& member)
+        {
+            try
+            {
+                return vmiInterface.getKernelStructOffset(structName, member);
+            }
+            catch (const VmiException&)
+            {
+                return std::nullopt;
+            }
+        }
+    }
+
     MMExtractor::MMExtractor(std::shared_ptr<ILibvmiInterface> vmiInterface,
                              const std::shared_ptr<ILogging>& logging,
+                             std::shared_ptr<PathExtractor> pathExtractor,
+                             std::shared_ptr<IVmAreaWalker> vmAreaWalker,
+                             std::shared_ptr<ModuleNameTableGenerations> moduleNameTables,
                              uint64_t mm)
         : vmiInterface(std::move(vmiInterface)),
           logger(logging->newNamedLogger(FILENAME_STEM)),
-          pathExtractor(this->vmiInterface, logging),
-          mm(mm)
+          pathExtractor(std::move(pathExtractor)),
+          vmAreaWalker(std::move(vmAreaWalker)),
+          moduleNameTables(std::move(moduleNameTables)),
+          mm(mm),
+          mapCountOffset(findKernelStructOffset(*this->vmiInterface, "mm_struct", "map_count")),
+          sequenceNumberOffset(findKernelStructOffset(*this->vmiInterface, "mm_struct", "mm_lock_seq"))
     {
+        if (!sequenceNumberOffset)
+        {
+            sequenceNumberOffset = findKernelStructOffset(*this->vmiInterface, "mm_struct", "vmacache_seqnum");
+        }
     }
 
     std::unique_ptr<std::vector<MemoryRegion>> MMExtractor::extractAllMemoryRegions() const
     {
-        auto regions = std::make_unique<std::vector<MemoryRegion>>();
+        std::lock_guard<std::mutex> lock(vmAreaCacheLock);
+        return toMemoryRegions(*refreshCompactMemoryRegions(), OperatingSystem::LINUX);
+    }
+
+    std::shared_ptr<const std::vector<MemoryRegion>> MMExtractor::getMemoryRegions() const
+    {
+        std::lock_guard<std::mutex> lock(vmAreaCacheLock);
+        auto compactRegions = refreshCompactMemoryRegions();
+        if (!cachedRegions)
+        {
+            cachedRegions = toMemoryRegions(*compactRegions, OperatingSystem::LINUX);
+        }
+        return cachedRegions;
+    }
+
+    std::shared_ptr<const CompactMemoryRegions> MMExtractor::getCompactMemoryRegions() const
+    {
+        std::lock_guard<std::mutex> lock(vmAreaCacheLock);
+        return refreshCompactMemoryRegions();
+    }
+
+    void MMExtractor::visitMemoryRegions(const MemoryRegionFilter& filter, const MemoryRegionVisitor& visitor) const
+    {
+        for (const auto area : vmAreaWalker->extractVmAreas(mm))
+        {
+            // Decide as much as possible before reading any further guest memory
+            VmArea vmArea{};
+            vmArea.flags = readVmAreaMember(area, "vm_flags");
+            if (filter.onlyExecutable && !(vmArea.flags & static_cast<uint8_t>(ProtectionValues::VM_EXEC)))
+            {
+                continue;
+            }
+            vmArea.file = readVmAreaMember(area, "vm_file");
+            if (filter.requiresFileBacking() && vmArea.file == 0)
+            {
+                continue;
+            }
+            vmArea.start = readVmAreaMember(area, "vm_start");
+            vmArea.end = readVmAreaMember(area, "vm_end");
+            {
+                std::lock_guard<std::mutex> lock(vmAreaCacheLock);
+                vmArea.fileName = findCachedFileName(area, vmArea.file).value_or("");
+            }
+            if (vmArea.fileName.empty())
+            {
+                vmArea.fileName = extractFileName(vmArea.file);
+            }
+
+            // Visited regions are not kept, so their names are not interned
+            auto memoryRegion = toMemoryRegion(createCompactMemoryRegion(vmArea, ModuleNameTable::noModuleName),
+                                               vmArea.fileName,
+                                               OperatingSystem::LINUX);
+            if (filter.matches(memoryRegion) && !visitor(memoryRegion))
+            {
+                return;
+            }
+        }
+    }
+
+    uint64_t MMExtractor::readVmAreaMember(uint64_t area, const std::string& member) const
+    {
+        return vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", member),
+                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+    }
+
+    std::optional<std::string> MMExtractor::findCachedFileName(uint64_t area, uint64_t file) const
+    {
+        auto cachedVmArea = vmAreaCache.find(area);
+        if (cachedVmArea != vmAreaCache.end() && cachedVmArea->second.file == file)
+        {
+            return cachedVmArea->second.fileName;
+        }
+        return std::nullopt;
+    }
 
-        for (auto area = vmiInterface->read64VA(mm, vmiInterface->convertPidToDtb(SYSTEM_PID)); area != 0;
-             area = vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_next"),
-                                           vmiInterface->convertPidToDtb(SYSTEM_PID)))
+    std::string MMExtractor::extractFileName(uint64_t file) const
+    {
+        if (file == 0)
         {
-            const auto start =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_start"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto end =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_end"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto size = end - start + 1;
-            const auto flags =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_flags"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto file =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_file"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            std::string fileName{};
-            if (file != 0)
+            return {};
+        }
+        return pathExtractor->extractDPath(file + vmiInterface->getKernelStructOffset("file", "f_path"));
+    }
+
+    std::optional<MMExtractor::MmState> MMExtractor::extractMmState() const
+    {
+        if (!mapCountOffset || !sequenceNumberOffset)
+        {
+            return std::nullopt;
+        }
+        auto systemDtb = vmiInterface->convertPidToDtb(SYSTEM_PID);
+        return MmState{.mapCount = vmiInterface->read32VA(mm + *mapCountOffset, systemDtb),
+                       .sequenceNumber = vmiInterface->read32VA(mm + *sequenceNumberOffset, systemDtb)};
+    }
+
+    bool MMExtractor::refreshVmAreaCache() const
+    {
+        auto mmState = extractMmState();
+        if (mmState && mmState == cachedMmState)
+        {
+            return false;
+        }
+
+        std::unordered_map<uint64_t, VmArea> updatedVmAreaCache;
+        std::vector<uint64_t> updatedVmAreaOrder;
+        auto changed = false;
+
+        for (const auto area : vmAreaWalker->extractVmAreas(mm))
+        {
+            VmArea vmArea{.start = readVmAreaMember(area, "vm_start"),
+                          .end = readVmAreaMember(area, "vm_end"),
+                          .flags = readVmAreaMember(area, "vm_flags"),
+                          .file = readVmAreaMember(area, "vm_file"),
+                          .fileName = {}};
+            auto cachedFileName = findCachedFileName(area, vmArea.file);
+            vmArea.fileName = cachedFileName ? std::move(*cachedFileName) : extractFileName(vmArea.file);
+
+            auto previousVmArea = vmAreaCache.find(area);
+            if (previousVmArea == vmAreaCache.end() || previousVmArea->second != vmArea)
             {
-                fileName = pathExtractor.extractDPath(file + vmiInterface->getKernelStructOffset("file", "f_path"));
+                changed = true;
             }
+            updatedVmAreaOrder.push_back(area);
+            updatedVmAreaCache.insert_or_assign(area, std::move(vmArea));
+        }
+
+        changed = changed || updatedVmAreaOrder != cachedVmAreaOrder;
+        vmAreaCache = std::move(updatedVmAreaCache);
+        cachedVmAreaOrder = std::move(updatedVmAreaOrder);
+        cachedMmState = mmState;
+        return changed;
+    }
+
+    std::shared_ptr<const CompactMemoryRegions> MMExtractor::refreshCompactMemoryRegions() const
+    {
+        if (refreshVmAreaCache())
+        {
+            cachedRegions.reset();
+            cachedCompactRegions.reset();
+        }
+        if (cachedCompactRegions)
+        {
+            return cachedCompactRegions;
+        }
 
-            auto permissions = std::make_unique<PageProtection>(flags, OperatingSystem::LINUX);
-
-            logger->debug("Memory Region",
-                          {{"start", fmt::format("{:#x}", start)},
-                           {"end", fmt::format("{:#x}", end)},
-                           {"size", size},
-                           {"permissions", permissions->toString()},
-                           {"filename", fileName}});
-            regions->emplace_back(start,
-                                  size,
-                                  fileName,
-                                  std::move(permissions),
-                                  !!(flags & static_cast<uint8_t>(ProtectionValues::VM_SHARED)),
-                                  false,
-                                  false);
+        std::vector<CompactMemoryRegion> regions;
+        regions.reserve(cachedVmAreaOrder.size());
+        auto moduleNames = moduleNameTables->getCurrent();
+        for (const auto area : cachedVmAreaOrder)
+        {
+            const auto& vmArea = vmAreaCache.at(area);
+            regions.push_back(createCompactMemoryRegion(vmArea, moduleNames->intern(vmArea.fileName)));
         }
+        cachedCompactRegions = std::make_shared<const CompactMemoryRegions>(std::move(regions), std::move(moduleNames));
+
+        return cachedCompactRegions;
+    }
+
+    CompactMemoryRegion MMExtractor::createCompactMemoryRegion(const VmArea& vmArea, ModuleNameId moduleName) const
+    {
+        const auto size = vmArea.end - vmArea.start + 1;
+        auto compactRegion = toCompactMemoryRegion(vmArea.start,
+                                                   size,
+                                                   moduleName,
+                                                   vmArea.flags,
+                                                   OperatingSystem::LINUX,
+                                                   !!(vmArea.flags & static_cast<uint8_t>(ProtectionValues::VM_SHARED)),
+                                                   false,
+                                                   false);
 
-        return regions;
+        logger->debug("Memory Region",
+                      {{"start", fmt::format("{:#x}", vmArea.start)},
+                       {"end", fmt::format("{:#x}", vmArea.end)},
+                       {"size", size},
+                       {"permissions", PageProtection(compactRegion.rawProtection, OperatingSystem::LINUX).toString()},
+                       {"filename", vmArea.fileName}});
+        return compactRegion;
     }
 }
@@ -4,6 +4,12 @@
 #include "../../io/ILogging.h"
 #include "../../vmi/LibvmiInterface.h"
 #include "PathExtractor.h"
+#include "VmAreaWalker.h"
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <vmicore/io/ILogger.h>
 #include <vmicore/os/IMemoryRegionExtractor.h>
 
@@ -14,15 +20,79 @@ namespace VmiCore::Linux
       public:
         MMExtractor(std::shared_ptr<ILibvmiInterface> vmiInterface,
                     const std::shared_ptr<ILogging>& logging,
+                    std::shared_ptr<PathExtractor> pathExtractor,
+                    std::shared_ptr<IVmAreaWalker> vmAreaWalker,
+                    std::shared_ptr<ModuleNameTableGenerations> moduleNameTables,
                     uint64_t mm);
 
         [[nodiscard]] std::unique_ptr<std::vector<MemoryRegion>> extractAllMemoryRegions() const override;
 
+        [[nodiscard]] std::shared_ptr<const std::vector<MemoryRegion>> getMemoryRegions() const override;
+
+        [[nodiscard]] std::shared_ptr<const CompactMemoryRegions> getCompactMemoryRegions() const override;
+
+        void visitMemoryRegions(const MemoryRegionFilter& filter, const MemoryRegionVisitor& visitor) const override;
+
       private:
+        struct VmArea
+        {
+            uint64_t start;
+            uint64_t end;
+            uint64_t flags;
+            uint64_t file;
+            std::string fileName;
+
+            bool operator==(const VmArea& rhs) const = default;
+        };
+
+        /// Members of the mm_struct that change whenever its vm_area_structs are modified.
+        struct MmState
+        {
+            uint32_t mapCount;
+            uint32_t sequenceNumber;
+
+            bool operator==(const MmState& rhs) const = default;
+        };
+
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         std::unique_ptr<ILogger> logger;
-        PathExtractor pathExtractor;
+        std::shared_ptr<PathExtractor> pathExtractor;
+        std::shared_ptr<IVmAreaWalker> vmAreaWalker;
+        std::shared_ptr<ModuleNameTableGenerations> moduleNameTables;
         uint64_t mm;
+        std::optional<addr_t> mapCountOffset;
+        std::optional<addr_t> sequenceNumberOffset;
+        mutable std::mutex vmAreaCacheLock;
+        mutable std::optional<MmState> cachedMmState;
+        mutable std::unordered_map<uint64_t, VmArea> vmAreaCache;
+        mutable std::vector<uint64_t> cachedVmAreaOrder;
+        mutable std::shared_ptr<const std::vector<MemoryRegion>> cachedRegions;
+        mutable std::shared_ptr<const CompactMemoryRegions> cachedCompactRegions;
+
+        /// Skips the walk entirely if map_count and the sequence number of the mm_struct are unchanged. Otherwise
+        /// reads every vm_area_struct again, but only resolves file paths of areas that are new or map a different
+        /// file. Returns whether any area differs from the previous walk.
+        [[nodiscard]] bool refreshVmAreaCache() const;
+
+        /// Uses mm_lock_seq (6.4 and newer) or vmacache_seqnum (prior to 6.1). Returns nullopt on kernels providing
+        /// neither, which forces a full walk on every refresh. Changes to vm_flags that leave both members untouched
+        /// are only picked up along with the next change that does not.
+        [[nodiscard]] std::optional<MmState> extractMmState() const;
+
+        /// Refreshes the vm area cache and returns the memoized compact regions. Drops all memoized region lists
+        /// whenever the refresh reports changes, regardless of which of them triggered it. Requires vmAreaCacheLock.
+        [[nodiscard]] std::shared_ptr<const CompactMemoryRegions> refreshCompactMemoryRegions() const;
+
+        [[nodiscard]] CompactMemoryRegion createCompactMemoryRegion(const VmArea& vmArea,
+                                                                    ModuleNameId moduleName) const;
+
+        [[nodiscard]] uint64_t readVmAreaMember(uint64_t area, const std::string& member) const;
+
+        /// Returns the file name resolved during the previous walk if the area still maps the same file. Requires
+        /// vmAreaCacheLock.
+        [[nodiscard]] std::optional<std::string> findCachedFileName(uint64_t area, uint64_t file) const;
+
+        [[nodiscard]] std::string extractFileName(uint64_t file) const;
     };
 }
 
@@ -2,6 +2,12 @@
 #include "Constants.h"
 #include <vmicore/filename.h>
 
+namespace
+{
+    // Dentries are freed without any event that we could observe, so stale entries are bounded by age as well
+    constexpr auto maxPathCacheEntryAge = std::chrono::seconds(60);
+}
+
 namespace VmiCore::Linux
 {
     PathExtractor::PathExtractor(std::shared_ptr<ILibvmiInterface> vmiInterface,
@@ -27,11 +33,46 @@ namespace VmiCore::Linux
             return {};
         }
 
-        return createPath(dentry, mnt - vmiInterface->getKernelStructOffset("mount", "mnt"));
+        bool isComplete = true;
+        return createPath(dentry, mnt - vmiInterface->getKernelStructOffset("mount", "mnt"), isComplete);
+    }
+
+    void PathExtractor::invalidateCache()
+    {
+        std::lock_guard<std::mutex> lock(pathCacheLock);
+        pathCache.clear();
+    }
+
+    std::optional<std::string> PathExtractor::lookupCachedPath(const PathKey& key) const
+    {
+        std::lock_guard<std::mutex> lock(pathCacheLock);
+        auto cachedPath = pathCache.find(key);
+        if (cachedPath == pathCache.end())
+        {
+            return std::nullopt;
+        }
+        if (std::chrono::steady_clock::now() - cachedPath->second.resolvedAt > maxPathCacheEntryAge)
+        {
+            pathCache.erase(cachedPath);
+            return std::nullopt;
+        }
+        return cachedPath->second.path;
+    }
+
+    void PathExtractor::cachePath(const PathKey& key, const std::string& path) const
+    {
+        std::lock_guard<std::mutex> lock(pathCacheLock);
+        pathCache.insert_or_assign(key, CachedPath{path, std::chrono::steady_clock::now()});
     }
 
-    std::string PathExtractor::createPath(uint64_t dentry, uint64_t mnt) const
+    std::string PathExtractor::createPath(uint64_t dentry, uint64_t mnt, bool& isComplete) const
     {
+        const PathKey key{dentry, mnt};
+        if (auto cachedPath = lookupCachedPath(key))
+        {
+            return *cachedPath;
+        }
+
         std::string path;
         try
         {
@@ -54,25 +95,31 @@ namespace VmiCore::Linux
 
             if (parent != dentry && dentry != mntRoot)
             {
-                path.append(createPath(parent, mnt));
+                path.append(createPath(parent, mnt, isComplete));
             }
             else if (mntParent != mnt)
             {
-                path.append(createPath(mntMountpoint, mntParent));
+                path.append(createPath(mntMountpoint, mntParent, isComplete));
             }
 
-            if ((parent == dentry && name->at(0) == '/') || dentry == mntRoot)
+            if (parent == dentry && name->at(0) != '/' && dentry != mntRoot)
             {
-                return path;
+                path.append(*name);
             }
-            if (parent == dentry)
+            else if (parent != dentry && dentry != mntRoot)
+            {
+                path.append(fmt::format("/{}", *name));
+            }
+
+            if (isComplete)
             {
-                return path.append(*name);
+                cachePath(key, path);
             }
-            return path.append(fmt::format("/{}", *name));
+            return path;
         }
         catch (const std::exception& e)
         {
+            isComplete = false;
             logger->warning("Unable to extract part of a path.", {{"exception", e.what()}});
         }
 
@@ -3,9 +3,13 @@
 
 #include "../../io/ILogging.h"
 #include "../../vmi/LibvmiInterface.h"
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vmicore/io/ILogger.h>
 
 namespace VmiCore::Linux
@@ -18,11 +22,44 @@ namespace VmiCore::Linux
 
         [[nodiscard]] std::string extractDPath(uint64_t path) const;
 
+        /// Drops all resolved paths. Has to be called whenever dentries or mounts might have been freed.
+        void invalidateCache();
+
       private:
+        struct PathKey
+        {
+            uint64_t dentry;
+            uint64_t mnt;
+
+            bool operator==(const PathKey& rhs) const = default;
+        };
+
+        struct PathKeyHash
+        {
+            std::size_t operator()(const PathKey& key) const
+            {
+                return std::hash<uint64_t>{}(key.dentry) ^ (std::hash<uint64_t>{}(key.mnt) << 1);
+            }
+        };
+
+        struct CachedPath
+        {
+            std::string path;
+            std::chrono::steady_clock::time_point resolvedAt;
+        };
+
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         std::unique_ptr<ILogger> logger;
+        mutable std::mutex pathCacheLock;
+        mutable std::unordered_map<PathKey, CachedPath, PathKeyHash> pathCache;
+
+        /// Resolves the path of a dentry relative to the given mount. Every resolved prefix is cached. Results are only
+        /// cached if no component of the path failed to resolve, which is tracked via isComplete.
+        [[nodiscard]] std::string createPath(uint64_t dentry, uint64_t mnt, bool& isComplete) const;
+
+        [[nodiscard]] std::optional<std::string> lookupCachedPath(const PathKey& key) const;
 
-        [[nodiscard]] std::string createPath(uint64_t dentry, uint64_t mnt) const;
+        void cachePath(const PathKey& key, const std::string& path) const;
     };
 }
 #endif // VMICORE_LINUX_PATHEXTRACTION_H
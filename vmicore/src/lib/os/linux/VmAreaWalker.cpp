@@ -0,0 +1,183 @@
+#include "VmAreaWalker.h"
+#include "../../vmi/VmiException.h"
+#include "Constants.h"
+#include <algorithm>
+#include <cstring>
+#include <fmt/core.h>
+#include <limits>
+#include <unordered_set>
+#include <vmicore/filename.h>
+
+namespace
+{
+    // Layout of struct maple_node, see include/linux/maple_tree.h
+    constexpr std::size_t mapleNodeSize = 256;
+    constexpr uint64_t mapleNodeMask = mapleNodeSize - 1;
+    constexpr uint64_t mapleNodeTypeShift = 3;
+    constexpr uint64_t mapleNodeTypeMask = 0xF;
+    constexpr uint64_t mapleInternalEntryMask = 0x3;
+    constexpr uint64_t mapleInternalEntry = 0x2;
+    constexpr uint64_t mapleMinNodeAddress = 4096;
+    constexpr std::size_t maplePivotsOffset = 0x8;
+    constexpr std::size_t mapleRange64Slots = 16;
+    constexpr std::size_t mapleRange64SlotsOffset = 0x80;
+    constexpr std::size_t mapleRange64MetadataOffset = 0xF8;
+    constexpr std::size_t mapleArange64Slots = 10;
+    constexpr std::size_t mapleArange64SlotsOffset = 0x50;
+    constexpr std::size_t mapleArange64MetadataOffset = 0xF0;
+
+    enum class MapleType : uint64_t
+    {
+        Dense = 0,
+        Leaf64 = 1,
+        Range64 = 2,
+        Arange64 = 3
+    };
+
+    struct MapleNodeLayout
+    {
+        std::size_t slots;
+        std::size_t slotsOffset;
+        std::size_t metadataOffset;
+    };
+
+    bool isInternalEntry(uint64_t entry)
+    {
+        return (entry & mapleInternalEntryMask) == mapleInternalEntry;
+    }
+
+    bool isMapleNode(uint64_t entry)
+    {
+        return isInternalEntry(entry) && entry > mapleMinNodeAddress;
+    }
+
+    uint64_t readFromNode(const std::vector<uint8_t>& node, std::size_t offset)
+    {
+        uint64_t value = 0;
+        std::memcpy(&value, node.data() + offset, sizeof(value));
+        return value;
+    }
+}
+
+namespace VmiCore::Linux
+{
+    LinkedListVmAreaWalker::LinkedListVmAreaWalker(std::shared_ptr<ILibvmiInterface> vmiInterface)
+        : vmiInterface(std::move(vmiInterface)),
+          vmNextOffset(this->vmiInterface->getKernelStructOffset("vm_area_struct", "vm_next"))
+    {
+    }
+
+    std::vector<uint64_t> LinkedListVmAreaWalker::extractVmAreas(uint64_t mm) const
+    {
+        std::vector<uint64_t> vmAreas;
+        const auto systemDtb = vmiInterface->convertPidToDtb(SYSTEM_PID);
+        for (auto area = vmiInterface->read64VA(mm, systemDtb); area != 0;
+             area = vmiInterface->read64VA(area + vmNextOffset, systemDtb))
+        {
+            vmAreas.push_back(area);
+        }
+        return vmAreas;
+    }
+
+    MapleTreeVmAreaWalker::MapleTreeVmAreaWalker(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                                                 const std::shared_ptr<ILogging>& logging)
+        : vmiInterface(std::move(vmiInterface)),
+          logger(logging->newNamedLogger(FILENAME_STEM)),
+          mapleTreeRootOffset(this->vmiInterface->getKernelStructOffset("mm_struct", "mm_mt") +
+                              this->vmiInterface->getKernelStructOffset("maple_tree", "ma_root"))
+    {
+    }
+
+    std::vector<uint64_t> MapleTreeVmAreaWalker::extractVmAreas(uint64_t mm) const
+    {
+        std::vector<uint64_t> vmAreas;
+        const auto systemDtb = vmiInterface->convertPidToDtb(SYSTEM_PID);
+        const auto root = vmiInterface->read64VA(mm + mapleTreeRootOffset, systemDtb);
+        if (!isMapleNode(root))
+        {
+            // A tree with a single entry stores it directly in the root
+            if (root != 0 && !isInternalEntry(root))
+            {
+                vmAreas.push_back(root);
+            }
+            return vmAreas;
+        }
+
+        // Pairs of encoded node pointer and maximum index covered by the node
+        std::vector<std::pair<uint64_t, uint64_t>> nextNodes{{root, std::numeric_limits<uint64_t>::max()}};
+        std::unordered_set<uint64_t> visitedNodes;
+        std::vector<uint8_t> node(mapleNodeSize);
+        while (!nextNodes.empty())
+        {
+            const auto [encodedNode, max] = nextNodes.back();
+            nextNodes.pop_back();
+
+            const auto nodeAddress = encodedNode & ~mapleNodeMask;
+            if (!visitedNodes.insert(nodeAddress).second)
+            {
+                logger->warning("Cycle detected! Maple node already visited",
+                                {{"MapleNode", fmt::format("{:#x}", nodeAddress)}});
+                continue;
+            }
+
+            MapleNodeLayout layout{};
+            const auto type = static_cast<MapleType>((encodedNode >> mapleNodeTypeShift) & mapleNodeTypeMask);
+            switch (type)
+            {
+                case MapleType::Leaf64:
+                case MapleType::Range64:
+                    layout = {mapleRange64Slots, mapleRange64SlotsOffset, mapleRange64MetadataOffset};
+                    break;
+                case MapleType::Arange64:
+                    layout = {mapleArange64Slots, mapleArange64SlotsOffset, mapleArange64MetadataOffset};
+                    break;
+                default:
+                    logger->warning("Unsupported maple node type",
+                                    {{"MapleNode", fmt::format("{:#x}", nodeAddress)},
+                                     {"Type", static_cast<uint64_t>(type)}});
+                    continue;
+            }
+
+            if (!vmiInterface->readXVA(nodeAddress, systemDtb, node, mapleNodeSize))
+            {
+                throw VmiException(fmt::format("{}: Unable to read maple node @ {:#x}", __func__, nodeAddress));
+            }
+
+            // Equivalent to ma_data_end(): Nodes that are not completely filled store their last slot in metadata
+            const auto pivots = layout.slots - 1;
+            const auto lastPivot = readFromNode(node, maplePivotsOffset + (pivots - 1) * sizeof(uint64_t));
+            std::size_t end = pivots;
+            if (type == MapleType::Arange64 || lastPivot == 0)
+            {
+                end = std::min(static_cast<std::size_t>(node[layout.metadataOffset]), pivots);
+            }
+            else if (lastPivot == max)
+            {
+                end = pivots - 1;
+            }
+
+            std::vector<std::pair<uint64_t, uint64_t>> children;
+            for (std::size_t i = 0; i <= end; i++)
+            {
+                const auto entry = readFromNode(node, layout.slotsOffset + i * sizeof(uint64_t));
+                if (type == MapleType::Leaf64)
+                {
+                    if (entry != 0 && !isInternalEntry(entry))
+                    {
+                        vmAreas.push_back(entry);
+                    }
+                }
+                else if (isMapleNode(entry))
+                {
+                    const auto childMax =
+                        i == end ? max : readFromNode(node, maplePivotsOffset + i * sizeof(uint64_t));
+                    children.emplace_back(entry, childMax);
+                }
+            }
+            // Reverse order keeps the resulting areas sorted by address
+            nextNodes.insert(nextNodes.end(), children.rbegin(), children.rend());
+        }
+
+        return vmAreas;
+    }
+}
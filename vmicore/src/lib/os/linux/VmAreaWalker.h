@@ -0,0 +1,54 @@
+#ifndef VMICORE_LINUX_VMAREAWALKER_H
+#define VMICORE_LINUX_VMAREAWALKER_H
+
+#include "../../io/ILogging.h"
+#include "../../vmi/LibvmiInterface.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <vmicore/io/ILogger.h>
+
+namespace VmiCore::Linux
+{
+    /// Enumerates the vm_area_structs of an mm_struct. The layout of this collection depends on the kernel version.
+    class IVmAreaWalker
+    {
+      public:
+        virtual ~IVmAreaWalker() = default;
+
+        /// Returns the addresses of all vm_area_structs of the given mm_struct in ascending order of their start.
+        [[nodiscard]] virtual std::vector<uint64_t> extractVmAreas(uint64_t mm) const = 0;
+
+      protected:
+        IVmAreaWalker() = default;
+    };
+
+    /// Follows vm_area_struct.vm_next, starting at mm_struct.mmap. Used for kernels prior to 6.1.
+    class LinkedListVmAreaWalker : public IVmAreaWalker
+    {
+      public:
+        explicit LinkedListVmAreaWalker(std::shared_ptr<ILibvmiInterface> vmiInterface);
+
+        [[nodiscard]] std::vector<uint64_t> extractVmAreas(uint64_t mm) const override;
+
+      private:
+        std::shared_ptr<ILibvmiInterface> vmiInterface;
+        uint64_t vmNextOffset;
+    };
+
+    /// Walks the maple tree mm_struct.mm_mt. Used for kernels 6.1 and newer. Each node is fetched with a single read.
+    class MapleTreeVmAreaWalker : public IVmAreaWalker
+    {
+      public:
+        MapleTreeVmAreaWalker(std::shared_ptr<ILibvmiInterface> vmiInterface, const std::shared_ptr<ILogging>& logging);
+
+        [[nodiscard]] std::vector<uint64_t> extractVmAreas(uint64_t mm) const override;
+
+      private:
+        std::shared_ptr<ILibvmiInterface> vmiInterface;
+        std::unique_ptr<ILogger> logger;
+        uint64_t mapleTreeRootOffset;
+    };
+}
+
+#endif // VMICORE_LINUX_VMAREAWALKER_H
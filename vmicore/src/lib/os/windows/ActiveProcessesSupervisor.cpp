@@ -73,8 +73,12 @@ namespace VmiCore::Windows
                              {"ProcessId", static_cast<uint64_t>(processInformation->pid)},
                              {"Exception", e.what()}});
         }
-        processInformation->memoryRegionExtractor = std::make_unique<VadTreeWin10>(
-            kernelAccess, eprocessBase, processInformation->pid, processInformation->name, logging);
+        processInformation->memoryRegionExtractor = std::make_unique<VadTreeWin10>(kernelAccess,
+                                                                                   eprocessBase,
+                                                                                   processInformation->pid,
+                                                                                   processInformation->name,
+                                                                                   moduleNameTables,
+                                                                                   logging);
 
         return processInformation;
     }
@@ -110,6 +114,18 @@ namespace VmiCore::Windows
         return getProcessInformationByPid(pidIterator->second);
     }
 
+    std::shared_ptr<ActiveProcessInformation> ActiveProcessesSupervisor::getProcessInformationByDtb(uint64_t dtb) const
+    {
+        std::scoped_lock<std::mutex> lock(activeProcessesSnapshotLock);
+        const auto processInformationIterator =
+            processInformationByDtb.find(dtb & PagingDefinitions::stripPageOffsetMask);
+        if (processInformationIterator == processInformationByDtb.cend())
+        {
+            return nullptr;
+        }
+        return processInformationIterator->second;
+    }
+
     void ActiveProcessesSupervisor::addNewProcess(uint64_t eprocessBase)
     {
         std::shared_ptr<ActiveProcessInformation> processInformation(extractProcessInformation(eprocessBase));
@@ -135,8 +151,26 @@ namespace VmiCore::Windows
                       {"ParentProcessName", parentName},
                       {"ParentProcessId", parentPid},
                       {"ParentProcessDtb", parentDtb}});
+        if (auto previousProcessInformation = processInformationByPid.find(processInformation->pid);
+            previousProcessInformation != processInformationByPid.end())
+        {
+            removeFromDtbIndex(previousProcessInformation->second);
+            processTree.removeProcess(previousProcessInformation->second);
+        }
         processInformationByPid[processInformation->pid] = processInformation;
         pidsByEprocessBase[processInformation->base] = processInformation->pid;
+        addToDtbIndex(processInformation);
+        // Liveness is only determined once upon discovery. Afterwards, termination is tracked via removeActiveProcess.
+        if (isProcessActive(eprocessBase))
+        {
+            exitedEprocessBases.erase(eprocessBase);
+            processTree.addProcess(processInformation);
+        }
+        else
+        {
+            exitedEprocessBases.insert(eprocessBase);
+        }
+        updateActiveProcessesSnapshot();
     }
 
     bool ActiveProcessesSupervisor::isProcessActive(uint64_t eprocessBase) const
@@ -193,9 +227,13 @@ namespace VmiCore::Windows
                      {"ParentProcessId", parentPid},
                      {"ParentProcessCr3", parentDtb}});
 
+                removeFromDtbIndex(processInformationIterator->second);
+                processTree.removeProcess(processInformationIterator->second);
                 processInformationByPid.erase(processInformationIterator);
             }
             pidsByEprocessBase.erase(eprocessBaseIterator);
+            exitedEprocessBases.erase(eprocessBase);
+            updateActiveProcessesSnapshot();
         }
         else
         {
@@ -207,15 +245,78 @@ namespace VmiCore::Windows
     std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
     ActiveProcessesSupervisor::getActiveProcesses() const
     {
-        auto runningProcesses = std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>();
+        return std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>(
+            getActiveProcessesSnapshot()->processes);
+    }
+
+    std::shared_ptr<const ActiveProcessesSnapshot> ActiveProcessesSupervisor::getActiveProcessesSnapshot() const
+    {
+        std::scoped_lock<std::mutex> lock(activeProcessesSnapshotLock);
+        return activeProcessesSnapshot;
+    }
+
+    std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+    ActiveProcessesSupervisor::getProcessDescendants(pid_t pid) const
+    {
+        return processTree.getDescendants(pid);
+    }
+
+    std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+    ActiveProcessesSupervisor::getProcessAncestors(pid_t pid) const
+    {
+        return processTree.getAncestors(pid);
+    }
+
+    void ActiveProcessesSupervisor::addToDtbIndex(const std::shared_ptr<ActiveProcessInformation>& processInformation)
+    {
+        std::scoped_lock<std::mutex> lock(activeProcessesSnapshotLock);
+        for (auto dtb : {processInformation->processDtb, processInformation->processUserDtb})
+        {
+            dtb &= PagingDefinitions::stripPageOffsetMask;
+            if (dtb == 0)
+            {
+                continue;
+            }
+            if (auto [dtbIterator, inserted] = processInformationByDtb.try_emplace(dtb, processInformation);
+                !inserted && dtbIterator->second != processInformation)
+            {
+                logger->debug("Dtb is already associated with another process",
+                              {{"Dtb", fmt::format("{:#x}", dtb)},
+                               {"ProcessId", static_cast<uint64_t>(processInformation->pid)},
+                               {"OtherProcessId", static_cast<uint64_t>(dtbIterator->second->pid)}});
+            }
+        }
+    }
+
+    void
+    ActiveProcessesSupervisor::removeFromDtbIndex(const std::shared_ptr<ActiveProcessInformation>& processInformation)
+    {
+        std::scoped_lock<std::mutex> lock(activeProcessesSnapshotLock);
+        for (auto dtb : {processInformation->processDtb, processInformation->processUserDtb})
+        {
+            auto dtbIterator = processInformationByDtb.find(dtb & PagingDefinitions::stripPageOffsetMask);
+            if (dtbIterator != processInformationByDtb.end() && dtbIterator->second == processInformation)
+            {
+                processInformationByDtb.erase(dtbIterator);
+            }
+        }
+    }
+
+    void ActiveProcessesSupervisor::updateActiveProcessesSnapshot()
+    {
+        auto snapshot = std::make_shared<ActiveProcessesSnapshot>();
+        snapshot->generation = ++activeProcessesGeneration;
+        snapshot->processes.reserve(processInformationByPid.size());
         for (const auto& element : processInformationByPid)
         {
-            if (isProcessActive(element.second->base))
+            if (!exitedEprocessBases.contains(element.second->base))
             {
-                runningProcesses->push_back(element.second);
+                snapshot->processes.push_back(element.second);
             }
         }
-        return runningProcesses;
+
+        std::scoped_lock<std::mutex> lock(activeProcessesSnapshotLock);
+        activeProcessesSnapshot = std::move(snapshot);
     }
 
     std::unique_ptr<std::string> ActiveProcessesSupervisor::extractProcessPath(uint64_t eprocessBase) const
@@ -5,10 +5,14 @@
 #include "../../io/ILogging.h"
 #include "../../vmi/LibvmiInterface.h"
 #include "../IActiveProcessesSupervisor.h"
+#include "../ProcessTree.h"
 #include "Constants.h"
 #include "VadTreeWin10.h"
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 #include <vmicore/io/ILogger.h>
 
 namespace VmiCore::Windows
@@ -30,6 +34,8 @@ namespace VmiCore::Windows
         [[nodiscard]] std::shared_ptr<ActiveProcessInformation>
         getProcessInformationByBase(uint64_t eprocessBase) const override;
 
+        [[nodiscard]] std::shared_ptr<ActiveProcessInformation> getProcessInformationByDtb(uint64_t dtb) const override;
+
         void addNewProcess(uint64_t eprocessBase) override;
 
         void removeActiveProcess(uint64_t eprocessBase) override;
@@ -37,17 +43,40 @@ namespace VmiCore::Windows
         [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
         getActiveProcesses() const override;
 
+        [[nodiscard]] std::shared_ptr<const ActiveProcessesSnapshot> getActiveProcessesSnapshot() const override;
+
+        [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getProcessDescendants(pid_t pid) const override;
+
+        [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getProcessAncestors(pid_t pid) const override;
+
       private:
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         std::shared_ptr<IKernelAccess> kernelAccess;
+        std::shared_ptr<ModuleNameTableGenerations> moduleNameTables = std::make_shared<ModuleNameTableGenerations>();
         std::map<pid_t, std::shared_ptr<ActiveProcessInformation>> processInformationByPid;
         std::map<uint64_t, pid_t> pidsByEprocessBase;
+        std::unordered_map<uint64_t, std::shared_ptr<ActiveProcessInformation>> processInformationByDtb;
+        ProcessTree processTree;
+        std::set<uint64_t> exitedEprocessBases;
+        std::shared_ptr<const ActiveProcessesSnapshot> activeProcessesSnapshot =
+            std::make_shared<const ActiveProcessesSnapshot>();
+        /// Guards the snapshot as well as the dtb index, both of which are read by other threads than the event thread.
+        mutable std::mutex activeProcessesSnapshotLock;
+        uint64_t activeProcessesGeneration = 0;
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<ILogging> logging;
         std::shared_ptr<IEventStream> eventStream;
 
         [[nodiscard]] bool isProcessActive(uint64_t eprocessBase) const;
 
+        void updateActiveProcessesSnapshot();
+
+        void addToDtbIndex(const std::shared_ptr<ActiveProcessInformation>& processInformation);
+
+        void removeFromDtbIndex(const std::shared_ptr<ActiveProcessInformation>& processInformation);
+
         [[nodiscard]] std::unique_ptr<ActiveProcessInformation> extractProcessInformation(uint64_t eprocessBase) const;
 
         [[nodiscard]] std::unique_ptr<std::string> extractProcessPath(uint64_t eprocessBase) const;
@@ -1,12 +1,18 @@
 #include "KernelAccess.h"
 #include "../../vmi/VmiException.h"
 #include "Constants.h"
+#include <algorithm>
 #include <fmt/core.h>
 #include <vmicore/os/PagingDefinitions.h>
 
 namespace
 {
     constexpr uint64_t exFastRefBits = 0xF;
+    // Layout of a 64 bit _UNICODE_STRING
+    constexpr std::size_t unicodeStringLengthOffset = 0x0;
+    constexpr std::size_t unicodeStringBufferOffset = 0x8;
+    constexpr std::size_t unicodeStringSize = 0x10;
+    constexpr std::size_t maxCachedFileNames = 0x4000;
 }
 
 namespace VmiCore::Windows
@@ -27,6 +33,14 @@ namespace VmiCore::Windows
         return vadRoot;
     }
 
+    VadTreeState KernelAccess::extractVadTreeState(addr_t eprocessBase) const
+    {
+        auto systemDtb = vmiInterface->convertPidToDtb(SYSTEM_PID);
+        return {.root = vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.VadRoot, systemDtb),
+                .hint = vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.VadHint, systemDtb),
+                .count = vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.VadCount, systemDtb)};
+    }
+
     addr_t KernelAccess::extractImageFilePointer(addr_t eprocessBase) const
     {
         auto imageFilePointer = vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.ImageFilePointer,
@@ -37,8 +51,56 @@ namespace VmiCore::Windows
     std::unique_ptr<std::string> KernelAccess::extractFileName(addr_t fileObjectBaseAddress) const
     {
         expectSaneKernelAddress(fileObjectBaseAddress, static_cast<const char*>(__func__));
-        return vmiInterface->extractUnicodeStringAtVA(fileObjectBaseAddress + kernelOffsets.fileObject.FileName,
-                                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return extractFileObjectName(fileObjectBaseAddress);
+    }
+
+    std::unique_ptr<std::string> KernelAccess::extractFileObjectName(addr_t fileObjectBaseAddress) const
+    {
+        auto systemDtb = vmiInterface->convertPidToDtb(SYSTEM_PID);
+        auto fileNameVA = fileObjectBaseAddress + kernelOffsets.fileObject.FileName;
+        // Read the section object pointer and the _UNICODE_STRING header of the file name at once
+        auto headerOffset = std::min(kernelOffsets.fileObject.SectionObjectPointer, kernelOffsets.fileObject.FileName);
+        auto headerSize = std::max(kernelOffsets.fileObject.SectionObjectPointer + sizeof(addr_t),
+                                   kernelOffsets.fileObject.FileName + unicodeStringSize) -
+                          headerOffset;
+        std::vector<uint8_t> header(headerSize);
+        if (!vmiInterface->readXVA(fileObjectBaseAddress + headerOffset, systemDtb, header, headerSize))
+        {
+            // Without the header there is nothing to validate a cached entry against
+            return vmiInterface->extractUnicodeStringAtVA(fileNameVA, systemDtb);
+        }
+        CachedFileName fileObjectIdentity{
+            .sectionObjectPointer = readFromBuffer<addr_t>(
+                header, kernelOffsets.fileObject.SectionObjectPointer - headerOffset, headerSize),
+            .length = readFromBuffer<uint16_t>(
+                header, kernelOffsets.fileObject.FileName - headerOffset + unicodeStringLengthOffset, headerSize),
+            .buffer = readFromBuffer<addr_t>(
+                header, kernelOffsets.fileObject.FileName - headerOffset + unicodeStringBufferOffset, headerSize)};
+
+        {
+            std::lock_guard<std::mutex> lock(fileNameCacheLock);
+            auto cachedFileName = fileNameCacheByFileObject.find(fileObjectBaseAddress);
+            if (cachedFileName != fileNameCacheByFileObject.end())
+            {
+                if (cachedFileName->second.isSameFileObject(fileObjectIdentity))
+                {
+                    return std::make_unique<std::string>(cachedFileName->second.fileName);
+                }
+                fileNameCacheByFileObject.erase(cachedFileName);
+            }
+        }
+
+        auto fileName = vmiInterface->extractUnicodeStringAtVA(fileNameVA, systemDtb);
+        fileObjectIdentity.fileName = *fileName;
+
+        std::lock_guard<std::mutex> lock(fileNameCacheLock);
+        // Only bounds memory usage. Stale entries are detected by their identity, not by being evicted.
+        if (fileNameCacheByFileObject.size() >= maxCachedFileNames)
+        {
+            fileNameCacheByFileObject.clear();
+        }
+        fileNameCacheByFileObject.insert_or_assign(fileObjectBaseAddress, std::move(fileObjectIdentity));
+        return fileName;
     }
 
     addr_t KernelAccess::extractControlAreaBasePointer(addr_t vadEntryBaseVA) const
@@ -109,6 +171,87 @@ namespace VmiCore::Windows
         return vadEntryBaseVA + kernelOffsets.mmVad.mmVadShortBaseAddress;
     }
 
+    MmVad KernelAccess::extractMmVad(addr_t vadEntryBaseVA) const
+    {
+        expectSaneKernelAddress(vadEntryBaseVA, static_cast<const char*>(__func__));
+        auto systemDtb = vmiInterface->convertPidToDtb(SYSTEM_PID);
+        std::vector<uint8_t> buffer(std::max(kernelOffsets.mmVad.size, kernelOffsets.mmVadShort.size));
+        auto validSize = kernelOffsets.mmVad.size;
+        if (!vmiInterface->readXVA(vadEntryBaseVA, systemDtb, buffer, validSize))
+        {
+            // Private allocations are only described by an _MMVAD_SHORT which might be directly followed by an
+            // unmapped page. Retry with the smaller struct in order to not lose these nodes.
+            validSize = kernelOffsets.mmVadShort.size;
+            if (!vmiInterface->readXVA(vadEntryBaseVA, systemDtb, buffer, validSize))
+            {
+                throw VmiException(fmt::format("{}: Unable to read _MMVAD @ {:#x}", __func__, vadEntryBaseVA));
+            }
+        }
+
+        auto vadShortOffset = kernelOffsets.mmVad.mmVadShortBaseAddress;
+        auto flagsOffset = vadShortOffset + kernelOffsets.mmVadShort.Flags;
+        MmVad mmVad{};
+        mmVad.leftChild = readFromBuffer<uint64_t>(buffer, getVadNodeLeftChildOffset(), validSize);
+        mmVad.rightChild = readFromBuffer<uint64_t>(buffer, getVadNodeRightChildOffset(), validSize);
+        // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+        mmVad.startingVpn =
+            (static_cast<uint64_t>(readFromBuffer<uint8_t>(
+                 buffer, vadShortOffset + kernelOffsets.mmVadShort.StartingVpnHigh, validSize))
+             << 32) +
+            readFromBuffer<uint32_t>(buffer, vadShortOffset + kernelOffsets.mmVadShort.StartingVpn, validSize);
+        mmVad.endingVpn =
+            (static_cast<uint64_t>(
+                 readFromBuffer<uint8_t>(buffer, vadShortOffset + kernelOffsets.mmVadShort.EndingVpnHigh, validSize))
+             << 32) +
+            readFromBuffer<uint32_t>(buffer, vadShortOffset + kernelOffsets.mmVadShort.EndingVpn, validSize);
+        // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+        mmVad.protection = static_cast<uint8_t>(extractFlagValueFromBuffer(
+            buffer, flagsOffset, validSize, kernelOffsets.mmvadFlags.size, kernelOffsets.mmvadFlags.protection));
+        mmVad.isPrivateMemory = static_cast<bool>(extractFlagValueFromBuffer(
+            buffer, flagsOffset, validSize, kernelOffsets.mmvadFlags.size, kernelOffsets.mmvadFlags.privateMemory));
+
+        if (!mmVad.isPrivateMemory)
+        {
+            mmVad.subsection = kernelOffsets.mmVad.Subsection + sizeof(uint64_t) <= validSize
+                                   ? readFromBuffer<uint64_t>(buffer, kernelOffsets.mmVad.Subsection, validSize)
+                                   : vmiInterface->read64VA(vadEntryBaseVA + kernelOffsets.mmVad.Subsection, systemDtb);
+        }
+
+        return mmVad;
+    }
+
+    addr_t KernelAccess::extractSubsectionControlArea(addr_t subsectionBaseVA) const
+    {
+        expectSaneKernelAddress(subsectionBaseVA, static_cast<const char*>(__func__));
+        return vmiInterface->read64VA(subsectionBaseVA + kernelOffsets.subSection.ControlArea,
+                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+    }
+
+    ControlArea KernelAccess::extractControlArea(addr_t controlAreaBaseVA) const
+    {
+        expectSaneKernelAddress(controlAreaBaseVA, static_cast<const char*>(__func__));
+        auto flagsOffset = kernelOffsets.controlArea._mmsection_flags;
+        auto filePointerOffset = kernelOffsets.controlArea.FilePointer + kernelOffsets.exFastRef.Object;
+        auto size = std::max(flagsOffset + kernelOffsets.mmsectionFlags.size, filePointerOffset + sizeof(uint64_t));
+        std::vector<uint8_t> buffer(size);
+        if (!vmiInterface->readXVA(controlAreaBaseVA, vmiInterface->convertPidToDtb(SYSTEM_PID), buffer, size))
+        {
+            throw VmiException(fmt::format("{}: Unable to read _CONTROL_AREA @ {:#x}", __func__, controlAreaBaseVA));
+        }
+
+        ControlArea controlArea{};
+        controlArea.isBeingDeleted = static_cast<bool>(extractFlagValueFromBuffer(
+            buffer, flagsOffset, size, kernelOffsets.mmsectionFlags.size, kernelOffsets.mmsectionFlags.beingDeleted));
+        controlArea.isImage = static_cast<bool>(extractFlagValueFromBuffer(
+            buffer, flagsOffset, size, kernelOffsets.mmsectionFlags.size, kernelOffsets.mmsectionFlags.image));
+        controlArea.isFile = static_cast<bool>(extractFlagValueFromBuffer(
+            buffer, flagsOffset, size, kernelOffsets.mmsectionFlags.size, kernelOffsets.mmsectionFlags.file));
+        controlArea.filePointerObjectAddress =
+            removeReferenceCountFromExFastRef(readFromBuffer<uint64_t>(buffer, filePointerOffset, size));
+
+        return controlArea;
+    }
+
     addr_t KernelAccess::getCurrentProcessEprocessBase(addr_t currentListEntry) const
     {
         return currentListEntry - kernelOffsets.eprocess.ActiveProcessLinks;
@@ -174,8 +317,7 @@ namespace VmiCore::Windows
     std::unique_ptr<std::string> KernelAccess::extractProcessPath(addr_t filePointerAddress) const
     {
         expectSaneKernelAddress(filePointerAddress, static_cast<const char*>(__func__));
-        return vmiInterface->extractUnicodeStringAtVA(filePointerAddress + kernelOffsets.fileObject.FileName,
-                                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return extractFileObjectName(filePointerAddress);
     }
 
     addr_t KernelAccess::getMmVadShortFlagsAddr(addr_t vadShortBaseVA) const
@@ -185,7 +327,7 @@ namespace VmiCore::Windows
 
     uint8_t KernelAccess::extractProtectionFlagValue(addr_t vadShortBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmvad_flags::structName);
+        auto flagsSize = kernelOffsets.mmvadFlags.size;
         // As of now, there are 32 Protectionvalues
         assert((kernelOffsets.mmvadFlags.protection.endBit - kernelOffsets.mmvadFlags.protection.startBit) < 6);
         return static_cast<uint8_t>(extractFlagValue(getMmVadShortFlagsAddr(vadShortBaseVA),
@@ -196,7 +338,7 @@ namespace VmiCore::Windows
 
     bool KernelAccess::extractIsPrivateMemory(addr_t vadShortBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmvad_flags::structName);
+        auto flagsSize = kernelOffsets.mmvadFlags.size;
         assert((kernelOffsets.mmvadFlags.privateMemory.endBit - kernelOffsets.mmvadFlags.privateMemory.startBit) == 1);
         return static_cast<bool>(extractFlagValue(getMmVadShortFlagsAddr(vadShortBaseVA),
                                                   flagsSize,
@@ -211,7 +353,7 @@ namespace VmiCore::Windows
 
     bool KernelAccess::extractIsBeingDeleted(addr_t controlAreaBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmsection_flags::structName);
+        auto flagsSize = kernelOffsets.mmsectionFlags.size;
         assert((kernelOffsets.mmsectionFlags.beingDeleted.endBit -
                 kernelOffsets.mmsectionFlags.beingDeleted.startBit) == 1);
         return static_cast<bool>(extractFlagValue(getMmSectionFlagsAddr(controlAreaBaseVA),
@@ -222,7 +364,7 @@ namespace VmiCore::Windows
 
     bool KernelAccess::extractIsImage(addr_t controlAreaBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmsection_flags::structName);
+        auto flagsSize = kernelOffsets.mmsectionFlags.size;
         assert((kernelOffsets.mmsectionFlags.image.endBit - kernelOffsets.mmsectionFlags.image.startBit) == 1);
         return static_cast<bool>(extractFlagValue(getMmSectionFlagsAddr(controlAreaBaseVA),
                                                   flagsSize,
@@ -232,7 +374,7 @@ namespace VmiCore::Windows
 
     bool KernelAccess::extractIsFile(addr_t controlAreaBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmsection_flags::structName);
+        auto flagsSize = kernelOffsets.mmsectionFlags.size;
         assert((kernelOffsets.mmsectionFlags.file.endBit - kernelOffsets.mmsectionFlags.file.startBit) == 1);
         return static_cast<bool>(extractFlagValue(getMmSectionFlagsAddr(controlAreaBaseVA),
                                                   flagsSize,
@@ -272,6 +414,23 @@ namespace VmiCore::Windows
         return getFlagValue(flagValue, startBit, endBit);
     }
 
+    uint64_t KernelAccess::extractFlagValueFromBuffer(const std::vector<uint8_t>& buffer,
+                                                      std::size_t offset,
+                                                      std::size_t validSize,
+                                                      size_t size,
+                                                      const KernelStructOffsets::_flag& flag) const
+    {
+        switch (size)
+        {
+            case sizeof(uint32_t):
+                return getFlagValue(readFromBuffer<uint32_t>(buffer, offset, validSize), flag.startBit, flag.endBit);
+            case sizeof(uint64_t):
+                return getFlagValue(readFromBuffer<uint64_t>(buffer, offset, validSize), flag.startBit, flag.endBit);
+            default:
+                throw VmiException(fmt::format("{}: {} is unknown flag struct size", __func__, size));
+        }
+    }
+
     bool KernelAccess::extractIsWow64Process(uint64_t eprocessBase) const
     {
         auto wow64ProcessAddress = eprocessBase + kernelOffsets.eprocess.WoW64Process;
@@ -2,9 +2,14 @@
 #define VMICORE_WINDOWS_KERNELACCESS_H
 
 #include "../../vmi/LibvmiInterface.h"
+#include "../../vmi/VmiException.h"
 #include "KernelOffsets.h"
+#include "MmVad.h"
 #include "ProtectionValues.h"
+#include <cstring>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 #include <vmicore/types.h>
 
@@ -19,6 +24,8 @@ namespace VmiCore::Windows
 
         [[nodiscard]] virtual addr_t extractVadTreeRootAddress(addr_t vadTreeRootNodeAddressLocation) const = 0;
 
+        [[nodiscard]] virtual VadTreeState extractVadTreeState(addr_t eprocessBase) const = 0;
+
         [[nodiscard]] virtual addr_t extractImageFilePointer(addr_t imageFilePointerAddressLocation) const = 0;
 
         [[nodiscard]] virtual std::unique_ptr<std::string> extractFileName(addr_t fileObjectBaseAddress) const = 0;
@@ -35,6 +42,12 @@ namespace VmiCore::Windows
 
         [[nodiscard]] virtual addr_t getVadShortBaseVA(addr_t vadEntryBaseVA) const = 0;
 
+        [[nodiscard]] virtual MmVad extractMmVad(addr_t vadEntryBaseVA) const = 0;
+
+        [[nodiscard]] virtual addr_t extractSubsectionControlArea(addr_t subsectionBaseVA) const = 0;
+
+        [[nodiscard]] virtual ControlArea extractControlArea(addr_t controlAreaBaseVA) const = 0;
+
         [[nodiscard]] virtual addr_t getCurrentProcessEprocessBase(addr_t currentListEntry) const = 0;
 
         [[nodiscard]] virtual addr_t extractDirectoryTableBase(addr_t eprocessBase) const = 0;
@@ -90,6 +103,8 @@ namespace VmiCore::Windows
 
         [[nodiscard]] addr_t extractVadTreeRootAddress(addr_t eprocessBase) const override;
 
+        [[nodiscard]] VadTreeState extractVadTreeState(addr_t eprocessBase) const override;
+
         [[nodiscard]] addr_t extractImageFilePointer(addr_t eprocessBase) const override;
 
         [[nodiscard]] std::unique_ptr<std::string> extractFileName(addr_t fileObjectBaseAddress) const override;
@@ -107,6 +122,12 @@ namespace VmiCore::Windows
 
         [[nodiscard]] addr_t getVadShortBaseVA(addr_t vadEntryBaseVA) const override;
 
+        [[nodiscard]] MmVad extractMmVad(addr_t vadEntryBaseVA) const override;
+
+        [[nodiscard]] addr_t extractSubsectionControlArea(addr_t subsectionBaseVA) const override;
+
+        [[nodiscard]] ControlArea extractControlArea(addr_t controlAreaBaseVA) const override;
+
         [[nodiscard]] addr_t getCurrentProcessEprocessBase(addr_t currentListEntry) const override;
 
         [[nodiscard]] addr_t extractDirectoryTableBase(addr_t eprocessBase) const override;
@@ -148,9 +169,35 @@ namespace VmiCore::Windows
         [[nodiscard]] std::vector<uint32_t> extractMmProtectToValue() override;
 
       private:
+        /// File name of a _FILE_OBJECT together with the fields identifying the object it has been extracted from.
+        struct CachedFileName
+        {
+            addr_t sectionObjectPointer;
+            uint16_t length;
+            addr_t buffer;
+            std::string fileName;
+
+            [[nodiscard]] bool isSameFileObject(const CachedFileName& other) const
+            {
+                return sectionObjectPointer == other.sectionObjectPointer && length == other.length &&
+                       buffer == other.buffer;
+            }
+        };
+
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         KernelOffsets kernelOffsets;
         std::optional<std::vector<uint32_t>> mmProtectToValue = std::nullopt;
+        mutable std::mutex fileNameCacheLock;
+        mutable std::unordered_map<addr_t, CachedFileName> fileNameCacheByFileObject;
+
+        /**
+         * Extracts the file name of a _FILE_OBJECT. Names are cached system wide because shared images are mapped by
+         * the same _FILE_OBJECT in every process. A cached name is only reused as long as the section object pointer
+         * and the _UNICODE_STRING header of the object are unchanged. The section object pointers belong to the file
+         * control block, so an object that has been freed and reallocated for a different file invalidates the entry
+         * even if its name buffer happens to be reused as well.
+         */
+        [[nodiscard]] std::unique_ptr<std::string> extractFileObjectName(addr_t fileObjectBaseAddress) const;
 
         [[nodiscard]] addr_t getVadNodeLeftChildOffset() const;
 
@@ -169,6 +216,26 @@ namespace VmiCore::Windows
             return flagValueLSB;
         }
 
+        template <typename T>
+        static T readFromBuffer(const std::vector<uint8_t>& buffer, std::size_t offset, std::size_t validSize)
+        {
+            if (offset + sizeof(T) > validSize)
+            {
+                throw VmiException(
+                    fmt::format("{}: Offset {:#x} exceeds buffer of size {:#x}", __func__, offset, validSize));
+            }
+            T value{};
+            std::memcpy(&value, buffer.data() + offset, sizeof(T));
+            return value;
+        }
+
+        [[nodiscard]] uint64_t
+        extractFlagValueFromBuffer(const std::vector<uint8_t>& buffer,
+                                   std::size_t offset,
+                                   std::size_t validSize,
+                                   size_t size,
+                                   const KernelStructOffsets::_flag& flag) const;
+
         static void expectSaneKernelAddress(addr_t address, const char* caller);
     };
 }
@@ -17,22 +17,28 @@ namespace VmiCore::Windows
             .mmvadFlags = {.protection{vmiInterface->getBitfieldOffsetAndSizeFromJson(
                                KernelStructOffsets::mmvad_flags::structName, "Protection")},
                            .privateMemory{vmiInterface->getBitfieldOffsetAndSizeFromJson(
-                               KernelStructOffsets::mmvad_flags::structName, "PrivateMemory")}},
+                               KernelStructOffsets::mmvad_flags::structName, "PrivateMemory")},
+                           .size = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmvad_flags::structName)},
             .mmsectionFlags = {.beingDeleted{vmiInterface->getBitfieldOffsetAndSizeFromJson(
                                    KernelStructOffsets::mmsection_flags::structName, "BeingDeleted")},
                                .image{vmiInterface->getBitfieldOffsetAndSizeFromJson(
                                    KernelStructOffsets::mmsectionFlags::structName, "Image")},
                                .file{vmiInterface->getBitfieldOffsetAndSizeFromJson(
-                                   KernelStructOffsets::mmsectionFlags::structName, "File")}},
+                                   KernelStructOffsets::mmsectionFlags::structName, "File")},
+                               .size = vmiInterface->getStructSizeFromJson(
+                                   KernelStructOffsets::mmsection_flags::structName)},
             .mmVadShort = {.VadNode = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "VadNode"),
                            .StartingVpn = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "StartingVpn"),
                            .StartingVpnHigh = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "StartingVpnHigh"),
                            .EndingVpn = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "EndingVpn"),
                            .EndingVpnHigh = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "EndingVpnHigh"),
-                           .Flags = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "u")},
+                           .Flags = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "u"),
+                           .size = vmiInterface->getStructSizeFromJson("_MMVAD_SHORT")},
             .eprocess = {.ActiveProcessLinks = vmiInterface->getKernelStructOffset("_EPROCESS", "ActiveProcessLinks"),
                          .UniqueProcessId = vmiInterface->getKernelStructOffset("_EPROCESS", "UniqueProcessId"),
                          .VadRoot = vmiInterface->getKernelStructOffset("_EPROCESS", "VadRoot"),
+                         .VadHint = vmiInterface->getKernelStructOffset("_EPROCESS", "VadHint"),
+                         .VadCount = vmiInterface->getKernelStructOffset("_EPROCESS", "VadCount"),
                          .SectionObject = vmiInterface->getKernelStructOffset("_EPROCESS", "SectionObject"),
                          .InheritedFromUniqueProcessId =
                              vmiInterface->getKernelStructOffset("_EPROCESS", "InheritedFromUniqueProcessId"),
@@ -43,10 +49,13 @@ namespace VmiCore::Windows
             .controlArea = {._mmsection_flags = vmiInterface->getKernelStructOffset("_CONTROL_AREA", "u"),
                             .FilePointer = vmiInterface->getKernelStructOffset("_CONTROL_AREA", "FilePointer")},
             .mmVad = {.mmVadShortBaseAddress = vmiInterface->getKernelStructOffset("_MMVAD", "Core"),
-                      .Subsection = vmiInterface->getKernelStructOffset("_MMVAD", "Subsection")},
+                      .Subsection = vmiInterface->getKernelStructOffset("_MMVAD", "Subsection"),
+                      .size = vmiInterface->getStructSizeFromJson("_MMVAD")},
             .rtlBalancedNode = {.Left = vmiInterface->getKernelStructOffset("_RTL_BALANCED_NODE", "Left"),
                                 .Right = vmiInterface->getKernelStructOffset("_RTL_BALANCED_NODE", "Right")},
-            .fileObject = {.FileName = vmiInterface->getKernelStructOffset("_FILE_OBJECT", "FileName")},
+            .fileObject = {.SectionObjectPointer =
+                               vmiInterface->getKernelStructOffset("_FILE_OBJECT", "SectionObjectPointer"),
+                           .FileName = vmiInterface->getKernelStructOffset("_FILE_OBJECT", "FileName")},
             .section = {.controlArea = vmiInterface->getKernelStructOffset("_SECTION", "u1")},
             .kprocess = {.directoryTableBase = vmiInterface->getKernelStructOffset("_KPROCESS", "DirectoryTableBase"),
                          .userDirectoryTableBase =
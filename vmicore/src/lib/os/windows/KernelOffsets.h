@@ -17,6 +17,7 @@ namespace VmiCore::Windows
 
         using _file_object = struct _file_object
         {
+            addr_t SectionObjectPointer;
             addr_t FileName;
         };
 
@@ -36,6 +37,8 @@ namespace VmiCore::Windows
             addr_t ActiveProcessLinks;
             addr_t UniqueProcessId;
             addr_t VadRoot;
+            addr_t VadHint;
+            addr_t VadCount;
             addr_t SectionObject;
             addr_t InheritedFromUniqueProcessId;
             addr_t ExitStatus;
@@ -52,13 +55,15 @@ namespace VmiCore::Windows
             addr_t EndingVpn;
             addr_t EndingVpnHigh;
             addr_t Flags;
+            size_t size;
         } __attribute__((aligned(64)));
 
         using _mmvad = struct _mmvad
         {
             addr_t mmVadShortBaseAddress;
             addr_t Subsection;
-        } __attribute__((aligned(16)));
+            size_t size;
+        } __attribute__((aligned(32)));
 
         using _subsection = struct _subsection
         {
@@ -93,6 +98,7 @@ namespace VmiCore::Windows
             constexpr static const char* structName = "_MMVAD_FLAGS";
             _flag protection;
             _flag privateMemory;
+            size_t size;
         } __attribute__((aligned(128)));
 
         using mmsectionFlags = struct mmsection_flags
@@ -101,6 +107,7 @@ namespace VmiCore::Windows
             _flag beingDeleted;
             _flag image;
             _flag file;
+            size_t size;
         } __attribute__((aligned(128)));
     } // namespace KernelStructOffsets
     // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,45 @@
+#ifndef VMICORE_WINDOWS_MMVAD_H
+#define VMICORE_WINDOWS_MMVAD_H
+
+#include <cstdint>
+#include <vmicore/types.h>
+
+namespace VmiCore::Windows
+{
+    /// Decoded contents of a single _MMVAD node. Obtained by reading the whole node at once.
+    class MmVad
+    {
+      public:
+        addr_t leftChild;
+        addr_t rightChild;
+        uint64_t startingVpn;
+        uint64_t endingVpn;
+        uint8_t protection;
+        bool isPrivateMemory;
+        /// Only valid for non-private memory. Private VADs consist of an _MMVAD_SHORT only.
+        addr_t subsection;
+    };
+
+    /// Decoded contents of the parts of a _CONTROL_AREA that are relevant for VAD parsing.
+    class ControlArea
+    {
+      public:
+        bool isBeingDeleted;
+        bool isImage;
+        bool isFile;
+        addr_t filePointerObjectAddress;
+    };
+
+    /// Members of an _EPROCESS that are updated by the memory manager whenever the vad tree is modified or searched.
+    class VadTreeState
+    {
+      public:
+        addr_t root;
+        addr_t hint;
+        uint64_t count;
+
+        bool operator==(const VadTreeState& rhs) const = default;
+    };
+}
+
+#endif // VMICORE_WINDOWS_MMVAD_H
@@ -1,5 +1,6 @@
 #include "VadTreeWin10.h"
 #include "../../vmi/VmiException.h"
+#include "../CompactMemoryRegionAdapter.h"
 #include "../PageProtection.h"
 #include <fmt/core.h>
 #include <unordered_set>
@@ -12,23 +13,130 @@ namespace VmiCore::Windows
                                uint64_t eprocessBase,
                                pid_t pid,
                                std::string processName,
+                               std::shared_ptr<ModuleNameTableGenerations> moduleNameTables,
                                const std::shared_ptr<ILogging>& logging)
         : kernelAccess(std::move(kernelAccess)),
           eprocessBase(eprocessBase),
           pid(pid),
           processName(std::move(processName)),
+          moduleNameTables(std::move(moduleNameTables)),
           logger(logging->newNamedLogger(FILENAME_STEM)),
           mmProtectToValue(this->kernelAccess->extractMmProtectToValue())
     {
     }
 
+    namespace
+    {
+        bool isSameVad(const MmVad& lhs, const MmVad& rhs)
+        {
+            return lhs.startingVpn == rhs.startingVpn && lhs.endingVpn == rhs.endingVpn &&
+                   lhs.protection == rhs.protection && lhs.isPrivateMemory == rhs.isPrivateMemory &&
+                   lhs.subsection == rhs.subsection;
+        }
+
+        bool isSameControlArea(const std::optional<ControlArea>& lhs, const std::optional<ControlArea>& rhs)
+        {
+            if (lhs.has_value() != rhs.has_value())
+            {
+                return false;
+            }
+            return !lhs.has_value() || (lhs->isBeingDeleted == rhs->isBeingDeleted && lhs->isImage == rhs->isImage &&
+                                        lhs->isFile == rhs->isFile &&
+                                        lhs->filePointerObjectAddress == rhs->filePointerObjectAddress);
+        }
+    }
+
     std::unique_ptr<std::vector<MemoryRegion>> VadTreeWin10::extractAllMemoryRegions() const
     {
-        auto regions = std::make_unique<std::vector<MemoryRegion>>();
-        std::list<uint64_t> nextVadEntries;
+        std::lock_guard<std::mutex> lock(vadCacheLock);
+        return toMemoryRegions(*refreshCompactMemoryRegions(), OperatingSystem::WINDOWS);
+    }
+
+    std::shared_ptr<const std::vector<MemoryRegion>> VadTreeWin10::getMemoryRegions() const
+    {
+        std::lock_guard<std::mutex> lock(vadCacheLock);
+        auto compactRegions = refreshCompactMemoryRegions();
+        if (!cachedRegions)
+        {
+            cachedRegions = toMemoryRegions(*compactRegions, OperatingSystem::WINDOWS);
+        }
+        return cachedRegions;
+    }
+
+    std::shared_ptr<const CompactMemoryRegions> VadTreeWin10::getCompactMemoryRegions() const
+    {
+        std::lock_guard<std::mutex> lock(vadCacheLock);
+        return refreshCompactMemoryRegions();
+    }
+
+    void VadTreeWin10::visitMemoryRegions(const MemoryRegionFilter& filter, const MemoryRegionVisitor& visitor) const
+    {
+        auto imageFilePointer = extractImageFilePointer();
+        walkVadTree(
+            kernelAccess->extractVadTreeRootAddress(eprocessBase),
+            [this, &filter, &visitor, imageFilePointer](addr_t vadEntryBaseVA, const MmVad& mmVad)
+            {
+                // Decide as much as possible before reading any further guest memory
+                if (filter.requiresFileBacking() && mmVad.isPrivateMemory)
+                {
+                    return true;
+                }
+
+                std::optional<MemoryRegion> memoryRegion;
+                try
+                {
+                    if (filter.onlyExecutable &&
+                        !PageProtection(mmProtectToValue.at(mmVad.protection), OperatingSystem::WINDOWS)
+                             .get()
+                             .executable)
+                    {
+                        return true;
+                    }
+
+                    std::optional<ControlArea> controlArea;
+                    if (!mmVad.isPrivateMemory)
+                    {
+                        controlArea = kernelAccess->extractControlArea(
+                            kernelAccess->extractSubsectionControlArea(mmVad.subsection));
+                    }
+                    std::shared_ptr<const Vadt> vadt;
+                    {
+                        std::lock_guard<std::mutex> lock(vadCacheLock);
+                        vadt = findCachedVadt(vadEntryBaseVA, mmVad, controlArea);
+                    }
+                    if (!vadt)
+                    {
+                        vadt = createVadt(vadEntryBaseVA, mmVad, controlArea, imageFilePointer);
+                    }
+                    if (filter.requiresFileBacking() && !vadt->isFileBacked)
+                    {
+                        return true;
+                    }
+                    // Visited regions are not kept, so their names are not interned
+                    memoryRegion.emplace(toMemoryRegion(createCompactMemoryRegion(*vadt, ModuleNameTable::noModuleName),
+                                                        vadt->fileName,
+                                                        OperatingSystem::WINDOWS));
+                }
+                catch (const std::exception& e)
+                {
+                    logger->warning("Unable to create Vadt object for process",
+                                    {{"ProcessName", processName},
+                                     {"ProcessId", static_cast<int64_t>(pid)},
+                                     {"exception", e.what()}});
+                    return true;
+                }
+
+                return !filter.matches(*memoryRegion) || visitor(*memoryRegion);
+            });
+    }
+
+    bool VadTreeWin10::walkVadTree(addr_t vadTreeRoot,
+                                   const std::function<bool(addr_t, const MmVad&)>& nodeVisitor) const
+    {
+        std::vector<uint64_t> nextVadEntries;
         std::unordered_set<uint64_t> visitedVadVAs;
-        auto nodeAddress = kernelAccess->extractVadTreeRootAddress(eprocessBase);
-        nextVadEntries.push_back(nodeAddress);
+        auto complete = true;
+        nextVadEntries.push_back(vadTreeRoot);
         while (!nextVadEntries.empty())
         {
             auto currentVadEntryBaseVA = nextVadEntries.back();
@@ -39,15 +147,14 @@ namespace VmiCore::Windows
             {
                 logger->warning("Cycle detected! Vad entry already visited",
                                 {{"VadEntryBaseVA", fmt::format("{:#x}", currentVadEntryBaseVA)}});
+                complete = false;
                 continue;
             }
 
-            addr_t leftChildAddress = 0;
-            addr_t rightChildAddress = 0;
+            MmVad mmVad{};
             try
             {
-                std::tie(leftChildAddress, rightChildAddress) =
-                    kernelAccess->extractMmVadShortChildNodeAddresses(currentVadEntryBaseVA);
+                mmVad = kernelAccess->extractMmVad(currentVadEntryBaseVA);
             }
             catch (const std::exception& e)
             {
@@ -56,38 +163,117 @@ namespace VmiCore::Windows
                                  {"ProcessId", static_cast<int64_t>(pid)},
                                  {"_MMVAD_SHORT", fmt::format("{:#x}", currentVadEntryBaseVA)},
                                  {"exception", e.what()}});
+                complete = false;
                 continue;
             }
-            if (leftChildAddress != 0)
+            if (mmVad.leftChild != 0)
             {
-                nextVadEntries.push_back(leftChildAddress);
+                nextVadEntries.push_back(mmVad.leftChild);
             }
-            if (rightChildAddress != 0)
+            if (mmVad.rightChild != 0)
             {
-                nextVadEntries.push_back(rightChildAddress);
+                nextVadEntries.push_back(mmVad.rightChild);
             }
 
+            if (!nodeVisitor(currentVadEntryBaseVA, mmVad))
+            {
+                return complete;
+            }
+        }
+        return complete;
+    }
+
+    std::shared_ptr<const Vadt> VadTreeWin10::findCachedVadt(addr_t vadEntryBaseVA,
+                                                             const MmVad& mmVad,
+                                                             const std::optional<ControlArea>& controlArea) const
+    {
+        auto cachedVad = vadCache.find(vadEntryBaseVA);
+        if (cachedVad != vadCache.end() && isSameVad(cachedVad->second.mmVad, mmVad) &&
+            isSameControlArea(cachedVad->second.controlArea, controlArea))
+        {
+            return cachedVad->second.vadt;
+        }
+        return nullptr;
+    }
+
+    bool VadTreeWin10::refreshVadCache() const
+    {
+        auto imageFilePointer = extractImageFilePointer();
+        auto vadTreeState = kernelAccess->extractVadTreeState(eprocessBase);
+        if (vadTreeState == cachedVadTreeState && imageFilePointer == cachedImageFilePointer)
+        {
+            return false;
+        }
+
+        std::unordered_map<addr_t, CachedVad> updatedVadCache;
+        std::vector<std::shared_ptr<const Vadt>> updatedVads;
+        // Cached Vadts have been decoded with the previous image file pointer, which determines the base image flag
+        if (imageFilePointer != cachedImageFilePointer)
+        {
+            vadCache.clear();
+            cachedImageFilePointer = imageFilePointer;
+        }
+        auto decodedAllNodes = true;
+        const auto walkedAllNodes = walkVadTree(
+            vadTreeState.root,
+            [this, &updatedVadCache, &updatedVads, &decodedAllNodes, imageFilePointer](addr_t vadEntryBaseVA,
+                                                                                        const MmVad& mmVad)
+            {
+                auto& cacheEntry = updatedVadCache[vadEntryBaseVA];
+                cacheEntry.mmVad = mmVad;
+                try
+                {
+                    if (!mmVad.isPrivateMemory)
+                    {
+                        cacheEntry.controlArea = kernelAccess->extractControlArea(
+                            kernelAccess->extractSubsectionControlArea(mmVad.subsection));
+                    }
+                    cacheEntry.vadt = findCachedVadt(vadEntryBaseVA, mmVad, cacheEntry.controlArea);
+                    if (!cacheEntry.vadt)
+                    {
+                        cacheEntry.vadt = createVadt(vadEntryBaseVA, mmVad, cacheEntry.controlArea, imageFilePointer);
+                    }
+                    updatedVads.push_back(cacheEntry.vadt);
+                }
+                catch (const std::exception& e)
+                {
+                    logger->warning("Unable to create Vadt object for process",
+                                    {{"ProcessName", processName},
+                                     {"ProcessId", static_cast<int64_t>(pid)},
+                                     {"exception", e.what()}});
+                    decodedAllNodes = false;
+                }
+                return true;
+            });
+
+        const auto changed = updatedVads != cachedVads;
+        vadCache = std::move(updatedVadCache);
+        cachedVads = std::move(updatedVads);
+        // Nodes that failed to decode have to be retried on the next refresh even if the tree stays the same
+        cachedVadTreeState = walkedAllNodes && decodedAllNodes ? std::make_optional(vadTreeState) : std::nullopt;
+        return changed;
+    }
+
+    std::shared_ptr<const CompactMemoryRegions> VadTreeWin10::refreshCompactMemoryRegions() const
+    {
+        if (refreshVadCache())
+        {
+            cachedRegions.reset();
+            cachedCompactRegions.reset();
+        }
+        if (cachedCompactRegions)
+        {
+            return cachedCompactRegions;
+        }
+
+        std::vector<CompactMemoryRegion> regions;
+        regions.reserve(cachedVads.size());
+        auto moduleNames = moduleNameTables->getCurrent();
+        for (const auto& currentVad : cachedVads)
+        {
             try
             {
-                const auto currentVad = createVadt(currentVadEntryBaseVA);
-
-                const auto startAddress = currentVad->startingVPN << PagingDefinitions::numberOfPageIndexBits;
-                const auto endAddress = ((currentVad->endingVPN + 1) << PagingDefinitions::numberOfPageIndexBits) - 1;
-                const auto size = endAddress - startAddress + 1;
-                logger->debug("Vadt element",
-                              {{"startingVPN", fmt::format("{:#x}", currentVad->startingVPN)},
-                               {"endingVPN", fmt::format("{:#x}", currentVad->endingVPN)},
-                               {"startAddress", fmt::format("{:#x}", startAddress)},
-                               {"endAddress", fmt::format("{:#x}", endAddress)},
-                               {"size", static_cast<uint64_t>(size)}});
-                regions->emplace_back(startAddress,
-                                      size,
-                                      currentVad->fileName,
-                                      std::make_unique<PageProtection>(mmProtectToValue.at(currentVad->protection),
-                                                                       OperatingSystem::WINDOWS),
-                                      currentVad->isSharedMemory,
-                                      currentVad->isBeingDeleted,
-                                      currentVad->isProcessBaseImage);
+                regions.push_back(createCompactMemoryRegion(*currentVad, moduleNames->intern(currentVad->fileName)));
             }
             catch (const std::exception& e)
             {
@@ -96,8 +282,30 @@ namespace VmiCore::Windows
                     {{"ProcessName", processName}, {"ProcessId", static_cast<int64_t>(pid)}, {"exception", e.what()}});
             }
         }
+        cachedCompactRegions = std::make_shared<const CompactMemoryRegions>(std::move(regions), std::move(moduleNames));
+
+        return cachedCompactRegions;
+    }
 
-        return regions;
+    CompactMemoryRegion VadTreeWin10::createCompactMemoryRegion(const Vadt& vadt, ModuleNameId moduleName) const
+    {
+        const auto startAddress = vadt.startingVPN << PagingDefinitions::numberOfPageIndexBits;
+        const auto endAddress = ((vadt.endingVPN + 1) << PagingDefinitions::numberOfPageIndexBits) - 1;
+        const auto size = endAddress - startAddress + 1;
+        logger->debug("Vadt element",
+                      {{"startingVPN", fmt::format("{:#x}", vadt.startingVPN)},
+                       {"endingVPN", fmt::format("{:#x}", vadt.endingVPN)},
+                       {"startAddress", fmt::format("{:#x}", startAddress)},
+                       {"endAddress", fmt::format("{:#x}", endAddress)},
+                       {"size", static_cast<uint64_t>(size)}});
+        return toCompactMemoryRegion(startAddress,
+                                     size,
+                                     moduleName,
+                                     mmProtectToValue.at(vadt.protection),
+                                     OperatingSystem::WINDOWS,
+                                     vadt.isSharedMemory,
+                                     vadt.isBeingDeleted,
+                                     vadt.isProcessBaseImage);
     }
 
     bool vadEntryIsFileBacked(bool imageFlag, bool fileFlag)
@@ -105,40 +313,36 @@ namespace VmiCore::Windows
         return imageFlag || fileFlag;
     }
 
-    std::unique_ptr<Vadt> VadTreeWin10::createVadt(uint64_t vadEntryBaseVA) const
+    std::unique_ptr<Vadt> VadTreeWin10::createVadt(uint64_t vadEntryBaseVA,
+                                                   const MmVad& mmVad,
+                                                   const std::optional<ControlArea>& controlArea,
+                                                   addr_t imageFilePointer) const
     {
         auto vadt = std::make_unique<Vadt>();
-        auto vadShortBaseVA = kernelAccess->getVadShortBaseVA(vadEntryBaseVA);
-        std::tie(vadt->startingVPN, vadt->endingVPN) = kernelAccess->extractMmVadShortVpns(vadShortBaseVA);
-        vadt->protection = kernelAccess->extractProtectionFlagValue(vadShortBaseVA);
+        vadt->startingVPN = mmVad.startingVpn;
+        vadt->endingVPN = mmVad.endingVpn;
+        vadt->protection = mmVad.protection;
         vadt->isFileBacked = false;
         vadt->isBeingDeleted = false;
-        vadt->isSharedMemory = !kernelAccess->extractIsPrivateMemory(vadShortBaseVA);
+        vadt->isSharedMemory = !mmVad.isPrivateMemory;
         vadt->isProcessBaseImage = false;
 
         vadt->vadEntryBaseVA = vadEntryBaseVA;
 
-        if (vadt->isSharedMemory)
+        if (controlArea.has_value())
         {
-            auto controlAreaBaseVA = kernelAccess->extractControlAreaBasePointer(vadEntryBaseVA);
-            auto imageFlag = kernelAccess->extractIsImage(controlAreaBaseVA);
-            auto fileFlag = kernelAccess->extractIsFile(controlAreaBaseVA);
-            if (vadEntryIsFileBacked(imageFlag, fileFlag))
+            if (vadEntryIsFileBacked(controlArea->isImage, controlArea->isFile))
             {
                 logger->debug("Is file backed",
                               {
-                                  {"mmSectionFlags.Image", fmt::format("{:#x}", imageFlag)},
-                                  {"mmSectionFlags.File", fmt::format("{:#x}", fileFlag)},
+                                  {"mmSectionFlags.Image", fmt::format("{:#x}", controlArea->isImage)},
+                                  {"mmSectionFlags.File", fmt::format("{:#x}", controlArea->isFile)},
                               });
                 vadt->isFileBacked = true;
                 try
                 {
-                    auto filePointerObjectAddress = kernelAccess->extractFilePointerObjectAddress(controlAreaBaseVA);
-                    vadt->fileName = *extractFileName(filePointerObjectAddress);
-
-                    auto imageFilePointerFromEprocess = kernelAccess->extractImageFilePointer(eprocessBase);
-                    auto imageFilePointerFromVad = filePointerObjectAddress;
-                    vadt->isProcessBaseImage = imageFilePointerFromEprocess == imageFilePointerFromVad;
+                    vadt->fileName = *extractFileName(controlArea->filePointerObjectAddress);
+                    vadt->isProcessBaseImage = imageFilePointer == controlArea->filePointerObjectAddress;
                 }
                 catch (const std::exception& e)
                 {
@@ -152,11 +356,27 @@ namespace VmiCore::Windows
                                     });
                 }
             }
-            vadt->isBeingDeleted = kernelAccess->extractIsBeingDeleted(controlAreaBaseVA);
+            vadt->isBeingDeleted = controlArea->isBeingDeleted;
         }
         return vadt;
     }
 
+    addr_t VadTreeWin10::extractImageFilePointer() const
+    {
+        try
+        {
+            return kernelAccess->extractImageFilePointer(eprocessBase);
+        }
+        catch (const std::exception& e)
+        {
+            logger->warning("Unable to extract image file pointer, no region is marked as process base image",
+                            {{"ProcessName", processName},
+                             {"ProcessId", static_cast<int64_t>(pid)},
+                             {"exception", e.what()}});
+        }
+        return 0;
+    }
+
     std::unique_ptr<std::string> VadTreeWin10::extractFileName(addr_t filePointerObjectAddress) const
     {
         std::unique_ptr<std::string> fileName;
@@ -4,8 +4,11 @@
 #include "../../io/ILogging.h"
 #include "KernelAccess.h"
 #include "Vadt.h"
-#include <list>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 #include <vmicore/io/ILogger.h>
 #include <vmicore/os/IMemoryRegionExtractor.h>
@@ -19,19 +22,69 @@ namespace VmiCore::Windows
                      uint64_t eprocessBase,
                      pid_t pid,
                      std::string processName,
+                     std::shared_ptr<ModuleNameTableGenerations> moduleNameTables,
                      const std::shared_ptr<ILogging>& logging);
 
         [[nodiscard]] std::unique_ptr<std::vector<MemoryRegion>> extractAllMemoryRegions() const override;
 
+        [[nodiscard]] std::shared_ptr<const std::vector<MemoryRegion>> getMemoryRegions() const override;
+
+        [[nodiscard]] std::shared_ptr<const CompactMemoryRegions> getCompactMemoryRegions() const override;
+
+        void visitMemoryRegions(const MemoryRegionFilter& filter, const MemoryRegionVisitor& visitor) const override;
+
       private:
+        struct CachedVad
+        {
+            MmVad mmVad;
+            std::optional<ControlArea> controlArea;
+            std::shared_ptr<const Vadt> vadt;
+        };
+
         std::shared_ptr<IKernelAccess> kernelAccess;
         uint64_t eprocessBase;
         pid_t pid;
         std::string processName;
+        std::shared_ptr<ModuleNameTableGenerations> moduleNameTables;
         std::unique_ptr<ILogger> logger;
         std::vector<uint32_t> mmProtectToValue;
+        mutable std::mutex vadCacheLock;
+        mutable std::unordered_map<addr_t, CachedVad> vadCache;
+        mutable std::vector<std::shared_ptr<const Vadt>> cachedVads;
+        mutable addr_t cachedImageFilePointer = 0;
+        mutable std::optional<VadTreeState> cachedVadTreeState;
+        mutable std::shared_ptr<const std::vector<MemoryRegion>> cachedRegions;
+        mutable std::shared_ptr<const CompactMemoryRegions> cachedCompactRegions;
+
+        /// Reads every node of the vad tree exactly once, even if the tree contains cycles. The walk stops as soon as
+        /// the node visitor returns false. Returns whether every node could be read and no cycle was encountered.
+        bool walkVadTree(addr_t vadTreeRoot, const std::function<bool(addr_t, const MmVad&)>& nodeVisitor) const;
+
+        /// Returns the previously decoded Vadt of a node if none of its relevant fields changed. Requires vadCacheLock.
+        [[nodiscard]] std::shared_ptr<const Vadt> findCachedVadt(addr_t vadEntryBaseVA,
+                                                                 const MmVad& mmVad,
+                                                                 const std::optional<ControlArea>& controlArea) const;
+
+        /// Skips the walk entirely if root, VadHint and VadCount of the process as well as its image file pointer are
+        /// unchanged since the last complete walk. Otherwise reads every node and its control area again, but only
+        /// decodes nodes that are new or have been modified. Protection changes of a whole VAD that touch none of
+        /// these members are only picked up along with the next change that does. Returns whether the resulting list
+        /// of Vadts differs from the previous one.
+        [[nodiscard]] bool refreshVadCache() const;
+
+        /// Refreshes the vad cache and returns the memoized compact regions. Drops all memoized region lists whenever
+        /// the refresh reports changes, regardless of which of them triggered it. Requires vadCacheLock.
+        [[nodiscard]] std::shared_ptr<const CompactMemoryRegions> refreshCompactMemoryRegions() const;
+
+        [[nodiscard]] CompactMemoryRegion createCompactMemoryRegion(const Vadt& vadt, ModuleNameId moduleName) const;
+
+        [[nodiscard]] std::unique_ptr<Vadt> createVadt(uint64_t vadEntryBaseVA,
+                                                       const MmVad& mmVad,
+                                                       const std::optional<ControlArea>& controlArea,
+                                                       addr_t imageFilePointer) const;
 
-        [[nodiscard]] std::unique_ptr<Vadt> createVadt(uint64_t vadEntryBaseVA) const;
+        /// Only the base image flag of the regions depends on it, so a failed read is logged and yields 0.
+        [[nodiscard]] addr_t extractImageFilePointer() const;
 
         [[nodiscard]] std::unique_ptr<std::string> extractFileName(addr_t filePointerObjectAddress) const;
     };
@@ -29,7 +29,8 @@ namespace VmiCore
           fileTransport(std::move(pluginLogging)),
           loggingLib(std::move(loggingLib)),
           logger(this->loggingLib->newNamedLogger(FILENAME_STEM)),
-          eventStream(std::move(eventStream))
+          eventStream(std::move(eventStream)),
+          workerPool(std::make_unique<WorkerPool>(this->configInterface->getWorkerThreadCount()))
     {
         if (isInstanciated)
         {
@@ -102,6 +103,21 @@ namespace VmiCore
         }
     }
 
+    bool PluginSystem::writeToFile(const std::string& filename, std::span<const FileChunk> chunks) const
+    {
+        try
+        {
+            fileTransport->saveBinaryToFile(filename, chunks);
+        }
+        catch (const std::exception& e)
+        {
+            logger->error("Failed to write binary to file", {{"filename", filename}, {"exception", e.what()}});
+            eventStream->sendErrorEvent(e.what());
+            return false;
+        }
+        return true;
+    }
+
     void PluginSystem::sendErrorEvent(std::string_view message) const
     {
         eventStream->sendErrorEvent(message);
@@ -117,6 +133,16 @@ namespace VmiCore
         return vmiInterface;
     }
 
+    std::shared_ptr<ITaskHandle> PluginSystem::submitTask(std::function<void(std::stop_token)> function) const
+    {
+        return workerPool->submit(std::move(function));
+    }
+
+    bool PluginSystem::runPendingTask() const
+    {
+        return workerPool->runPendingTask();
+    }
+
     std::unique_ptr<std::string> PluginSystem::getResultsDir() const
     {
         return std::make_unique<std::string>(configInterface->getResultsDirectory());
@@ -128,6 +154,28 @@ namespace VmiCore
         return activeProcessesSupervisor->getActiveProcesses();
     }
 
+    std::shared_ptr<const ActiveProcessesSnapshot> PluginSystem::getRunningProcessesSnapshot() const
+    {
+        return activeProcessesSupervisor->getActiveProcessesSnapshot();
+    }
+
+    std::shared_ptr<const ActiveProcessInformation> PluginSystem::getProcessInformationByDtb(addr_t dtb) const
+    {
+        return activeProcessesSupervisor->getProcessInformationByDtb(dtb);
+    }
+
+    std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+    PluginSystem::getProcessDescendants(pid_t pid) const
+    {
+        return activeProcessesSupervisor->getProcessDescendants(pid);
+    }
+
+    std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+    PluginSystem::getProcessAncestors(pid_t pid) const
+    {
+        return activeProcessesSupervisor->getProcessAncestors(pid);
+    }
+
     void PluginSystem::initializePlugin(const std::string& pluginName,
                                         std::shared_ptr<Plugin::IPluginConfig> config,
                                         const std::vector<std::string>& args)
@@ -221,6 +269,7 @@ namespace VmiCore
             }
         }
 
+        workerPool->cancelPendingTasks();
         registeredProcessStartCallbacks.clear();
         registeredProcessTerminationCallbacks.clear();
         plugins.clear();
@@ -6,6 +6,7 @@
 #include "../io/ILogging.h"
 #include "../io/file/LegacyLogging.h"
 #include "../os/IActiveProcessesSupervisor.h"
+#include "../threading/WorkerPool.h"
 #include "../vmi/InterruptEventSupervisor.h"
 #include "../vmi/LibvmiInterface.h"
 #include <cstdint>
@@ -74,6 +75,8 @@ namespace VmiCore
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<IEventStream> eventStream;
         std::vector<std::pair<std::string, std::unique_ptr<Plugin::IPlugin>>> plugins;
+        // Declared last so that workers are joined before plugin code is released
+        std::unique_ptr<WorkerPool> workerPool;
 
         [[nodiscard]] std::unique_ptr<std::string> getResultsDir() const override;
 
@@ -83,6 +86,17 @@ namespace VmiCore
         [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
         getRunningProcesses() const override;
 
+        [[nodiscard]] std::shared_ptr<const ActiveProcessesSnapshot> getRunningProcessesSnapshot() const override;
+
+        [[nodiscard]] std::shared_ptr<const ActiveProcessInformation>
+        getProcessInformationByDtb(addr_t dtb) const override;
+
+        [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getProcessDescendants(pid_t pid) const override;
+
+        [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
+        getProcessAncestors(pid_t pid) const override;
+
         void registerProcessStartEvent(
             const std::function<void(std::shared_ptr<const ActiveProcessInformation>)>& startCallback) override;
 
@@ -100,12 +114,19 @@ namespace VmiCore
 
         void writeToFile(const std::string& filename, const std::vector<uint8_t>& data) const override;
 
+        [[nodiscard]] bool writeToFile(const std::string& filename, std::span<const FileChunk> chunks) const override;
+
         void sendErrorEvent(std::string_view message) const override;
 
         void sendInMemDetectionEvent(std::string_view message) const override;
 
         [[nodiscard]] std::shared_ptr<IIntrospectionAPI> getIntrospectionAPI() const override;
 
+        [[nodiscard]] std::shared_ptr<ITaskHandle>
+        submitTask(std::function<void(std::stop_token)> function) const override;
+
+        bool runPendingTask() const override;
+
         void initializePlugin(const std::string& pluginName,
                               std::shared_ptr<Plugin::IPluginConfig> config,
                               const std::vector<std::string>& args);
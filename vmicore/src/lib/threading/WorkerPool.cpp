@@ -0,0 +1,261 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+namespace VmiCore
+{
+    class WorkerPool::Task : public ITaskHandle
+    {
+      public:
+        explicit Task(std::function<void(std::stop_token)> function) : function(std::move(function)) {}
+
+        void cancel() override
+        {
+            stopSource.request_stop();
+
+            std::scoped_lock guard(stateLock);
+            if (state == State::Pending)
+            {
+                state = State::Skipped;
+                function = nullptr;
+                finished.notify_all();
+            }
+        }
+
+        void wait() override
+        {
+            // Waiting workers process other tasks, otherwise all workers could end up waiting for tasks nobody runs
+            if (currentPool != nullptr)
+            {
+                while (!isDone() && currentPool->runPendingTask())
+                {
+                }
+            }
+
+            std::unique_lock guard(stateLock);
+            finished.wait(guard, [this]() { return state == State::Done || state == State::Skipped; });
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+
+        [[nodiscard]] bool isDone() const override
+        {
+            std::scoped_lock guard(stateLock);
+            return state == State::Done || state == State::Skipped;
+        }
+
+        [[nodiscard]] bool isCancelled() const override
+        {
+            return stopSource.stop_requested();
+        }
+
+        void run()
+        {
+            {
+                std::scoped_lock guard(stateLock);
+                if (state != State::Pending)
+                {
+                    return;
+                }
+                state = State::Running;
+            }
+
+            try
+            {
+                function(stopSource.get_token());
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+            function = nullptr;
+
+            std::scoped_lock guard(stateLock);
+            state = State::Done;
+            finished.notify_all();
+        }
+
+      private:
+        enum class State
+        {
+            Pending,
+            Running,
+            Done,
+            Skipped
+        };
+
+        std::function<void(std::stop_token)> function;
+        std::stop_source stopSource;
+        mutable std::mutex stateLock;
+        std::condition_variable finished;
+        State state = State::Pending;
+        std::exception_ptr exception;
+    };
+
+    thread_local WorkerPool* WorkerPool::currentPool = nullptr;
+    thread_local std::size_t WorkerPool::currentWorkerIndex = 0;
+
+    WorkerPool::WorkerPool(std::size_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::max(1U, std::thread::hardware_concurrency());
+        }
+
+        queues.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; i++)
+        {
+            queues.push_back(std::make_unique<WorkerQueue>());
+        }
+        workers.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; i++)
+        {
+            workers.emplace_back(&WorkerPool::work, this, i);
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        cancelPendingTasks();
+        {
+            std::scoped_lock guard(idleLock);
+            stopped = true;
+        }
+        taskAvailable.notify_all();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    std::shared_ptr<ITaskHandle> WorkerPool::submit(std::function<void(std::stop_token)> function)
+    {
+        auto task = std::make_shared<Task>(std::move(function));
+        auto queueIndex = currentPool == this ? currentWorkerIndex : nextQueue++ % queues.size();
+
+        {
+            std::scoped_lock guard(idleLock);
+            activeTasks++;
+        }
+        {
+            std::scoped_lock guard(queues[queueIndex]->lock);
+            queues[queueIndex]->tasks.push_back(task);
+        }
+        {
+            std::scoped_lock guard(idleLock);
+            queuedTasks++;
+        }
+        taskAvailable.notify_one();
+
+        return task;
+    }
+
+    void WorkerPool::cancelPendingTasks()
+    {
+        for (auto& queue : queues)
+        {
+            std::deque<std::shared_ptr<Task>> cancelledTasks;
+            {
+                std::scoped_lock guard(queue->lock);
+                cancelledTasks.swap(queue->tasks);
+            }
+            for (const auto& task : cancelledTasks)
+            {
+                task->cancel();
+            }
+
+            std::scoped_lock guard(idleLock);
+            queuedTasks -= static_cast<std::ptrdiff_t>(cancelledTasks.size());
+            activeTasks -= cancelledTasks.size();
+        }
+
+        std::unique_lock guard(idleLock);
+        allTasksFinished.wait(guard, [this]() { return activeTasks == 0; });
+    }
+
+    std::size_t WorkerPool::getThreadCount() const
+    {
+        return workers.size();
+    }
+
+    void WorkerPool::work(std::size_t workerIndex)
+    {
+        currentPool = this;
+        currentWorkerIndex = workerIndex;
+
+        while (true)
+        {
+            if (auto task = takeTask(workerIndex))
+            {
+                runTask(task);
+                continue;
+            }
+
+            std::unique_lock guard(idleLock);
+            taskAvailable.wait(guard, [this]() { return stopped || queuedTasks > 0; });
+            if (stopped && queuedTasks <= 0)
+            {
+                return;
+            }
+        }
+    }
+
+    std::shared_ptr<WorkerPool::Task> WorkerPool::takeTask(std::size_t workerIndex)
+    {
+        std::shared_ptr<Task> task;
+        {
+            auto& ownQueue = *queues[workerIndex];
+            std::scoped_lock guard(ownQueue.lock);
+            if (!ownQueue.tasks.empty())
+            {
+                task = std::move(ownQueue.tasks.back());
+                ownQueue.tasks.pop_back();
+            }
+        }
+        for (std::size_t offset = 1; !task && offset < queues.size(); offset++)
+        {
+            auto& otherQueue = *queues[(workerIndex + offset) % queues.size()];
+            std::scoped_lock guard(otherQueue.lock);
+            if (!otherQueue.tasks.empty())
+            {
+                task = std::move(otherQueue.tasks.front());
+                otherQueue.tasks.pop_front();
+            }
+        }
+
+        if (task)
+        {
+            // May become negative for a short time if the task has been taken before its submission has been counted
+            std::scoped_lock guard(idleLock);
+            queuedTasks--;
+        }
+        return task;
+    }
+
+    bool WorkerPool::runPendingTask()
+    {
+        if (currentPool != this)
+        {
+            return false;
+        }
+        auto task = takeTask(currentWorkerIndex);
+        if (!task)
+        {
+            return false;
+        }
+        runTask(task);
+        return true;
+    }
+
+    void WorkerPool::runTask(const std::shared_ptr<Task>& task)
+    {
+        task->run();
+
+        std::scoped_lock guard(idleLock);
+        if (--activeTasks == 0)
+        {
+            allTasksFinished.notify_all();
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef VMICORE_WORKERPOOL_H
+#define VMICORE_WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+#include <vmicore/threading/ITaskHandle.h>
+
+namespace VmiCore
+{
+    /**
+     * Fixed number of worker threads shared by VMICore and all plugins. Every worker owns a task queue. Tasks that are
+     * submitted from within a worker are put into its own queue, other submissions are distributed round robin. Idle
+     * workers steal the oldest tasks of other queues, while owners process their newest tasks first.
+     */
+    class WorkerPool
+    {
+      public:
+        /// A thread count of zero selects the number of hardware threads.
+        explicit WorkerPool(std::size_t threadCount);
+
+        WorkerPool(const WorkerPool&) = delete;
+
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /// Cancels all pending tasks and waits for running ones.
+        ~WorkerPool();
+
+        [[nodiscard]] std::shared_ptr<ITaskHandle> submit(std::function<void(std::stop_token)> function);
+
+        /// Skips all tasks that have not been started yet and blocks until running tasks have finished. Must not be
+        /// called from within a task.
+        void cancelPendingTasks();
+
+        [[nodiscard]] std::size_t getThreadCount() const;
+
+        /// Runs a single pending task on the calling thread. Returns false if there was none or if the caller is not a
+        /// worker of this pool.
+        bool runPendingTask();
+
+      private:
+        class Task;
+
+        struct WorkerQueue
+        {
+            std::mutex lock;
+            std::deque<std::shared_ptr<Task>> tasks;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::atomic<std::size_t> nextQueue = 0;
+        std::mutex idleLock;
+        std::condition_variable taskAvailable;
+        std::condition_variable allTasksFinished;
+        /// Submitted tasks that have not finished or been skipped yet.
+        std::size_t activeTasks = 0;
+        std::ptrdiff_t queuedTasks = 0;
+        bool stopped = false;
+        std::vector<std::thread> workers;
+
+        static thread_local WorkerPool* currentPool;
+        static thread_local std::size_t currentWorkerIndex;
+
+        void work(std::size_t workerIndex);
+
+        [[nodiscard]] std::shared_ptr<Task> takeTask(std::size_t workerIndex);
+
+        void runTask(const std::shared_ptr<Task>& task);
+    };
+}
+
+#endif // VMICORE_WORKERPOOL_H
@@ -4,7 +4,10 @@
 
 namespace VmiCore
 {
-    Event::Event(vmi_event_t* libvmiEvent) : libvmiEvent(libvmiEvent) {}
+    Event::Event(vmi_event_t* libvmiEvent, std::shared_ptr<IActiveProcessesSupervisor> activeProcessesSupervisor)
+        : libvmiEvent(libvmiEvent), activeProcessesSupervisor(std::move(activeProcessesSupervisor))
+    {
+    }
 
     uint64_t Event::getRax() const
     {
@@ -120,4 +123,9 @@ namespace VmiCore
             }
         }
     }
+
+    std::shared_ptr<const ActiveProcessInformation> Event::getProcessInformation() const
+    {
+        return activeProcessesSupervisor->getProcessInformationByDtb(getCr3());
+    }
 }
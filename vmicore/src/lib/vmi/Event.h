@@ -1,8 +1,10 @@
 #ifndef VMICORE_EVENT_H
 #define VMICORE_EVENT_H
 
+#include "../os/IActiveProcessesSupervisor.h"
 #include <cstdint>
 #include <libvmi/events.h>
+#include <memory>
 #include <vmicore/vmi/events/IInterruptEvent.h>
 
 namespace VmiCore
@@ -10,7 +12,7 @@ namespace VmiCore
     class Event : public IInterruptEvent
     {
       public:
-        explicit Event(vmi_event_t* libvmiEvent);
+        Event(vmi_event_t* libvmiEvent, std::shared_ptr<IActiveProcessesSupervisor> activeProcessesSupervisor);
 
         ~Event() override = default;
 
@@ -42,8 +44,11 @@ namespace VmiCore
 
         [[nodiscard]] addr_t getOffset() const override;
 
+        [[nodiscard]] std::shared_ptr<const ActiveProcessInformation> getProcessInformation() const override;
+
       private:
         vmi_event_t* libvmiEvent;
+        std::shared_ptr<IActiveProcessesSupervisor> activeProcessesSupervisor;
     };
 }
 
@@ -100,7 +100,7 @@ namespace VmiCore
         // Event needs to be allocated separately in order to avoid invalidating references (e.g. in libvmi) when the
         // enclosing object is moved or copied. Therefore, it is wrapped in a unique pointer.
         std::unique_ptr<vmi_event_t> event = std::make_unique<vmi_event_t>();
-        Event interruptEvent{event.get()};
+        Event interruptEvent{event.get(), activeProcessesSupervisor};
         std::mutex lock{};
         std::unique_ptr<vmi_event_t> contextSwitchEvent = std::make_unique<vmi_event_t>();
 
@@ -10,6 +10,15 @@ namespace VmiCore
     {
       public:
         MOCK_METHOD(std::unique_ptr<std::vector<MemoryRegion>>, extractAllMemoryRegions, (), (const override));
+
+        MOCK_METHOD(std::shared_ptr<const std::vector<MemoryRegion>>, getMemoryRegions, (), (const override));
+
+        MOCK_METHOD(std::shared_ptr<const CompactMemoryRegions>, getCompactMemoryRegions, (), (const override));
+
+        MOCK_METHOD(void,
+                    visitMemoryRegions,
+                    (const MemoryRegionFilter&, const MemoryRegionVisitor&),
+                    (const override));
     };
 }
 
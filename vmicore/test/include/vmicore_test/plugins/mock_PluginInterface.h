@@ -19,6 +19,23 @@ namespace VmiCore::Plugin
                     (),
                     (const, override));
 
+        MOCK_METHOD(std::shared_ptr<const ActiveProcessesSnapshot>, getRunningProcessesSnapshot, (), (const, override));
+
+        MOCK_METHOD(std::shared_ptr<const ActiveProcessInformation>,
+                    getProcessInformationByDtb,
+                    (addr_t),
+                    (const, override));
+
+        MOCK_METHOD(std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>,
+                    getProcessDescendants,
+                    (pid_t),
+                    (const, override));
+
+        MOCK_METHOD(std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>,
+                    getProcessAncestors,
+                    (pid_t),
+                    (const, override));
+
         MOCK_METHOD(void,
                     registerProcessStartEvent,
                     (const std::function<void(std::shared_ptr<const ActiveProcessInformation>)>&),
@@ -42,11 +59,20 @@ namespace VmiCore::Plugin
 
         MOCK_METHOD(void, writeToFile, (const std::string&, const std::vector<uint8_t>&), (const, override));
 
+        MOCK_METHOD(bool, writeToFile, (const std::string&, std::span<const FileChunk>), (const, override));
+
         MOCK_METHOD(void, sendErrorEvent, (std::string_view), (const, override));
 
         MOCK_METHOD(void, sendInMemDetectionEvent, (std::string_view), (const, override));
 
         MOCK_METHOD(std::shared_ptr<IIntrospectionAPI>, getIntrospectionAPI, (), (const, override));
+
+        MOCK_METHOD(std::shared_ptr<ITaskHandle>,
+                    submitTask,
+                    (std::function<void(std::stop_token)>),
+                    (const, override));
+
+        MOCK_METHOD(bool, runPendingTask, (), (const, override));
     };
 }
 
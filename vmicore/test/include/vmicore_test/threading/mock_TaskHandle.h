@@ -0,0 +1,22 @@
+#ifndef VMICORE_MOCK_TASKHANDLE_H
+#define VMICORE_MOCK_TASKHANDLE_H
+
+#include <gmock/gmock.h>
+#include <vmicore/threading/ITaskHandle.h>
+
+namespace VmiCore
+{
+    class MockTaskHandle : public ITaskHandle
+    {
+      public:
+        MOCK_METHOD(void, cancel, (), (override));
+
+        MOCK_METHOD(void, wait, (), (override));
+
+        MOCK_METHOD(bool, isDone, (), (const, override));
+
+        MOCK_METHOD(bool, isCancelled, (), (const, override));
+    };
+}
+
+#endif // VMICORE_MOCK_TASKHANDLE_H
@@ -31,6 +31,8 @@ namespace VmiCore
 
         MOCK_METHOD(std::filesystem::path, getPluginDirectory, (), (const override));
 
+        MOCK_METHOD(std::size_t, getWorkerThreadCount, (), (const override));
+
         MOCK_METHOD((const std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>>&),
                     getPlugins,
                     (),
@@ -0,0 +1,161 @@
+#include "../../config/mock_ConfigInterface.h"
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <filesystem>
+#include <fmt/core.h>
+#include <fstream>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <io/file/LegacyLogging.h>
+#include <iterator>
+#include <sys/resource.h>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace VmiCore
+{
+    class LegacyLoggingFixture : public testing::Test
+    {
+      protected:
+        std::filesystem::path resultsDirectory =
+            std::filesystem::temp_directory_path() / fmt::format("vmicore-legacylogging-{}", getpid());
+        std::shared_ptr<NiceMock<MockConfigInterface>> mockConfigInterface =
+            std::make_shared<NiceMock<MockConfigInterface>>();
+        std::unique_ptr<LegacyLogging> legacyLogging;
+
+        void SetUp() override
+        {
+            std::filesystem::create_directories(resultsDirectory);
+            ON_CALL(*mockConfigInterface, getResultsDirectory()).WillByDefault(Return(resultsDirectory));
+            legacyLogging = std::make_unique<LegacyLogging>(mockConfigInterface);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(resultsDirectory);
+        }
+
+        [[nodiscard]] std::vector<uint8_t> readFile(std::string_view fileName) const
+        {
+            std::ifstream file(resultsDirectory / fileName, std::ios::binary);
+            return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        }
+
+        static std::vector<uint8_t> concatenate(const std::vector<std::vector<uint8_t>>& buffers)
+        {
+            std::vector<uint8_t> result;
+            for (const auto& buffer : buffers)
+            {
+                result.insert(result.end(), buffer.cbegin(), buffer.cend());
+            }
+            return result;
+        }
+
+        static std::vector<FileChunk> toChunks(const std::vector<std::vector<uint8_t>>& buffers)
+        {
+            std::vector<FileChunk> chunks;
+            chunks.reserve(buffers.size());
+            for (const auto& buffer : buffers)
+            {
+                chunks.push_back({.data = buffer, .holeSize = 0});
+            }
+            return chunks;
+        }
+    };
+
+    TEST_F(LegacyLoggingFixture, saveBinaryToFile_moreChunksThanIovMax_allChunksWrittenInOrder)
+    {
+        std::vector<std::vector<uint8_t>> buffers;
+        for (std::size_t i = 0; i < 2 * IOV_MAX + 3; i++)
+        {
+            buffers.emplace_back(i % 7 + 1, static_cast<uint8_t>(i));
+        }
+
+        legacyLogging->saveBinaryToFile("chunks.bin", toChunks(buffers));
+
+        EXPECT_EQ(readFile("chunks.bin"), concatenate(buffers));
+    }
+
+    TEST_F(LegacyLoggingFixture, saveBinaryToFile_existingFile_chunksAppended)
+    {
+        std::vector<std::vector<uint8_t>> firstBuffers{{1, 2, 3}, {4, 5}};
+        std::vector<std::vector<uint8_t>> secondBuffers{{6}, {7, 8, 9}};
+
+        legacyLogging->saveBinaryToFile("chunks.bin", toChunks(firstBuffers));
+        legacyLogging->saveBinaryToFile("chunks.bin", toChunks(secondBuffers));
+
+        EXPECT_EQ(readFile("chunks.bin"), (std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+
+    TEST_F(LegacyLoggingFixture, saveBinaryToFile_chunksWithHolesAndTrailingHole_zeroFilledFileOfFullSize)
+    {
+        constexpr std::size_t holeSize = 3 * 4096;
+        std::vector<uint8_t> firstBuffer(4096, 0x11);
+        std::vector<uint8_t> secondBuffer(100, 0x22);
+        std::vector<FileChunk> chunks{{.data = firstBuffer, .holeSize = holeSize},
+                                      {.data = {}, .holeSize = holeSize},
+                                      {.data = secondBuffer, .holeSize = holeSize}};
+
+        legacyLogging->saveBinaryToFile("chunks.bin", chunks);
+
+        std::vector<uint8_t> expectedContent(firstBuffer);
+        expectedContent.resize(expectedContent.size() + 2 * holeSize, 0);
+        expectedContent.insert(expectedContent.end(), secondBuffer.cbegin(), secondBuffer.cend());
+        expectedContent.resize(expectedContent.size() + holeSize, 0);
+        EXPECT_EQ(std::filesystem::file_size(resultsDirectory / "chunks.bin"), expectedContent.size());
+        EXPECT_EQ(readFile("chunks.bin"), expectedContent);
+    }
+
+    TEST_F(LegacyLoggingFixture, saveBinaryToFile_existingFileAndOnlyHoles_holesAppended)
+    {
+        std::vector<uint8_t> buffer{1, 2, 3};
+        std::vector<FileChunk> dataChunks{{.data = buffer, .holeSize = 0}};
+        std::vector<FileChunk> holeChunks{{.data = {}, .holeSize = 5}};
+
+        legacyLogging->saveBinaryToFile("chunks.bin", dataChunks);
+        legacyLogging->saveBinaryToFile("chunks.bin", holeChunks);
+        legacyLogging->saveBinaryToFile("chunks.bin", dataChunks);
+
+        EXPECT_EQ(readFile("chunks.bin"), (std::vector<uint8_t>{1, 2, 3, 0, 0, 0, 0, 0, 1, 2, 3}));
+    }
+
+    TEST_F(LegacyLoggingFixture, saveBinaryToFile_partialWriteWithinChunk_writeContinuedAfterWrittenBytes)
+    {
+        // The file size limit stops the first writev within the second chunk. Only the continued write of the
+        // remaining bytes fails, which is reported as a write error instead of an error resizing the file.
+        constexpr rlim_t fileSizeLimit = 1000;
+        std::vector<std::vector<uint8_t>> buffers{std::vector<uint8_t>(600, 0x11),
+                                                  std::vector<uint8_t>(600, 0x22),
+                                                  std::vector<uint8_t>(600, 0x33)};
+        rlimit originalLimit{};
+        ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &originalLimit), 0);
+        auto originalHandler = signal(SIGXFSZ, SIG_IGN);
+        rlimit limit{.rlim_cur = fileSizeLimit, .rlim_max = originalLimit.rlim_max};
+        ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+
+        std::error_code error;
+        std::string errorMessage;
+        try
+        {
+            legacyLogging->saveBinaryToFile("chunks.bin", toChunks(buffers));
+        }
+        catch (const std::system_error& e)
+        {
+            error = e.code();
+            errorMessage = e.what();
+        }
+
+        setrlimit(RLIMIT_FSIZE, &originalLimit);
+        signal(SIGXFSZ, originalHandler);
+        EXPECT_EQ(error, std::error_code(EFBIG, std::generic_category()));
+        EXPECT_THAT(errorMessage, testing::HasSubstr("Unable to write"));
+        auto expectedContent = concatenate(buffers);
+        expectedContent.resize(fileSizeLimit);
+        EXPECT_EQ(readFile("chunks.bin"), expectedContent);
+    }
+}
@@ -13,6 +13,11 @@ namespace VmiCore
                     saveBinaryToFile,
                     (std::string_view logFileName, const std::vector<uint8_t>& data),
                     (override));
+
+        MOCK_METHOD(void,
+                    saveBinaryToFile,
+                    (std::string_view logFileName, std::span<const FileChunk> chunks),
+                    (override));
     };
 }
 
@@ -0,0 +1,95 @@
+#include "KernelMemoryState.h"
+#include <os/linux/ActiveProcessesSupervisor.h>
+
+namespace VmiCore::Linux
+{
+    class LinuxActiveProcessesSupervisorFixture : public KernelMemoryStateFixture
+    {
+      protected:
+        static constexpr uint64_t rootMount = 0xffff888100010000;
+        static constexpr uint64_t rootDentry = 0xffff888100020000;
+        static constexpr uint64_t binDentry = 0xffff888100030000;
+        static constexpr uint64_t initTaskStruct = 0xffff888100100000;
+        static constexpr uint64_t bashTaskStruct = 0xffff888100110000;
+        static constexpr uint64_t bashMm = 0xffff888100200000;
+        static constexpr uint64_t bashDtb = 0x3c5000;
+        static constexpr pid_t bashPid = 300;
+
+        std::unique_ptr<ActiveProcessesSupervisor> activeProcessesSupervisor;
+
+        void SetUp() override
+        {
+            KernelMemoryStateFixture::SetUp();
+            setupMount(rootMount, rootDentry, rootDentry, rootMount);
+            setupDentry(rootDentry, rootDentry, "/");
+            setupDentry(binDentry, rootDentry, "bash");
+            setupProcess(bashTaskStruct, bashPid, initTaskStruct, "bash", bashMm, bashDtb, rootMount, binDentry);
+            memory32[initTaskStruct + offsetOf("task_struct", "tgid")] = 1;
+
+            activeProcessesSupervisor =
+                std::make_unique<ActiveProcessesSupervisor>(mockVmiInterface, mockLogging, mockEventStream);
+        }
+    };
+
+    TEST_F(LinuxActiveProcessesSupervisorFixture, getProcessInformationByDtb_addedProcess_correctProcessInformation)
+    {
+        activeProcessesSupervisor->addNewProcess(bashTaskStruct);
+
+        auto processInformation = activeProcessesSupervisor->getProcessInformationByDtb(bashDtb);
+
+        ASSERT_NE(processInformation, nullptr);
+        EXPECT_EQ(processInformation->pid, bashPid);
+        EXPECT_EQ(processInformation->base, bashTaskStruct);
+        EXPECT_EQ(*processInformation->processPath, "/bash");
+    }
+
+    TEST_F(LinuxActiveProcessesSupervisorFixture, getProcessInformationByDtb_dtbWithPcid_correctProcessInformation)
+    {
+        constexpr uint64_t pcid = 0x2;
+        activeProcessesSupervisor->addNewProcess(bashTaskStruct);
+
+        auto processInformation = activeProcessesSupervisor->getProcessInformationByDtb(bashDtb + pcid);
+
+        ASSERT_NE(processInformation, nullptr);
+        EXPECT_EQ(processInformation->pid, bashPid);
+    }
+
+    TEST_F(LinuxActiveProcessesSupervisorFixture, getProcessInformationByDtb_removedProcess_nullptr)
+    {
+        activeProcessesSupervisor->addNewProcess(bashTaskStruct);
+
+        activeProcessesSupervisor->removeActiveProcess(bashTaskStruct);
+
+        EXPECT_EQ(activeProcessesSupervisor->getProcessInformationByDtb(bashDtb), nullptr);
+    }
+
+    TEST_F(LinuxActiveProcessesSupervisorFixture, getProcessInformationByDtb_pidReusedWithNewDtb_onlyNewDtbFound)
+    {
+        constexpr uint64_t newTaskStruct = 0xffff888100120000;
+        constexpr uint64_t newMm = 0xffff888100300000;
+        constexpr uint64_t newDtb = 0x4d6000;
+        activeProcessesSupervisor->addNewProcess(bashTaskStruct);
+        setupProcess(newTaskStruct, bashPid, initTaskStruct, "bash", newMm, newDtb, rootMount, binDentry);
+
+        activeProcessesSupervisor->addNewProcess(newTaskStruct);
+
+        EXPECT_EQ(activeProcessesSupervisor->getProcessInformationByDtb(bashDtb), nullptr);
+        auto processInformation = activeProcessesSupervisor->getProcessInformationByDtb(newDtb);
+        ASSERT_NE(processInformation, nullptr);
+        EXPECT_EQ(processInformation->base, newTaskStruct);
+    }
+
+    TEST_F(LinuxActiveProcessesSupervisorFixture, addNewProcess_afterProcessExit_processPathResolvedAgain)
+    {
+        activeProcessesSupervisor->addNewProcess(bashTaskStruct);
+        // The dentry is freed and reused for a different file
+        setupDentry(binDentry, rootDentry, "zsh");
+        activeProcessesSupervisor->removeActiveProcess(bashTaskStruct);
+
+        activeProcessesSupervisor->addNewProcess(bashTaskStruct);
+
+        auto processInformation = activeProcessesSupervisor->getProcessInformationByDtb(bashDtb);
+        ASSERT_NE(processInformation, nullptr);
+        EXPECT_EQ(*processInformation->processPath, "/zsh");
+    }
+}
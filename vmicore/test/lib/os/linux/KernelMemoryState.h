@@ -0,0 +1,157 @@
+#ifndef VMICORE_LINUX_KERNELMEMORYSTATEFIXTURE_H
+#define VMICORE_LINUX_KERNELMEMORYSTATEFIXTURE_H
+
+#include "../../io/mock_EventStream.h"
+#include "../../io/mock_Logging.h"
+#include "../../vmi/mock_LibvmiInterface.h"
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <os/linux/Constants.h>
+#include <string>
+#include <utility>
+#include <vmi/VmiException.h>
+#include <vmicore_test/io/mock_Logger.h>
+
+namespace VmiCore::Linux
+{
+    /// Kernel memory of a Linux guest, which is populated by each test. Reads of unpopulated addresses fail.
+    class KernelMemoryStateFixture : public testing::Test
+    {
+      protected:
+        static constexpr uint64_t systemDtb = 0x1aa000;
+
+        std::map<std::pair<std::string, std::string>, addr_t> kernelStructOffsets{
+            {{"task_struct", "mm"}, 0x40},
+            {{"task_struct", "real_parent"}, 0x48},
+            {{"task_struct", "tgid"}, 0x50},
+            {{"mm_struct", "exe_file"}, 0x30},
+            {{"mm_struct", "map_count"}, 0x38},
+            {{"mm_struct", "mm_lock_seq"}, 0x3c},
+            {{"vm_area_struct", "vm_start"}, 0x0},
+            {{"vm_area_struct", "vm_end"}, 0x8},
+            {{"vm_area_struct", "vm_flags"}, 0x20},
+            {{"vm_area_struct", "vm_file"}, 0xa0},
+            {{"file", "f_path"}, 0x10},
+            {{"path", "mnt"}, 0x0},
+            {{"path", "dentry"}, 0x8},
+            {{"dentry", "d_parent"}, 0x18},
+            {{"dentry", "d_name"}, 0x20},
+            {{"qstr", "name"}, 0x8},
+            {{"mount", "mnt_parent"}, 0x10},
+            {{"mount", "mnt"}, 0x20},
+            {{"mount", "mnt_mountpoint"}, 0x38}};
+        std::map<std::string, uint64_t> offsets{
+            {"linux_pid", 0x58}, {"linux_name", 0x60}, {"linux_pgd", 0x50}, {"linux_tasks", 0x70}};
+        std::map<uint64_t, uint64_t> memory64;
+        std::map<uint64_t, uint32_t> memory32;
+        std::map<uint64_t, std::string> strings;
+        std::map<uint64_t, uint64_t> physicalAddresses;
+
+        std::shared_ptr<testing::NiceMock<MockLibvmiInterface>> mockVmiInterface =
+            std::make_shared<testing::NiceMock<MockLibvmiInterface>>();
+        std::shared_ptr<testing::NiceMock<MockLogging>> mockLogging =
+            std::make_shared<testing::NiceMock<MockLogging>>();
+        std::shared_ptr<testing::NiceMock<MockEventStream>> mockEventStream =
+            std::make_shared<testing::NiceMock<MockEventStream>>();
+
+        void SetUp() override
+        {
+            using testing::_;
+            using testing::Return;
+
+            ON_CALL(*mockLogging, newNamedLogger(_))
+                .WillByDefault([](std::string_view) { return std::make_unique<testing::NiceMock<MockLogger>>(); });
+            ON_CALL(*mockVmiInterface, convertPidToDtb(SYSTEM_PID)).WillByDefault(Return(systemDtb));
+            ON_CALL(*mockVmiInterface, getKernelStructOffset(_, _))
+                .WillByDefault(
+                    [this](const std::string& structName, const std::string& member)
+                    {
+                        auto offset = kernelStructOffsets.find({structName, member});
+                        if (offset == kernelStructOffsets.end())
+                        {
+                            throw VmiException(fmt::format("No offset of {} in {}", member, structName));
+                        }
+                        return offset->second;
+                    });
+            ON_CALL(*mockVmiInterface, getOffset(_))
+                .WillByDefault([this](const std::string& name) { return offsets.at(name); });
+            ON_CALL(*mockVmiInterface, read64VA(_, systemDtb))
+                .WillByDefault([this](uint64_t address, uint64_t) { return readFrom(memory64, address); });
+            ON_CALL(*mockVmiInterface, read32VA(_, systemDtb))
+                .WillByDefault([this](uint64_t address, uint64_t) { return readFrom(memory32, address); });
+            ON_CALL(*mockVmiInterface, extractStringAtVA(_, systemDtb))
+                .WillByDefault([this](uint64_t address, uint64_t)
+                               { return std::make_unique<std::string>(readFrom(strings, address)); });
+            ON_CALL(*mockVmiInterface, convertVAToPA(_, systemDtb))
+                .WillByDefault([this](uint64_t address, uint64_t) { return readFrom(physicalAddresses, address); });
+        }
+
+        template <typename T> static T readFrom(const std::map<uint64_t, T>& memory, uint64_t address)
+        {
+            auto value = memory.find(address);
+            if (value == memory.end())
+            {
+                throw VmiException(fmt::format("Unable to read from {:#x}", address));
+            }
+            return value->second;
+        }
+
+        [[nodiscard]] addr_t offsetOf(const std::string& structName, const std::string& member) const
+        {
+            return kernelStructOffsets.at({structName, member});
+        }
+
+        /// The name of the dentry is stored right behind it.
+        void setupDentry(uint64_t dentry, uint64_t parent, const std::string& name)
+        {
+            auto nameAddress = dentry + 0x100;
+            memory64[dentry + offsetOf("dentry", "d_name") + offsetOf("qstr", "name")] = nameAddress;
+            strings[nameAddress] = name;
+            memory64[dentry + offsetOf("dentry", "d_parent")] = parent;
+        }
+
+        /// A mount without a parent mount is its own parent.
+        void setupMount(uint64_t mount, uint64_t root, uint64_t mountpoint, uint64_t parent)
+        {
+            memory64[mount + offsetOf("mount", "mnt")] = root;
+            memory64[mount + offsetOf("mount", "mnt_mountpoint")] = mountpoint;
+            memory64[mount + offsetOf("mount", "mnt_parent")] = parent;
+        }
+
+        /// Populates a struct path referring to the given dentry within the given mount.
+        void setupPath(uint64_t path, uint64_t mount, uint64_t dentry)
+        {
+            memory64[path + offsetOf("path", "mnt")] = mount + offsetOf("mount", "mnt");
+            memory64[path + offsetOf("path", "dentry")] = dentry;
+        }
+
+        /// Populates a task struct whose executable file is located at the given dentry of the given mount.
+        void setupProcess(uint64_t taskStruct,
+                          pid_t pid,
+                          uint64_t parentTaskStruct,
+                          const std::string& name,
+                          uint64_t mm,
+                          uint64_t dtb,
+                          uint64_t mount,
+                          uint64_t exeDentry)
+        {
+            memory32[taskStruct + offsets.at("linux_pid")] = static_cast<uint32_t>(pid);
+            memory32[taskStruct + offsetOf("task_struct", "tgid")] = static_cast<uint32_t>(pid);
+            memory64[taskStruct + offsetOf("task_struct", "real_parent")] = parentTaskStruct;
+            memory64[taskStruct + offsetOf("task_struct", "mm")] = mm;
+            strings[taskStruct + offsets.at("linux_name")] = name;
+
+            auto pgd = mm + 0x1000;
+            memory64[mm + offsets.at("linux_pgd")] = pgd;
+            physicalAddresses[pgd] = dtb;
+            auto exeFile = mm + 0x2000;
+            memory64[mm + offsetOf("mm_struct", "exe_file")] = exeFile;
+            setupPath(exeFile + offsetOf("file", "f_path"), mount, exeDentry);
+        }
+    };
+}
+
+#endif // VMICORE_LINUX_KERNELMEMORYSTATEFIXTURE_H
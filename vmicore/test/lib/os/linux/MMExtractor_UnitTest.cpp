@@ -0,0 +1,135 @@
+#include "KernelMemoryState.h"
+#include "mock_VmAreaWalker.h"
+#include <os/linux/MMExtractor.h>
+#include <os/linux/PathExtractor.h>
+
+using testing::Return;
+
+namespace VmiCore::Linux
+{
+    class MMExtractorFixture : public KernelMemoryStateFixture
+    {
+      protected:
+        static constexpr uint64_t mm = 0xffff888100200000;
+        static constexpr uint64_t heapArea = 0xffff888100400000;
+        static constexpr uint64_t stackArea = 0xffff888100410000;
+        static constexpr uint64_t heapStart = 0x5000000;
+        static constexpr uint64_t heapEnd = 0x5021000;
+        static constexpr uint64_t stackStart = 0x7ffd0000;
+        static constexpr uint64_t stackEnd = 0x7fff0000;
+
+        std::shared_ptr<testing::NiceMock<MockVmAreaWalker>> mockVmAreaWalker =
+            std::make_shared<testing::NiceMock<MockVmAreaWalker>>();
+        std::shared_ptr<ModuleNameTableGenerations> moduleNameTables = std::make_shared<ModuleNameTableGenerations>();
+
+        void SetUp() override
+        {
+            KernelMemoryStateFixture::SetUp();
+            setupVmArea(heapArea, heapStart, heapEnd);
+            setupVmArea(stackArea, stackStart, stackEnd);
+            memory32[mm + offsetOf("mm_struct", "map_count")] = 2;
+            memory32[mm + offsetOf("mm_struct", "mm_lock_seq")] = 10;
+            ON_CALL(*mockVmAreaWalker, extractVmAreas(mm))
+                .WillByDefault(Return(std::vector<uint64_t>{heapArea, stackArea}));
+        }
+
+        void setupVmArea(uint64_t area, uint64_t start, uint64_t end)
+        {
+            memory64[area + offsetOf("vm_area_struct", "vm_start")] = start;
+            memory64[area + offsetOf("vm_area_struct", "vm_end")] = end;
+            memory64[area + offsetOf("vm_area_struct", "vm_flags")] = 0x3;
+            memory64[area + offsetOf("vm_area_struct", "vm_file")] = 0;
+        }
+
+        [[nodiscard]] std::unique_ptr<MMExtractor> createMMExtractor() const
+        {
+            return std::make_unique<MMExtractor>(mockVmiInterface,
+                                                 mockLogging,
+                                                 std::make_shared<PathExtractor>(mockVmiInterface, mockLogging),
+                                                 mockVmAreaWalker,
+                                                 moduleNameTables,
+                                                 mm);
+        }
+    };
+
+    TEST_F(MMExtractorFixture, getCompactMemoryRegions_unchangedMmState_vmAreasWalkedOnce)
+    {
+        auto mmExtractor = createMMExtractor();
+        EXPECT_CALL(*mockVmAreaWalker, extractVmAreas(mm)).Times(1);
+
+        auto firstRegions = mmExtractor->getCompactMemoryRegions();
+        auto secondRegions = mmExtractor->getCompactMemoryRegions();
+
+        EXPECT_EQ(firstRegions, secondRegions);
+        EXPECT_EQ(secondRegions->get().size(), 2);
+    }
+
+    TEST_F(MMExtractorFixture, getCompactMemoryRegions_sequenceNumberChanged_modifiedVmAreaReturned)
+    {
+        constexpr uint64_t grownHeapEnd = 0x5042000;
+        auto mmExtractor = createMMExtractor();
+        auto firstRegions = mmExtractor->getCompactMemoryRegions();
+        memory64[heapArea + offsetOf("vm_area_struct", "vm_end")] = grownHeapEnd;
+        memory32[mm + offsetOf("mm_struct", "mm_lock_seq")] = 11;
+
+        auto secondRegions = mmExtractor->getCompactMemoryRegions();
+
+        EXPECT_NE(firstRegions, secondRegions);
+        EXPECT_EQ(secondRegions->get()[0].size, grownHeapEnd - heapStart + 1);
+    }
+
+    TEST_F(MMExtractorFixture, getCompactMemoryRegions_mapCountChanged_vmAreasWalkedAgain)
+    {
+        auto mmExtractor = createMMExtractor();
+        auto firstRegions = mmExtractor->getCompactMemoryRegions();
+        memory32[mm + offsetOf("mm_struct", "map_count")] = 1;
+        ON_CALL(*mockVmAreaWalker, extractVmAreas(mm)).WillByDefault(Return(std::vector<uint64_t>{heapArea}));
+
+        auto secondRegions = mmExtractor->getCompactMemoryRegions();
+
+        EXPECT_EQ(secondRegions->get().size(), 1);
+    }
+
+    TEST_F(MMExtractorFixture, getCompactMemoryRegions_noSequenceNumber_vmAreasWalkedEveryTime)
+    {
+        kernelStructOffsets.erase({"mm_struct", "mm_lock_seq"});
+        auto mmExtractor = createMMExtractor();
+        EXPECT_CALL(*mockVmAreaWalker, extractVmAreas(mm)).Times(2);
+
+        auto firstRegions = mmExtractor->getCompactMemoryRegions();
+        auto secondRegions = mmExtractor->getCompactMemoryRegions();
+
+        EXPECT_EQ(firstRegions, secondRegions);
+    }
+
+    TEST_F(MMExtractorFixture, getCompactMemoryRegions_moduleNameTableFull_namesInternedIntoNewGeneration)
+    {
+        constexpr uint64_t rootMount = 0xffff888100010000;
+        constexpr uint64_t rootDentry = 0xffff888100020000;
+        constexpr uint64_t libcDentry = 0xffff888100030000;
+        constexpr uint64_t libmDentry = 0xffff888100040000;
+        constexpr uint64_t libcFile = 0xffff888100500000;
+        constexpr uint64_t libmFile = 0xffff888100510000;
+        setupMount(rootMount, rootDentry, rootDentry, rootMount);
+        setupDentry(rootDentry, rootDentry, "/");
+        setupDentry(libcDentry, rootDentry, "libc.so");
+        setupDentry(libmDentry, rootDentry, "libm.so");
+        setupPath(libcFile + offsetOf("file", "f_path"), rootMount, libcDentry);
+        setupPath(libmFile + offsetOf("file", "f_path"), rootMount, libmDentry);
+        memory64[heapArea + offsetOf("vm_area_struct", "vm_file")] = libcFile;
+        // Room for the empty name and a single module name
+        moduleNameTables = std::make_shared<ModuleNameTableGenerations>(2);
+        auto firstGeneration = moduleNameTables->getCurrent();
+        auto mmExtractor = createMMExtractor();
+        auto firstRegions = mmExtractor->getCompactMemoryRegions();
+        memory64[heapArea + offsetOf("vm_area_struct", "vm_file")] = libmFile;
+        memory32[mm + offsetOf("mm_struct", "mm_lock_seq")] = 11;
+
+        auto secondRegions = mmExtractor->getCompactMemoryRegions();
+
+        EXPECT_EQ(firstGeneration->size(), 2);
+        EXPECT_NE(moduleNameTables->getCurrent(), firstGeneration);
+        EXPECT_EQ(firstRegions->getModuleName(firstRegions->get()[0]), "/libc.so");
+        EXPECT_EQ(secondRegions->getModuleName(secondRegions->get()[0]), "/libm.so");
+    }
+}
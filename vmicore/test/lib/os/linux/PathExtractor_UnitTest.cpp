@@ -0,0 +1,86 @@
+#include "KernelMemoryState.h"
+#include <os/linux/PathExtractor.h>
+
+namespace VmiCore::Linux
+{
+    class PathExtractorFixture : public KernelMemoryStateFixture
+    {
+      protected:
+        static constexpr uint64_t rootMount = 0xffff888100010000;
+        static constexpr uint64_t rootDentry = 0xffff888100020000;
+        static constexpr uint64_t binDentry = 0xffff888100030000;
+        static constexpr uint64_t bashDentry = 0xffff888100040000;
+        static constexpr uint64_t shDentry = 0xffff888100050000;
+        static constexpr uint64_t path = 0xffff888100060000;
+
+        std::unique_ptr<PathExtractor> pathExtractor;
+
+        void SetUp() override
+        {
+            KernelMemoryStateFixture::SetUp();
+            setupMount(rootMount, rootDentry, rootDentry, rootMount);
+            setupDentry(rootDentry, rootDentry, "/");
+            setupDentry(binDentry, rootDentry, "bin");
+            setupDentry(bashDentry, binDentry, "bash");
+            setupDentry(shDentry, binDentry, "sh");
+            setupPath(path, rootMount, bashDentry);
+
+            pathExtractor = std::make_unique<PathExtractor>(mockVmiInterface, mockLogging);
+        }
+
+        /// Renames the dentry without the path extractor noticing, as happens when it is freed and reallocated.
+        void renameDentry(uint64_t dentry, const std::string& name)
+        {
+            strings[dentry + 0x100] = name;
+        }
+    };
+
+    TEST_F(PathExtractorFixture, extractDPath_validPath_correctPath)
+    {
+        EXPECT_EQ(pathExtractor->extractDPath(path), "/bin/bash");
+    }
+
+    TEST_F(PathExtractorFixture, extractDPath_resolvedBefore_cachedPathReturned)
+    {
+        auto firstPath = pathExtractor->extractDPath(path);
+        renameDentry(bashDentry, "zsh");
+
+        auto secondPath = pathExtractor->extractDPath(path);
+
+        EXPECT_EQ(secondPath, firstPath);
+    }
+
+    TEST_F(PathExtractorFixture, extractDPath_cacheInvalidated_pathResolvedAgain)
+    {
+        auto firstPath = pathExtractor->extractDPath(path);
+        renameDentry(bashDentry, "zsh");
+
+        pathExtractor->invalidateCache();
+
+        EXPECT_EQ(firstPath, "/bin/bash");
+        EXPECT_EQ(pathExtractor->extractDPath(path), "/bin/zsh");
+    }
+
+    TEST_F(PathExtractorFixture, extractDPath_pathRefersToDifferentDentry_newPathReturned)
+    {
+        auto firstPath = pathExtractor->extractDPath(path);
+        setupPath(path, rootMount, shDentry);
+
+        auto secondPath = pathExtractor->extractDPath(path);
+
+        EXPECT_EQ(firstPath, "/bin/bash");
+        EXPECT_EQ(secondPath, "/bin/sh");
+    }
+
+    TEST_F(PathExtractorFixture, extractDPath_unreadableDentry_incompletePathNotCached)
+    {
+        memory64.erase(binDentry + offsetOf("dentry", "d_parent"));
+        auto firstPath = pathExtractor->extractDPath(path);
+        setupDentry(binDentry, rootDentry, "bin");
+
+        auto secondPath = pathExtractor->extractDPath(path);
+
+        EXPECT_EQ(firstPath, "/bash");
+        EXPECT_EQ(secondPath, "/bin/bash");
+    }
+}
@@ -0,0 +1,188 @@
+#include "../../io/mock_Logging.h"
+#include "../../vmi/mock_LibvmiInterface.h"
+#include <cstring>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <map>
+#include <os/linux/Constants.h>
+#include <os/linux/VmAreaWalker.h>
+#include <vmicore_test/io/mock_Logger.h>
+
+using testing::_;
+using testing::ElementsAre;
+using testing::IsEmpty;
+using testing::NiceMock;
+using testing::Return;
+
+namespace VmiCore::Linux
+{
+    class MapleTreeVmAreaWalkerFixture : public testing::Test
+    {
+      protected:
+        // Layout of struct maple_node, see include/linux/maple_tree.h
+        static constexpr std::size_t mapleNodeSize = 256;
+        static constexpr std::size_t pivotsOffset = 0x8;
+        static constexpr std::size_t range64SlotsOffset = 0x80;
+        static constexpr std::size_t range64MetadataOffset = 0xF8;
+        static constexpr std::size_t arange64SlotsOffset = 0x50;
+        static constexpr std::size_t arange64MetadataOffset = 0xF0;
+        static constexpr uint64_t leaf64Type = 1;
+        static constexpr uint64_t range64Type = 2;
+        static constexpr uint64_t arange64Type = 3;
+
+        static constexpr uint64_t systemDtb = 0x1aa000;
+        static constexpr uint64_t mm = 0xffff888100200000;
+        static constexpr uint64_t mmMtOffset = 0x40;
+        static constexpr uint64_t maRootOffset = 0x8;
+        static constexpr uint64_t rootNode = 0xffff888100300000;
+        static constexpr uint64_t firstLeafNode = 0xffff888100300100;
+        static constexpr uint64_t secondLeafNode = 0xffff888100300200;
+
+        std::shared_ptr<NiceMock<MockLibvmiInterface>> mockVmiInterface =
+            std::make_shared<NiceMock<MockLibvmiInterface>>();
+        std::shared_ptr<NiceMock<MockLogging>> mockLogging = std::make_shared<NiceMock<MockLogging>>();
+        std::map<uint64_t, std::vector<uint8_t>> mapleNodes;
+        std::unique_ptr<MapleTreeVmAreaWalker> vmAreaWalker;
+
+        void SetUp() override
+        {
+            ON_CALL(*mockLogging, newNamedLogger(_))
+                .WillByDefault([](std::string_view) { return std::make_unique<NiceMock<MockLogger>>(); });
+            ON_CALL(*mockVmiInterface, getKernelStructOffset("mm_struct", "mm_mt")).WillByDefault(Return(mmMtOffset));
+            ON_CALL(*mockVmiInterface, getKernelStructOffset("maple_tree", "ma_root"))
+                .WillByDefault(Return(maRootOffset));
+            ON_CALL(*mockVmiInterface, convertPidToDtb(SYSTEM_PID)).WillByDefault(Return(systemDtb));
+            ON_CALL(*mockVmiInterface, readXVA(_, systemDtb, _, mapleNodeSize))
+                .WillByDefault(
+                    [this](uint64_t address, uint64_t, std::vector<uint8_t>& content, std::size_t size)
+                    {
+                        auto node = mapleNodes.find(address);
+                        if (node == mapleNodes.end() || content.size() < size)
+                        {
+                            return false;
+                        }
+                        std::copy_n(node->second.cbegin(), size, content.begin());
+                        return true;
+                    });
+
+            vmAreaWalker = std::make_unique<MapleTreeVmAreaWalker>(mockVmiInterface, mockLogging);
+        }
+
+        void setupRoot(uint64_t root)
+        {
+            ON_CALL(*mockVmiInterface, read64VA(mm + mmMtOffset + maRootOffset, systemDtb)).WillByDefault(Return(root));
+        }
+
+        static uint64_t encodeNode(uint64_t nodeAddress, uint64_t type)
+        {
+            return nodeAddress | (type << 3) | 0x2;
+        }
+
+        static void writeToNode(std::vector<uint8_t>& node, std::size_t offset, uint64_t value)
+        {
+            std::memcpy(node.data() + offset, &value, sizeof(value));
+        }
+
+        /// Creates a node that is not completely filled, so that the index of its last used slot is read from the
+        /// metadata.
+        void setupNode(uint64_t nodeAddress,
+                       std::size_t slotsOffset,
+                       std::size_t metadataOffset,
+                       const std::vector<uint64_t>& pivots,
+                       const std::vector<uint64_t>& slots)
+        {
+            std::vector<uint8_t> node(mapleNodeSize, 0);
+            for (std::size_t i = 0; i < pivots.size(); i++)
+            {
+                writeToNode(node, pivotsOffset + i * sizeof(uint64_t), pivots[i]);
+            }
+            for (std::size_t i = 0; i < slots.size(); i++)
+            {
+                writeToNode(node, slotsOffset + i * sizeof(uint64_t), slots[i]);
+            }
+            node[metadataOffset] = static_cast<uint8_t>(slots.size() - 1);
+            mapleNodes[nodeAddress] = std::move(node);
+        }
+
+        void setupLeaves()
+        {
+            setupNode(firstLeafNode,
+                      range64SlotsOffset,
+                      range64MetadataOffset,
+                      {0x400fff, 0x401fff, 0x7fffffff},
+                      {0xffff888101000000, 0, 0xffff888101000100});
+            setupNode(secondLeafNode,
+                      range64SlotsOffset,
+                      range64MetadataOffset,
+                      {0x7ffff7ffffff},
+                      {0xffff888101000200, 0xffff888101000300});
+        }
+    };
+
+    TEST_F(MapleTreeVmAreaWalkerFixture, extractVmAreas_emptyTree_noVmAreasAndNoNodeRead)
+    {
+        setupRoot(0);
+
+        EXPECT_CALL(*mockVmiInterface, readXVA(_, _, _, _)).Times(0);
+
+        EXPECT_THAT(vmAreaWalker->extractVmAreas(mm), IsEmpty());
+    }
+
+    TEST_F(MapleTreeVmAreaWalkerFixture, extractVmAreas_singleEntryInRoot_entryReturned)
+    {
+        setupRoot(0xffff888101000000);
+
+        EXPECT_THAT(vmAreaWalker->extractVmAreas(mm), ElementsAre(0xffff888101000000));
+    }
+
+    TEST_F(MapleTreeVmAreaWalkerFixture, extractVmAreas_leafRoot_nonEmptySlotsReturned)
+    {
+        setupLeaves();
+        setupRoot(encodeNode(firstLeafNode, leaf64Type));
+
+        EXPECT_THAT(vmAreaWalker->extractVmAreas(mm), ElementsAre(0xffff888101000000, 0xffff888101000100));
+    }
+
+    TEST_F(MapleTreeVmAreaWalkerFixture, extractVmAreas_range64Root_vmAreasOfAllLeavesInOrder)
+    {
+        setupLeaves();
+        setupNode(rootNode,
+                  range64SlotsOffset,
+                  range64MetadataOffset,
+                  {0x7fffffff},
+                  {encodeNode(firstLeafNode, leaf64Type), encodeNode(secondLeafNode, leaf64Type)});
+        setupRoot(encodeNode(rootNode, range64Type));
+
+        EXPECT_THAT(
+            vmAreaWalker->extractVmAreas(mm),
+            ElementsAre(0xffff888101000000, 0xffff888101000100, 0xffff888101000200, 0xffff888101000300));
+    }
+
+    TEST_F(MapleTreeVmAreaWalkerFixture, extractVmAreas_arange64Root_vmAreasOfAllLeavesInOrder)
+    {
+        setupLeaves();
+        setupNode(rootNode,
+                  arange64SlotsOffset,
+                  arange64MetadataOffset,
+                  {0x7fffffff},
+                  {encodeNode(firstLeafNode, leaf64Type), encodeNode(secondLeafNode, leaf64Type)});
+        setupRoot(encodeNode(rootNode, arange64Type));
+
+        EXPECT_THAT(
+            vmAreaWalker->extractVmAreas(mm),
+            ElementsAre(0xffff888101000000, 0xffff888101000100, 0xffff888101000200, 0xffff888101000300));
+    }
+
+    TEST_F(MapleTreeVmAreaWalkerFixture, extractVmAreas_childReferencingItsParent_cycleSkipped)
+    {
+        setupNode(rootNode,
+                  range64SlotsOffset,
+                  range64MetadataOffset,
+                  {0x7fffffff},
+                  {encodeNode(firstLeafNode, leaf64Type), encodeNode(rootNode, range64Type)});
+        setupLeaves();
+        setupRoot(encodeNode(rootNode, range64Type));
+
+        EXPECT_THAT(vmAreaWalker->extractVmAreas(mm), ElementsAre(0xffff888101000000, 0xffff888101000100));
+    }
+}
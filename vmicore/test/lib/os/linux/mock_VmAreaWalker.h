@@ -0,0 +1,11 @@
+#include <gmock/gmock.h>
+#include <os/linux/VmAreaWalker.h>
+
+namespace VmiCore::Linux
+{
+    class MockVmAreaWalker : public IVmAreaWalker
+    {
+      public:
+        MOCK_METHOD(std::vector<uint64_t>, extractVmAreas, (uint64_t), (const override));
+    };
+}
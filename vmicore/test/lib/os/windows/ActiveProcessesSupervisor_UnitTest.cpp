@@ -4,6 +4,8 @@
 #include <gtest/gtest.h>
 
 using testing::Contains;
+using testing::ElementsAre;
+using testing::IsEmpty;
 using testing::Not;
 using testing::StrEq;
 using testing::UnorderedElementsAre;
@@ -17,6 +19,14 @@ namespace VmiCore::Windows
             ProcessesMemoryStateFixture::SetUp();
             ProcessesMemoryStateFixture::setupActiveProcesses();
         }
+
+      protected:
+        void setupParentPid(const processValues& process, pid_t parentPid)
+        {
+            ON_CALL(*mockVmiInterface,
+                    read64VA(process.eprocessBase + _EPROCESS_OFFSETS::InheritedFromUniqueProcessId, systemCR3))
+                .WillByDefault(testing::Return(parentPid));
+        }
     };
 
     MATCHER_P(IsEqualProcess, expectedProcess, "")
@@ -123,6 +133,45 @@ namespace VmiCore::Windows
         EXPECT_THAT(*activeProcesses, UnorderedElementsAre(IsEqualProcess(process4), IsEqualProcess(process248)));
     }
 
+    TEST_F(ActiveProcessesSupervisorFixture, getActiveProcessesSnapshot_noChanges_sameSnapshot)
+    {
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+
+        auto firstSnapshot = activeProcessesSupervisor->getActiveProcessesSnapshot();
+        auto secondSnapshot = activeProcessesSupervisor->getActiveProcessesSnapshot();
+
+        EXPECT_EQ(firstSnapshot, secondSnapshot);
+        EXPECT_THAT(secondSnapshot->processes,
+                    UnorderedElementsAre(IsEqualProcess(process4), IsEqualProcess(process248)));
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, getActiveProcessesSnapshot_processAdded_newGeneration)
+    {
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        setupProcessWithLink(process332, process0.eprocessBase);
+        auto previousSnapshot = activeProcessesSupervisor->getActiveProcessesSnapshot();
+
+        EXPECT_NO_THROW(activeProcessesSupervisor->addNewProcess(process332.eprocessBase));
+
+        auto currentSnapshot = activeProcessesSupervisor->getActiveProcessesSnapshot();
+        EXPECT_GT(currentSnapshot->generation, previousSnapshot->generation);
+        EXPECT_THAT(currentSnapshot->processes, Contains(IsEqualProcess(process332)));
+        EXPECT_THAT(previousSnapshot->processes, Not(Contains(IsEqualProcess(process332))));
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, getActiveProcessesSnapshot_processRemoved_previousSnapshotUnchanged)
+    {
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        auto previousSnapshot = activeProcessesSupervisor->getActiveProcessesSnapshot();
+
+        EXPECT_NO_THROW(activeProcessesSupervisor->removeActiveProcess(process248.eprocessBase));
+
+        auto currentSnapshot = activeProcessesSupervisor->getActiveProcessesSnapshot();
+        EXPECT_GT(currentSnapshot->generation, previousSnapshot->generation);
+        EXPECT_THAT(currentSnapshot->processes, Not(Contains(IsEqualProcess(process248))));
+        EXPECT_THAT(previousSnapshot->processes, Contains(IsEqualProcess(process248)));
+    }
+
     TEST_F(ActiveProcessesSupervisorFixture, getProcessInformationByPid_validPid_correctProcessInformation)
     {
         EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
@@ -141,4 +190,92 @@ namespace VmiCore::Windows
         EXPECT_THROW(auto processInformation = activeProcessesSupervisor->getProcessInformationByPid(unusedPid),
                      std::invalid_argument);
     }
+
+    TEST_F(ActiveProcessesSupervisorFixture, getProcessInformationByDtb_validDtb_correctProcessInformation)
+    {
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+
+        auto processInformation = activeProcessesSupervisor->getProcessInformationByDtb(process248.cr3);
+
+        EXPECT_THAT(processInformation, IsEqualProcess(process248));
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, getProcessInformationByDtb_dtbWithPcid_correctProcessInformation)
+    {
+        constexpr uint64_t pcid = 0x2;
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+
+        auto processInformation = activeProcessesSupervisor->getProcessInformationByDtb(process248.cr3 + pcid);
+
+        EXPECT_THAT(processInformation, IsEqualProcess(process248));
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, getProcessInformationByDtb_removedProcess_nullptr)
+    {
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        EXPECT_NO_THROW(activeProcessesSupervisor->removeActiveProcess(process248.eprocessBase));
+
+        EXPECT_EQ(activeProcessesSupervisor->getProcessInformationByDtb(process248.cr3), nullptr);
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, getProcessInformationByDtb_addedProcess_correctProcessInformation)
+    {
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        setupProcessWithLink(process332, process0.eprocessBase);
+
+        EXPECT_NO_THROW(activeProcessesSupervisor->addNewProcess(process332.eprocessBase));
+
+        EXPECT_THAT(activeProcessesSupervisor->getProcessInformationByDtb(process332.cr3), IsEqualProcess(process332));
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, getProcessDescendants_grandchildOfRemovedProcess_grandchildReported)
+    {
+        setupParentPid(process248, process4.processId);
+        setupParentPid(process332, process248.processId);
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        setupProcessWithLink(process332, process0.eprocessBase);
+        EXPECT_NO_THROW(activeProcessesSupervisor->addNewProcess(process332.eprocessBase));
+
+        EXPECT_NO_THROW(activeProcessesSupervisor->removeActiveProcess(process248.eprocessBase));
+
+        auto descendants = activeProcessesSupervisor->getProcessDescendants(process4.processId);
+        EXPECT_THAT(*descendants, ElementsAre(IsEqualProcess(process332)));
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, getProcessAncestors_grandchild_parentFirst)
+    {
+        setupParentPid(process248, process4.processId);
+        setupParentPid(process332, process248.processId);
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        setupProcessWithLink(process332, process0.eprocessBase);
+
+        EXPECT_NO_THROW(activeProcessesSupervisor->addNewProcess(process332.eprocessBase));
+
+        auto ancestors = activeProcessesSupervisor->getProcessAncestors(process332.processId);
+        EXPECT_THAT(*ancestors, ElementsAre(IsEqualProcess(process248), IsEqualProcess(process4)));
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, getProcessDescendants_reusedPid_childrenOfPreviousProcessDetached)
+    {
+        setupParentPid(process248, process4.processId);
+        setupParentPid(process332, process248.processId);
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        setupProcessWithLink(process332, process0.eprocessBase);
+        EXPECT_NO_THROW(activeProcessesSupervisor->addNewProcess(process332.eprocessBase));
+        EXPECT_NO_THROW(activeProcessesSupervisor->removeActiveProcess(process248.eprocessBase));
+
+        EXPECT_NO_THROW(activeProcessesSupervisor->addNewProcess(process248.eprocessBase));
+
+        EXPECT_THAT(*activeProcessesSupervisor->getProcessDescendants(process248.processId), IsEmpty());
+        EXPECT_THAT(*activeProcessesSupervisor->getProcessAncestors(process332.processId), IsEmpty());
+        EXPECT_THAT(*activeProcessesSupervisor->getProcessDescendants(process4.processId),
+                    ElementsAre(IsEqualProcess(process248)));
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, getProcessDescendants_unknownPid_empty)
+    {
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+
+        EXPECT_THAT(*activeProcessesSupervisor->getProcessDescendants(unusedPid), IsEmpty());
+    }
 }
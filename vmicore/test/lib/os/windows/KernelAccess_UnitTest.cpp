@@ -17,6 +17,23 @@ namespace VmiCore
             ProcessesMemoryStateFixture::SetUp();
             kernelAccess->initWindowsOffsets();
         }
+
+      protected:
+        /// Populates the section object pointer and the _UNICODE_STRING header of the name of a _FILE_OBJECT.
+        void setupFileObject(uint64_t fileObjectBase,
+                             uint64_t sectionObjectPointer,
+                             const std::string& fileName,
+                             uint64_t fileNameBuffer)
+        {
+            std::vector<uint8_t> fileObject(_FILE_OBJECT_OFFSETS::FileName + 0x10 -
+                                            _FILE_OBJECT_OFFSETS::SectionObjectPointer);
+            writeToBuffer<uint64_t>(fileObject, 0x0, sectionObjectPointer);
+            auto fileNameOffset = _FILE_OBJECT_OFFSETS::FileName - _FILE_OBJECT_OFFSETS::SectionObjectPointer;
+            writeToBuffer<uint16_t>(fileObject, fileNameOffset, static_cast<uint16_t>(fileName.size() * 2));
+            writeToBuffer<uint64_t>(fileObject, fileNameOffset + 0x8, fileNameBuffer);
+            setupBufferedRead(
+                mockVmiInterface, fileObjectBase + _FILE_OBJECT_OFFSETS::SectionObjectPointer, systemCR3, fileObject);
+        }
     };
 
     TEST_F(KernelAccessFixture, extractFileName_ValidKernelspaceAddress_NoThrow)
@@ -34,4 +51,115 @@ namespace VmiCore
         EXPECT_THROW(auto filename = kernelAccess->extractFileName(~PagingDefinitions::kernelspaceLowerBoundary),
                      std::invalid_argument);
     }
+
+    TEST_F(KernelAccessFixture, extractMmVad_validVad_singleReadAndCorrectlyDecoded)
+    {
+        process4VadTreeMemoryState();
+
+        EXPECT_CALL(*mockVmiInterface, readXVA(vadRootNodeLeftChildBase, systemCR3, testing::_, testing::_)).Times(1);
+        EXPECT_CALL(*mockVmiInterface, read8VA(testing::_, testing::_)).Times(0);
+        EXPECT_CALL(*mockVmiInterface, read32VA(testing::_, testing::_)).Times(0);
+
+        auto mmVad = kernelAccess->extractMmVad(vadRootNodeLeftChildBase);
+
+        EXPECT_EQ(mmVad.leftChild, 0);
+        EXPECT_EQ(mmVad.rightChild, vadRootNodeBase);
+        EXPECT_EQ(mmVad.startingVpn, vadRootNodeLeftChildStartingVpn);
+        EXPECT_EQ(mmVad.endingVpn, vadRootNodeLeftChildEndingVpn);
+        EXPECT_EQ(mmVad.protection, static_cast<uint8_t>(Windows::ProtectionValues::PAGE_READWRITE));
+        EXPECT_TRUE(mmVad.isPrivateMemory);
+    }
+
+    TEST_F(KernelAccessFixture, extractMmVad_mmVadShortFollowedByUnmappedPage_fallbackToMmVadShortSize)
+    {
+        process4VadTreeMemoryState();
+        ON_CALL(*mockVmiInterface, readXVA(vadRootNodeBase, systemCR3, testing::_, mmVadSize))
+            .WillByDefault(testing::Return(false));
+
+        Windows::MmVad mmVad{};
+        ASSERT_NO_THROW(mmVad = kernelAccess->extractMmVad(vadRootNodeBase));
+
+        EXPECT_EQ(mmVad.leftChild, vadRootNodeLeftChildBase);
+        EXPECT_EQ(mmVad.rightChild, vadRootNodeRightChildBase);
+        EXPECT_EQ(mmVad.startingVpn, vadRootNodeStartingVpn);
+        EXPECT_EQ(mmVad.endingVpn, vadRootNodeEndingVpn);
+    }
+
+    TEST_F(KernelAccessFixture, extractMmVad_unreadableVad_throws)
+    {
+        ON_CALL(*mockVmiInterface, readXVA(vadRootNodeBase, systemCR3, testing::_, testing::_))
+            .WillByDefault(testing::Return(false));
+
+        EXPECT_THROW(auto mmVad = kernelAccess->extractMmVad(vadRootNodeBase), VmiException);
+    }
+
+    TEST_F(KernelAccessFixture, extractFileName_sameFileObjectTwice_fileNameExtractedOnce)
+    {
+        auto fileObjectBase = PagingDefinitions::kernelspaceLowerBoundary + 0x1000;
+        setupFileObject(fileObjectBase,
+                        PagingDefinitions::kernelspaceLowerBoundary + 0x4000,
+                        fileNameString,
+                        PagingDefinitions::kernelspaceLowerBoundary + 0x2000);
+
+        EXPECT_CALL(*mockVmiInterface,
+                    extractUnicodeStringAtVA(fileObjectBase + _FILE_OBJECT_OFFSETS::FileName, systemCR3))
+            .WillOnce([fileNameString = fileNameString](uint64_t, uint64_t)
+                      { return std::make_unique<std::string>(fileNameString); });
+
+        auto fileName = kernelAccess->extractFileName(fileObjectBase);
+        auto processPath = kernelAccess->extractProcessPath(fileObjectBase);
+
+        EXPECT_EQ(*fileName, fileNameString);
+        EXPECT_EQ(*processPath, fileNameString);
+    }
+
+    TEST_F(KernelAccessFixture, extractFileName_fileObjectReallocated_fileNameExtractedAgain)
+    {
+        auto fileObjectBase = PagingDefinitions::kernelspaceLowerBoundary + 0x1000;
+        std::string newFileNameString = R"(\Windows\System32\ntdll.dll)";
+        setupFileObject(fileObjectBase,
+                        PagingDefinitions::kernelspaceLowerBoundary + 0x4000,
+                        fileNameString,
+                        PagingDefinitions::kernelspaceLowerBoundary + 0x2000);
+        EXPECT_CALL(*mockVmiInterface,
+                    extractUnicodeStringAtVA(fileObjectBase + _FILE_OBJECT_OFFSETS::FileName, systemCR3))
+            .WillOnce([fileNameString = fileNameString](uint64_t, uint64_t)
+                      { return std::make_unique<std::string>(fileNameString); })
+            .WillOnce([newFileNameString](uint64_t, uint64_t)
+                      { return std::make_unique<std::string>(newFileNameString); });
+        auto fileName = kernelAccess->extractFileName(fileObjectBase);
+
+        setupFileObject(fileObjectBase,
+                        PagingDefinitions::kernelspaceLowerBoundary + 0x4000,
+                        newFileNameString,
+                        PagingDefinitions::kernelspaceLowerBoundary + 0x3000);
+        auto newFileName = kernelAccess->extractFileName(fileObjectBase);
+
+        EXPECT_EQ(*fileName, fileNameString);
+        EXPECT_EQ(*newFileName, newFileNameString);
+    }
+
+    TEST_F(KernelAccessFixture, extractFileName_fileObjectReallocatedWithSameNameBuffer_fileNameExtractedAgain)
+    {
+        auto fileObjectBase = PagingDefinitions::kernelspaceLowerBoundary + 0x1000;
+        auto nameBuffer = PagingDefinitions::kernelspaceLowerBoundary + 0x2000;
+        // Same length as the original name, so only the section object pointers tell the objects apart
+        std::string newFileNameString(fileNameString.size(), 'x');
+        setupFileObject(
+            fileObjectBase, PagingDefinitions::kernelspaceLowerBoundary + 0x4000, fileNameString, nameBuffer);
+        EXPECT_CALL(*mockVmiInterface,
+                    extractUnicodeStringAtVA(fileObjectBase + _FILE_OBJECT_OFFSETS::FileName, systemCR3))
+            .WillOnce([fileNameString = fileNameString](uint64_t, uint64_t)
+                      { return std::make_unique<std::string>(fileNameString); })
+            .WillOnce([newFileNameString](uint64_t, uint64_t)
+                      { return std::make_unique<std::string>(newFileNameString); });
+        auto fileName = kernelAccess->extractFileName(fileObjectBase);
+
+        setupFileObject(
+            fileObjectBase, PagingDefinitions::kernelspaceLowerBoundary + 0x5000, newFileNameString, nameBuffer);
+        auto newFileName = kernelAccess->extractFileName(fileObjectBase);
+
+        EXPECT_EQ(*fileName, fileNameString);
+        EXPECT_EQ(*newFileName, newFileNameString);
+    }
 }
@@ -17,6 +17,11 @@ namespace VmiCore
                     (uint64_t),
                     (const override));
 
+        MOCK_METHOD(std::shared_ptr<ActiveProcessInformation>,
+                    getProcessInformationByDtb,
+                    (uint64_t),
+                    (const override));
+
         MOCK_METHOD(void, addNewProcess, (uint64_t), (override));
 
         MOCK_METHOD(void, removeActiveProcess, (uint64_t), (override));
@@ -25,5 +30,17 @@ namespace VmiCore
                     getActiveProcesses,
                     (),
                     (const override));
+
+        MOCK_METHOD(std::shared_ptr<const ActiveProcessesSnapshot>, getActiveProcessesSnapshot, (), (const override));
+
+        MOCK_METHOD(std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>,
+                    getProcessDescendants,
+                    (pid_t),
+                    (const override));
+
+        MOCK_METHOD(std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>,
+                    getProcessAncestors,
+                    (pid_t),
+                    (const override));
     };
 }
@@ -1,8 +1,11 @@
 #include "../vmi/ProcessesMemoryState.h"
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <memory>
+#include <vmi/VmiException.h>
 
 using testing::_;
+using testing::ElementsAre;
 using testing::Return;
 using testing::UnorderedElementsAre;
 using testing::Unused;
@@ -181,6 +184,25 @@ namespace VmiCore
         EXPECT_EQ(regionIterator->isProcessBaseImage, false);
     }
 
+    TEST_F(PluginSystemFixture, getRunningProcesses_unreadableImageFilePointer_allRegionsWithoutProcessBaseImage)
+    {
+        ON_CALL(*mockVmiInterface, read64VA(process4.eprocessBase + _EPROCESS_OFFSETS::ImageFilePointer, systemCR3))
+            .WillByDefault(testing::Throw(VmiException("Unable to read ImageFilePointer")));
+        std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>> processes;
+
+        ASSERT_NO_THROW(processes = pluginInterface->getRunningProcesses());
+        auto process4Info =
+            *std::find_if(processes->cbegin(),
+                          processes->cend(),
+                          [process4 = process4](const std::shared_ptr<const ActiveProcessInformation>& a)
+                          { return a->pid == process4.processId; });
+        std::shared_ptr<const std::vector<MemoryRegion>> memoryRegions;
+        ASSERT_NO_THROW(memoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions());
+
+        ASSERT_EQ(memoryRegions->size(), 3);
+        EXPECT_TRUE(std::ranges::none_of(*memoryRegions, &MemoryRegion::isProcessBaseImage));
+    }
+
     TEST_F(PluginSystemFixture, getRunningProcesses_process4WithHighVPNRegion_hasCorrectBaseAddress)
     {
         std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>> processes;
@@ -214,4 +236,188 @@ namespace VmiCore
         std::advance(regionIterator, 2);
         EXPECT_EQ(regionIterator->size, vadRootNodeLeftChildMemoryRegionSize);
     }
+
+    TEST_F(PluginSystemFixture, getMemoryRegions_unchangedVadTree_sameListReturned)
+    {
+        auto process4Info = pluginInterface->getProcessInformationByDtb(process4.directoryTableBase);
+        ASSERT_TRUE(process4Info);
+
+        auto firstMemoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+        auto secondMemoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+
+        EXPECT_EQ(firstMemoryRegions, secondMemoryRegions);
+        EXPECT_THAT(*secondMemoryRegions,
+                    UnorderedElementsAre(IsEqualMemoryRegion(&expectedMemoryRegion1),
+                                         IsEqualMemoryRegion(&expectedMemoryRegion2),
+                                         IsEqualMemoryRegion(&expectedMemoryRegion3)));
+    }
+
+    TEST_F(PluginSystemFixture, getMemoryRegions_unchangedVadTree_fileNameExtractedOnlyOnce)
+    {
+        auto process4Info = pluginInterface->getProcessInformationByDtb(process4.directoryTableBase);
+        ASSERT_TRUE(process4Info);
+
+        EXPECT_CALL(*mockVmiInterface, extractUnicodeStringAtVA(_, _))
+            .WillOnce([fileNameString = fileNameString](uint64_t, uint64_t)
+                      { return std::make_unique<std::string>(fileNameString); });
+
+        auto memoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+        memoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+        auto extractedMemoryRegions = process4Info->memoryRegionExtractor->extractAllMemoryRegions();
+
+        EXPECT_EQ(std::next(extractedMemoryRegions->cbegin())->moduleName, fileNameString);
+    }
+
+    TEST_F(PluginSystemFixture, getMemoryRegions_modifiedVadNode_updatedListReturned)
+    {
+        auto process4Info = pluginInterface->getProcessInformationByDtb(process4.directoryTableBase);
+        ASSERT_TRUE(process4Info);
+        auto firstMemoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+        uint64_t newEndingVpn = vadRootNodeLeftChildEndingVpn + 1;
+        setupMmVad(vadRootNodeLeftChildBase,
+                   0,
+                   vadRootNodeBase,
+                   vadRootNodeLeftChildStartingVpn,
+                   newEndingVpn,
+                   createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_READWRITE), true));
+        setupVadTreeState(vadRootNodeLeftChildBase, 3);
+
+        auto secondMemoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+
+        EXPECT_NE(firstMemoryRegions, secondMemoryRegions);
+        auto regionIterator = secondMemoryRegions->cbegin();
+        std::advance(regionIterator, 2);
+        EXPECT_EQ(regionIterator->size, vadRootNodeLeftChildMemoryRegionSize + PagingDefinitions::pageSizeInBytes);
+    }
+
+    TEST_F(PluginSystemFixture, getMemoryRegions_vadTreeStateUnchanged_vadTreeNotWalkedAgain)
+    {
+        auto process4Info = pluginInterface->getProcessInformationByDtb(process4.directoryTableBase);
+        ASSERT_TRUE(process4Info);
+        auto firstMemoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+        setupMmVad(vadRootNodeLeftChildBase,
+                   0,
+                   vadRootNodeBase,
+                   vadRootNodeLeftChildStartingVpn,
+                   vadRootNodeLeftChildEndingVpn + 1,
+                   createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_READWRITE), true));
+
+        auto secondMemoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+
+        EXPECT_EQ(firstMemoryRegions, secondMemoryRegions);
+    }
+
+    TEST_F(PluginSystemFixture, getMemoryRegions_modifiedVadNodeSeenByExtractAll_updatedListReturned)
+    {
+        auto process4Info = pluginInterface->getProcessInformationByDtb(process4.directoryTableBase);
+        ASSERT_TRUE(process4Info);
+        auto firstMemoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+        uint64_t newEndingVpn = vadRootNodeLeftChildEndingVpn + 1;
+        setupMmVad(vadRootNodeLeftChildBase,
+                   0,
+                   vadRootNodeBase,
+                   vadRootNodeLeftChildStartingVpn,
+                   newEndingVpn,
+                   createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_READWRITE), true));
+        setupVadTreeState(vadRootNodeLeftChildBase, 3);
+
+        auto extractedMemoryRegions = process4Info->memoryRegionExtractor->extractAllMemoryRegions();
+        auto secondMemoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+
+        EXPECT_NE(firstMemoryRegions, secondMemoryRegions);
+        auto regionIterator = secondMemoryRegions->cbegin();
+        std::advance(regionIterator, 2);
+        EXPECT_EQ(regionIterator->size, vadRootNodeLeftChildMemoryRegionSize + PagingDefinitions::pageSizeInBytes);
+    }
+
+    TEST_F(PluginSystemFixture, visitMemoryRegions_onlyFileBacked_onlyImageRegionVisited)
+    {
+        auto process4Info = pluginInterface->getProcessInformationByDtb(process4.directoryTableBase);
+        ASSERT_TRUE(process4Info);
+        std::vector<addr_t> visitedRegions;
+
+        process4Info->memoryRegionExtractor->visitMemoryRegions(MemoryRegionFilter{.onlyFileBacked = true},
+                                                                [&visitedRegions](const MemoryRegion& memoryRegion)
+                                                                {
+                                                                    visitedRegions.push_back(memoryRegion.base);
+                                                                    return true;
+                                                                });
+
+        EXPECT_THAT(visitedRegions, ElementsAre(expectedMemoryRegion2.base));
+    }
+
+    TEST_F(PluginSystemFixture, visitMemoryRegions_moduleNameWithDifferentCase_regionVisited)
+    {
+        auto process4Info = pluginInterface->getProcessInformationByDtb(process4.directoryTableBase);
+        ASSERT_TRUE(process4Info);
+        std::vector<std::string> visitedModules;
+
+        process4Info->memoryRegionExtractor->visitMemoryRegions(MemoryRegionFilter{.moduleName = "iamsystem.EXE"},
+                                                                [&visitedModules](const MemoryRegion& memoryRegion)
+                                                                {
+                                                                    visitedModules.push_back(memoryRegion.moduleName);
+                                                                    return true;
+                                                                });
+
+        EXPECT_THAT(visitedModules, ElementsAre(fileNameString));
+    }
+
+    TEST_F(PluginSystemFixture, visitMemoryRegions_visitorReturnsFalse_walkStopped)
+    {
+        auto process4Info = pluginInterface->getProcessInformationByDtb(process4.directoryTableBase);
+        ASSERT_TRUE(process4Info);
+        auto visitedRegions = 0;
+
+        process4Info->memoryRegionExtractor->visitMemoryRegions(MemoryRegionFilter{},
+                                                                [&visitedRegions](const MemoryRegion&)
+                                                                {
+                                                                    visitedRegions++;
+                                                                    return false;
+                                                                });
+
+        EXPECT_EQ(visitedRegions, 1);
+    }
+
+    TEST_F(PluginSystemFixture, getCompactMemoryRegions_validProcess_sameRegionsAsMemoryRegions)
+    {
+        auto process4Info = pluginInterface->getProcessInformationByDtb(process4.directoryTableBase);
+        ASSERT_TRUE(process4Info);
+
+        auto compactMemoryRegions = process4Info->memoryRegionExtractor->getCompactMemoryRegions();
+        auto memoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+
+        ASSERT_EQ(compactMemoryRegions->get().size(), memoryRegions->size());
+        for (std::size_t i = 0; i < memoryRegions->size(); i++)
+        {
+            const auto& compactMemoryRegion = compactMemoryRegions->get()[i];
+            const auto& memoryRegion = (*memoryRegions)[i];
+            EXPECT_EQ(compactMemoryRegion.base, memoryRegion.base);
+            EXPECT_EQ(compactMemoryRegion.size, memoryRegion.size);
+            EXPECT_EQ(compactMemoryRegions->getModuleName(compactMemoryRegion), memoryRegion.moduleName);
+            EXPECT_EQ(compactMemoryRegion.rawProtection, memoryRegion.protection->getRaw());
+            EXPECT_EQ(compactMemoryRegion.isSharedMemory, memoryRegion.isSharedMemory);
+            EXPECT_EQ(compactMemoryRegion.isBeingDeleted, memoryRegion.isBeingDeleted);
+            EXPECT_EQ(compactMemoryRegion.isProcessBaseImage, memoryRegion.isProcessBaseImage);
+        }
+    }
+
+    TEST_F(PluginSystemFixture, getMemoryRegions_vadModifiedBetweenOtherQueries_updatedListReturned)
+    {
+        auto process4Info = pluginInterface->getProcessInformationByDtb(process4.directoryTableBase);
+        ASSERT_TRUE(process4Info);
+        auto firstMemoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+        setupMmVad(vadRootNodeLeftChildBase,
+                   0,
+                   vadRootNodeBase,
+                   vadRootNodeLeftChildStartingVpn,
+                   vadRootNodeLeftChildEndingVpn + 1,
+                   createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_READWRITE), true));
+        setupVadTreeState(vadRootNodeLeftChildBase, 3);
+
+        auto compactMemoryRegions = process4Info->memoryRegionExtractor->getCompactMemoryRegions();
+        auto secondMemoryRegions = process4Info->memoryRegionExtractor->getMemoryRegions();
+
+        EXPECT_NE(firstMemoryRegions, secondMemoryRegions);
+        EXPECT_EQ(compactMemoryRegions, process4Info->memoryRegionExtractor->getCompactMemoryRegions());
+    }
 }
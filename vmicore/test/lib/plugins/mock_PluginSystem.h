@@ -16,6 +16,23 @@ namespace VmiCore
                     (),
                     (const override));
 
+        MOCK_METHOD(std::shared_ptr<const ActiveProcessesSnapshot>, getRunningProcessesSnapshot, (), (const override));
+
+        MOCK_METHOD(std::shared_ptr<const ActiveProcessInformation>,
+                    getProcessInformationByDtb,
+                    (addr_t),
+                    (const override));
+
+        MOCK_METHOD(std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>,
+                    getProcessDescendants,
+                    (pid_t),
+                    (const override));
+
+        MOCK_METHOD(std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>,
+                    getProcessAncestors,
+                    (pid_t),
+                    (const override));
+
         MOCK_METHOD(void,
                     registerProcessStartEvent,
                     (const std::function<void(std::shared_ptr<const ActiveProcessInformation>)>&),
@@ -39,6 +56,8 @@ namespace VmiCore
 
         MOCK_METHOD(void, writeToFile, (const std::string&, const std::vector<uint8_t>&), (const override));
 
+        MOCK_METHOD(bool, writeToFile, (const std::string&, std::span<const FileChunk>), (const override));
+
         MOCK_METHOD(void, sendErrorEvent, (std::string_view), (const override));
 
         MOCK_METHOD(void, sendInMemDetectionEvent, (std::string_view), (const override));
@@ -61,5 +80,9 @@ namespace VmiCore
         MOCK_METHOD(void, unloadPlugins, (), (override));
 
         MOCK_METHOD(std::shared_ptr<IIntrospectionAPI>, getIntrospectionAPI, (), (const override));
+
+        MOCK_METHOD(std::shared_ptr<ITaskHandle>, submitTask, (std::function<void(std::stop_token)>), (const override));
+
+        MOCK_METHOD(bool, runPendingTask, (), (const override));
     };
 }
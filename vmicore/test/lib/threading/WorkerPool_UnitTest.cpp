@@ -0,0 +1,170 @@
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+#include <threading/WorkerPool.h>
+#include <vector>
+
+using VmiCore::ITaskHandle;
+using VmiCore::WorkerPool;
+
+TEST(WorkerPoolTests, submit_multipleTasks_allTasksExecuted)
+{
+    WorkerPool workerPool(4);
+    std::atomic<int> executedTasks = 0;
+    std::vector<std::shared_ptr<ITaskHandle>> handles;
+
+    for (int i = 0; i < 100; i++)
+    {
+        handles.push_back(workerPool.submit([&executedTasks](const std::stop_token&) { executedTasks++; }));
+    }
+    for (const auto& handle : handles)
+    {
+        handle->wait();
+    }
+
+    EXPECT_EQ(executedTasks, 100);
+}
+
+TEST(WorkerPoolTests, cancel_pendingTask_taskSkipped)
+{
+    WorkerPool workerPool(1);
+    std::latch blockerStarted(1);
+    std::latch releaseBlocker(1);
+    auto blocker = workerPool.submit(
+        [&blockerStarted, &releaseBlocker](const std::stop_token&)
+        {
+            blockerStarted.count_down();
+            releaseBlocker.wait();
+        });
+    blockerStarted.wait();
+    bool executed = false;
+    auto pendingTask = workerPool.submit([&executed](const std::stop_token&) { executed = true; });
+
+    pendingTask->cancel();
+    releaseBlocker.count_down();
+    pendingTask->wait();
+    blocker->wait();
+
+    EXPECT_TRUE(pendingTask->isDone());
+    EXPECT_TRUE(pendingTask->isCancelled());
+    EXPECT_FALSE(executed);
+}
+
+TEST(WorkerPoolTests, cancel_runningTask_stopRequested)
+{
+    WorkerPool workerPool(1);
+    std::latch taskStarted(1);
+    auto task = workerPool.submit(
+        [&taskStarted](const std::stop_token& stopToken)
+        {
+            taskStarted.count_down();
+            while (!stopToken.stop_requested())
+            {
+                std::this_thread::yield();
+            }
+        });
+    taskStarted.wait();
+
+    task->cancel();
+
+    EXPECT_NO_THROW(task->wait());
+}
+
+TEST(WorkerPoolTests, wait_taskThrows_exceptionRethrown)
+{
+    WorkerPool workerPool(2);
+
+    auto task = workerPool.submit([](const std::stop_token&) { throw std::runtime_error("failure"); });
+
+    EXPECT_THROW(task->wait(), std::runtime_error);
+}
+
+TEST(WorkerPoolTests, wait_nestedTaskOnSingleWorker_noDeadlock)
+{
+    WorkerPool workerPool(1);
+    bool nestedTaskExecuted = false;
+
+    auto outerTask = workerPool.submit(
+        [&workerPool, &nestedTaskExecuted](const std::stop_token&)
+        {
+            auto nestedTask =
+                workerPool.submit([&nestedTaskExecuted](const std::stop_token&) { nestedTaskExecuted = true; });
+            nestedTask->wait();
+        });
+    outerTask->wait();
+
+    EXPECT_TRUE(nestedTaskExecuted);
+}
+
+TEST(WorkerPoolTests, cancelPendingTasks_queuedTasks_onlyRunningTaskCompleted)
+{
+    WorkerPool workerPool(1);
+    std::latch blockerStarted(1);
+    std::atomic<int> executedTasks = 0;
+    auto blocker = workerPool.submit(
+        [&blockerStarted, &executedTasks](const std::stop_token&)
+        {
+            blockerStarted.count_down();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            executedTasks++;
+        });
+    blockerStarted.wait();
+    std::vector<std::shared_ptr<ITaskHandle>> pendingTasks;
+    for (int i = 0; i < 10; i++)
+    {
+        pendingTasks.push_back(workerPool.submit([&executedTasks](const std::stop_token&) { executedTasks++; }));
+    }
+
+    workerPool.cancelPendingTasks();
+
+    EXPECT_TRUE(blocker->isDone());
+    EXPECT_EQ(executedTasks, 1);
+    for (const auto& pendingTask : pendingTasks)
+    {
+        EXPECT_TRUE(pendingTask->isDone());
+    }
+}
+
+TEST(WorkerPoolTests, runPendingTask_calledFromOutsideOfPool_noTaskRun)
+{
+    WorkerPool workerPool(1);
+    std::latch blockerStarted(1);
+    std::latch blockerReleased(1);
+    auto blocker = workerPool.submit(
+        [&blockerStarted, &blockerReleased](const std::stop_token&)
+        {
+            blockerStarted.count_down();
+            blockerReleased.wait();
+        });
+    blockerStarted.wait();
+    auto pendingTask = workerPool.submit([](const std::stop_token&) {});
+
+    EXPECT_FALSE(workerPool.runPendingTask());
+    EXPECT_FALSE(pendingTask->isDone());
+
+    blockerReleased.count_down();
+    pendingTask->wait();
+}
+
+TEST(WorkerPoolTests, runPendingTask_calledFromWithinTask_pendingTaskRunByCaller)
+{
+    WorkerPool workerPool(1);
+    bool pendingTaskDone = false;
+    bool morePendingTasks = true;
+
+    auto outerTask = workerPool.submit(
+        [&workerPool, &pendingTaskDone, &morePendingTasks](const std::stop_token&)
+        {
+            auto pendingTask = workerPool.submit([](const std::stop_token&) {});
+            EXPECT_TRUE(workerPool.runPendingTask());
+            pendingTaskDone = pendingTask->isDone();
+            morePendingTasks = workerPool.runPendingTask();
+        });
+    outerTask->wait();
+
+    EXPECT_TRUE(pendingTaskDone);
+    EXPECT_FALSE(morePendingTasks);
+}
@@ -66,6 +66,7 @@ namespace VmiCore
 
     namespace _FILE_OBJECT_OFFSETS
     {
+        constexpr addr_t SectionObjectPointer = 40;
         constexpr addr_t FileName = 88;
     }
 
@@ -91,6 +92,8 @@ namespace VmiCore
         constexpr addr_t ActiveProcessLinks = 752;
         constexpr addr_t UniqueProcessId = 744;
         constexpr addr_t VadRoot = 1552;
+        constexpr addr_t VadHint = 1560;
+        constexpr addr_t VadCount = 1568;
         constexpr addr_t SectionObject = 952;
         constexpr addr_t InheritedFromUniqueProcessId = 992;
         constexpr addr_t ExitStatus = 1548;
@@ -213,6 +216,10 @@ namespace VmiCore
                 .WillByDefault(testing::Return(_EPROCESS_OFFSETS::SectionObject));
             ON_CALL(*mockVmiInterface, getKernelStructOffset("_EPROCESS", "VadRoot"))
                 .WillByDefault(testing::Return(_EPROCESS_OFFSETS::VadRoot));
+            ON_CALL(*mockVmiInterface, getKernelStructOffset("_EPROCESS", "VadHint"))
+                .WillByDefault(testing::Return(_EPROCESS_OFFSETS::VadHint));
+            ON_CALL(*mockVmiInterface, getKernelStructOffset("_EPROCESS", "VadCount"))
+                .WillByDefault(testing::Return(_EPROCESS_OFFSETS::VadCount));
             ON_CALL(*mockVmiInterface, getKernelStructOffset("_EPROCESS", "ImageFilePointer"))
                 .WillByDefault(testing::Return(_EPROCESS_OFFSETS::ImageFilePointer));
             ON_CALL(*mockVmiInterface, getKernelStructOffset("_SECTION", "u1"))
@@ -221,6 +228,8 @@ namespace VmiCore
                 .WillByDefault(testing::Return(_CONTROL_AREA_OFFSETS::MMSECTION_FLAGS));
             ON_CALL(*mockVmiInterface, getKernelStructOffset("_CONTROL_AREA", "FilePointer"))
                 .WillByDefault(testing::Return(_CONTROL_AREA_OFFSETS::FilePointer));
+            ON_CALL(*mockVmiInterface, getKernelStructOffset("_FILE_OBJECT", "SectionObjectPointer"))
+                .WillByDefault(testing::Return(_FILE_OBJECT_OFFSETS::SectionObjectPointer));
             ON_CALL(*mockVmiInterface, getKernelStructOffset("_FILE_OBJECT", "FileName"))
                 .WillByDefault(testing::Return(_FILE_OBJECT_OFFSETS::FileName));
             ON_CALL(*mockVmiInterface, getKernelStructOffset("__MMVAD_SHORT", "VadNode"))
@@ -262,6 +271,9 @@ namespace VmiCore
                 .WillByDefault(testing::Return(4));
             ON_CALL(*mockVmiInterface, getStructSizeFromJson(Windows::KernelStructOffsets::mmsection_flags::structName))
                 .WillByDefault(testing::Return(4));
+            ON_CALL(*mockVmiInterface, getStructSizeFromJson("_MMVAD")).WillByDefault(testing::Return(mmVadSize));
+            ON_CALL(*mockVmiInterface, getStructSizeFromJson("_MMVAD_SHORT"))
+                .WillByDefault(testing::Return(mmVadShortSize));
         }
 
         void setupProcessWithLink(const processValues& process, uint64_t link)
@@ -352,14 +364,15 @@ namespace VmiCore
             ON_CALL(*mockConfigInterface, getPluginDirectory()).WillByDefault(testing::Return(pluginDirectory));
         }
 
+        static constexpr std::size_t mmVadSize = 0x88;
+        static constexpr std::size_t mmVadShortSize = 0x40;
+
         uint64_t vadRootNodeBase = 666 + PagingDefinitions::kernelspaceLowerBoundary;
         uint64_t vadRootNodeRightChildBase = 777 + PagingDefinitions::kernelspaceLowerBoundary;
         uint64_t vadRootNodeLeftChildBase = 999 + PagingDefinitions::kernelspaceLowerBoundary;
 
         uint32_t vadRootNodeStartingVpn = 333;
-        uint32_t vadRootNodeStartingVpnHigh = 0;
         uint32_t vadRootNodeEndingVpn = 334;
-        uint32_t vadRootNodeEndingVpnHigh = 0;
         uint64_t vadRootNodeStartingAddress = vadRootNodeStartingVpn << PagingDefinitions::numberOfPageIndexBits;
         uint64_t vadRootNodeEndingAddress =
             ((vadRootNodeEndingVpn + 1) << PagingDefinitions::numberOfPageIndexBits) - 1;
@@ -411,34 +424,27 @@ namespace VmiCore
             false,
             false};
 
+        /// Every modification of the vad tree has to be accompanied by an update of these members, just like the
+        /// memory manager of the guest does.
+        void setupVadTreeState(uint64_t vadHint, uint64_t vadCount)
+        {
+            ON_CALL(*mockVmiInterface, read64VA(process4.eprocessBase + _EPROCESS_OFFSETS::VadHint, systemCR3))
+                .WillByDefault(testing::Return(vadHint));
+            ON_CALL(*mockVmiInterface, read64VA(process4.eprocessBase + _EPROCESS_OFFSETS::VadCount, systemCR3))
+                .WillByDefault(testing::Return(vadCount));
+        }
+
         void systemVadTreeRootNodeMemoryState()
         {
             ON_CALL(*mockVmiInterface, read64VA(process4.eprocessBase + _EPROCESS_OFFSETS::VadRoot, systemCR3))
                 .WillByDefault(testing::Return(vadRootNodeBase));
-            ON_CALL(*mockVmiInterface,
-                    read64VA(vadRootNodeBase + _MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::VadNode +
-                                 _RTL_BALANCED_NODE_OFFSETS::Left,
-                             systemCR3))
-                .WillByDefault(testing::Return(vadRootNodeLeftChildBase));
-            ON_CALL(*mockVmiInterface,
-                    read64VA(vadRootNodeBase + _MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::VadNode +
-                                 _RTL_BALANCED_NODE_OFFSETS::Right,
-                             systemCR3))
-                .WillByDefault(testing::Return(vadRootNodeRightChildBase));
-            ON_CALL(*mockVmiInterface, read8VA(vadRootNodeBase + __MMVAD_SHORT_OFFSETS::StartingVpnHigh, systemCR3))
-                .WillByDefault(testing::Return(vadRootNodeStartingVpnHigh));
-            ON_CALL(*mockVmiInterface, read8VA(vadRootNodeBase + __MMVAD_SHORT_OFFSETS::EndingVpnHigh, systemCR3))
-                .WillByDefault(testing::Return(vadRootNodeEndingVpnHigh));
-            ON_CALL(*mockVmiInterface, read32VA(vadRootNodeBase + __MMVAD_SHORT_OFFSETS::StartingVpn, systemCR3))
-                .WillByDefault(testing::Return(vadRootNodeStartingVpn));
-            ON_CALL(*mockVmiInterface, read32VA(vadRootNodeBase + __MMVAD_SHORT_OFFSETS::EndingVpn, systemCR3))
-                .WillByDefault(testing::Return(vadRootNodeEndingVpn));
-            ON_CALL(*mockVmiInterface, read64VA(vadRootNodeBase + __MMVAD_SHORT_OFFSETS::Flags, systemCR3))
-                .WillByDefault(testing::Return(
-                    createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_READWRITE), true)));
-            ON_CALL(*mockVmiInterface, read32VA(vadRootNodeBase + __MMVAD_SHORT_OFFSETS::Flags, systemCR3))
-                .WillByDefault(testing::Return(
-                    createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_READWRITE), true)));
+            setupVadTreeState(vadRootNodeBase, 3);
+            setupMmVad(vadRootNodeBase,
+                       vadRootNodeLeftChildBase,
+                       vadRootNodeRightChildBase,
+                       vadRootNodeStartingVpn,
+                       vadRootNodeEndingVpn,
+                       createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_READWRITE), true));
         }
 
         void systemVadTreeRightChildOfRootNodeMemoryState()
@@ -447,43 +453,17 @@ namespace VmiCore
             uint64_t controlAreaAddress = 0x99900 + PagingDefinitions::kernelspaceLowerBoundary;
             uint64_t filePointerObjectAddress = 0x2340 + PagingDefinitions::kernelspaceLowerBoundary;
 
-            ON_CALL(*mockVmiInterface,
-                    read64VA(vadRootNodeRightChildBase + _MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::VadNode +
-                                 _RTL_BALANCED_NODE_OFFSETS::Left,
-                             systemCR3))
-                .WillByDefault(testing::Return(0));
-            ON_CALL(*mockVmiInterface,
-                    read64VA(vadRootNodeRightChildBase + _MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::VadNode +
-                                 _RTL_BALANCED_NODE_OFFSETS::Right,
-                             systemCR3))
-                .WillByDefault(testing::Return(0));
-            ON_CALL(*mockVmiInterface,
-                    read8VA(vadRootNodeRightChildBase + __MMVAD_SHORT_OFFSETS::StartingVpnHigh, systemCR3))
-                .WillByDefault(testing::Return(0));
-            ON_CALL(*mockVmiInterface,
-                    read8VA(vadRootNodeRightChildBase + __MMVAD_SHORT_OFFSETS::EndingVpnHigh, systemCR3))
-                .WillByDefault(testing::Return(0));
-            ON_CALL(*mockVmiInterface,
-                    read32VA(vadRootNodeRightChildBase + __MMVAD_SHORT_OFFSETS::StartingVpn, systemCR3))
-                .WillByDefault(testing::Return(vadRootNodeRightChildStartingVpn));
-            ON_CALL(*mockVmiInterface,
-                    read32VA(vadRootNodeRightChildBase + __MMVAD_SHORT_OFFSETS::EndingVpn, systemCR3))
-                .WillByDefault(testing::Return(vadRootNodeRightChildEndingVpn));
-            ON_CALL(*mockVmiInterface, read32VA(vadRootNodeRightChildBase + __MMVAD_SHORT_OFFSETS::Flags, systemCR3))
-                .WillByDefault(testing::Return(
-                    createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_EXECUTE_WRITECOPY), false)));
-            ON_CALL(*mockVmiInterface, read64VA(vadRootNodeRightChildBase + _MMVAD_OFFSETS::Subsection, systemCR3))
-                .WillByDefault(testing::Return(subsectionAddress));
+            setupMmVad(
+                vadRootNodeRightChildBase,
+                0,
+                0,
+                vadRootNodeRightChildStartingVpn,
+                vadRootNodeRightChildEndingVpn,
+                createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_EXECUTE_WRITECOPY), false),
+                subsectionAddress);
             ON_CALL(*mockVmiInterface, read64VA(subsectionAddress + _SUBSECTION_OFFSETS::ControlArea, systemCR3))
                 .WillByDefault(testing::Return(controlAreaAddress));
-            ON_CALL(*mockVmiInterface, read64VA(controlAreaAddress + _CONTROL_AREA_OFFSETS::MMSECTION_FLAGS, systemCR3))
-                .WillByDefault(testing::Return(process4.sectionFlags));
-            ON_CALL(*mockVmiInterface, read32VA(controlAreaAddress + _CONTROL_AREA_OFFSETS::MMSECTION_FLAGS, systemCR3))
-                .WillByDefault(testing::Return(process4.sectionFlags));
-            ON_CALL(*mockVmiInterface,
-                    read64VA(controlAreaAddress + _CONTROL_AREA_OFFSETS::FilePointer + _EX_FAST_REF_OFFSETS::Object,
-                             systemCR3))
-                .WillByDefault(testing::Return(filePointerObjectAddress));
+            setupControlArea(controlAreaAddress, process4.sectionFlags, filePointerObjectAddress);
             ON_CALL(*mockVmiInterface,
                     extractUnicodeStringAtVA((filePointerObjectAddress) + _FILE_OBJECT_OFFSETS::FileName, systemCR3))
                 .WillByDefault([fileNameString = fileNameString](uint64_t, uint64_t)
@@ -494,35 +474,74 @@ namespace VmiCore
 
         void systemVadTreeLeftChildOfRootNodeMemoryState()
         {
-            ON_CALL(*mockVmiInterface,
-                    read64VA(vadRootNodeLeftChildBase + _MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::VadNode +
-                                 _RTL_BALANCED_NODE_OFFSETS::Left,
-                             systemCR3))
-                .WillByDefault(testing::Return(0));
-            ON_CALL(*mockVmiInterface,
-                    read64VA(vadRootNodeLeftChildBase + _MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::VadNode +
-                                 _RTL_BALANCED_NODE_OFFSETS::Right,
-                             systemCR3))
-                .WillByDefault(testing::Return(vadRootNodeBase));
-            ON_CALL(*mockVmiInterface,
-                    read8VA(vadRootNodeLeftChildBase + __MMVAD_SHORT_OFFSETS::StartingVpnHigh, systemCR3))
-                .WillByDefault([vadLeftChildStartingVpn = vadRootNodeLeftChildStartingVpn](uint64_t, uint64_t)
-                               { return vadLeftChildStartingVpn >> 32; });
-            ON_CALL(*mockVmiInterface,
-                    read8VA(vadRootNodeLeftChildBase + __MMVAD_SHORT_OFFSETS::EndingVpnHigh, systemCR3))
-                .WillByDefault([vadLeftChildEndingVpn = vadRootNodeLeftChildEndingVpn](uint64_t, uint64_t)
-                               { return vadLeftChildEndingVpn >> 32; });
-            ON_CALL(*mockVmiInterface,
-                    read32VA(vadRootNodeLeftChildBase + __MMVAD_SHORT_OFFSETS::StartingVpn, systemCR3))
-                .WillByDefault(testing::Return(vadRootNodeLeftChildStartingVpn));
-            ON_CALL(*mockVmiInterface, read32VA(vadRootNodeLeftChildBase + __MMVAD_SHORT_OFFSETS::EndingVpn, systemCR3))
-                .WillByDefault(testing::Return(vadRootNodeLeftChildEndingVpn));
-            ON_CALL(*mockVmiInterface, read64VA(vadRootNodeLeftChildBase + __MMVAD_SHORT_OFFSETS::Flags, systemCR3))
-                .WillByDefault(testing::Return(
-                    createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_READWRITE), true)));
-            ON_CALL(*mockVmiInterface, read32VA(vadRootNodeLeftChildBase + __MMVAD_SHORT_OFFSETS::Flags, systemCR3))
-                .WillByDefault(testing::Return(
-                    createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_READWRITE), true)));
+            setupMmVad(vadRootNodeLeftChildBase,
+                       0,
+                       vadRootNodeBase,
+                       vadRootNodeLeftChildStartingVpn,
+                       vadRootNodeLeftChildEndingVpn,
+                       createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::PAGE_READWRITE), true));
+        }
+
+        template <typename T> static void writeToBuffer(std::vector<uint8_t>& buffer, std::size_t offset, T value)
+        {
+            std::memcpy(buffer.data() + offset, &value, sizeof(T));
+        }
+
+        static void setupBufferedRead(const std::shared_ptr<testing::NiceMock<MockLibvmiInterface>>& vmiInterface,
+                                      uint64_t virtualAddress,
+                                      uint64_t cr3,
+                                      const std::vector<uint8_t>& memory)
+        {
+            ON_CALL(*vmiInterface, readXVA(virtualAddress, cr3, testing::_, testing::_))
+                .WillByDefault(
+                    [memory](uint64_t, uint64_t, std::vector<uint8_t>& content, std::size_t size)
+                    {
+                        if (size > memory.size() || size > content.size())
+                        {
+                            return false;
+                        }
+                        std::copy_n(memory.cbegin(), size, content.begin());
+                        return true;
+                    });
+        }
+
+        void setupMmVad(uint64_t vadEntryBase,
+                        uint64_t leftChild,
+                        uint64_t rightChild,
+                        uint64_t startingVpn,
+                        uint64_t endingVpn,
+                        uint32_t flags,
+                        uint64_t subsection = 0)
+        {
+            std::vector<uint8_t> mmVad(mmVadSize);
+            auto vadShortOffset = _MMVAD_OFFSETS::BaseAddress;
+            writeToBuffer(mmVad,
+                          vadShortOffset + __MMVAD_SHORT_OFFSETS::VadNode + _RTL_BALANCED_NODE_OFFSETS::Left,
+                          leftChild);
+            writeToBuffer(mmVad,
+                          vadShortOffset + __MMVAD_SHORT_OFFSETS::VadNode + _RTL_BALANCED_NODE_OFFSETS::Right,
+                          rightChild);
+            writeToBuffer(
+                mmVad, vadShortOffset + __MMVAD_SHORT_OFFSETS::StartingVpn, static_cast<uint32_t>(startingVpn));
+            writeToBuffer(mmVad,
+                          vadShortOffset + __MMVAD_SHORT_OFFSETS::StartingVpnHigh,
+                          static_cast<uint8_t>(startingVpn >> 32));
+            writeToBuffer(mmVad, vadShortOffset + __MMVAD_SHORT_OFFSETS::EndingVpn, static_cast<uint32_t>(endingVpn));
+            writeToBuffer(
+                mmVad, vadShortOffset + __MMVAD_SHORT_OFFSETS::EndingVpnHigh, static_cast<uint8_t>(endingVpn >> 32));
+            writeToBuffer(mmVad, vadShortOffset + __MMVAD_SHORT_OFFSETS::Flags, flags);
+            writeToBuffer(mmVad, _MMVAD_OFFSETS::Subsection, subsection);
+            setupBufferedRead(mockVmiInterface, vadEntryBase, systemCR3, mmVad);
+        }
+
+        void setupControlArea(uint64_t controlAreaBase, uint32_t sectionFlags, uint64_t filePointerObject)
+        {
+            std::vector<uint8_t> controlArea(_CONTROL_AREA_OFFSETS::FilePointer + _EX_FAST_REF_OFFSETS::Object +
+                                             sizeof(uint64_t));
+            writeToBuffer(controlArea, _CONTROL_AREA_OFFSETS::MMSECTION_FLAGS, sectionFlags);
+            writeToBuffer(
+                controlArea, _CONTROL_AREA_OFFSETS::FilePointer + _EX_FAST_REF_OFFSETS::Object, filePointerObject);
+            setupBufferedRead(mockVmiInterface, controlAreaBase, systemCR3, controlArea);
         }
 
         static uint32_t createMmvadFlags(uint32_t protection, bool privateMemory)